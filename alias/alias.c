@@ -54,12 +54,15 @@
 #include "question/lib.h"
 #include "send/lib.h"
 #include "globals.h"
+#include "index.h"
 #include "maillist.h"
 #include "muttlib.h"
 #include "reverse.h"
 
 struct AliasList Aliases = TAILQ_HEAD_INITIALIZER(Aliases); ///< List of all the user's email aliases
 
+static struct HashTable *UserAddresses = NULL; ///< The user's own addresses, see user_addresses()
+
 /**
  * write_safe_address - Defang malicious email addresses
  * @param fp File to write to
@@ -248,21 +251,58 @@ static int check_alias_name(const char *s, struct Buffer *dest)
 }
 
 /**
- * string_is_address - Does an email address match a user and domain?
- * @param str    Address string to test
+ * user_address_add - Add one of the user's addresses to the Hash Table
+ * @param table  Hash Table
  * @param user   User name
- * @param domain Domain name
- * @retval true They match
+ * @param domain Domain name, may be NULL
+ * @param desc   Description, for debugging
  */
-static bool string_is_address(const char *str, const char *user, const char *domain)
+static void user_address_add(struct HashTable *table, const char *user,
+                             const char *domain, const char *desc)
 {
   char buf[1024] = { 0 };
 
   snprintf(buf, sizeof(buf), "%s@%s", NONULL(user), NONULL(domain));
-  if (mutt_istr_equal(str, buf))
-    return true;
+  mutt_hash_insert(table, buf, (void *) desc);
+}
 
-  return false;
+/**
+ * user_addresses - Get the user's own addresses
+ * @retval ptr Hash Table of addresses (address -> description)
+ *
+ * The addresses are built from the user name, host name, $hostname and $from.
+ * They're rebuilt whenever one of the config variables changes.
+ */
+static struct HashTable *user_addresses(void)
+{
+  static struct CachedConfig cc_hostname = CACHED_CONFIG("hostname");
+  static struct CachedConfig cc_hidden_host = CACHED_CONFIG("hidden_host");
+  static struct CachedConfig cc_from = CACHED_CONFIG("from");
+
+  // A config change invalidates the handles
+  if (UserAddresses && cc_hostname.valid && cc_hidden_host.valid && cc_from.valid)
+    return UserAddresses;
+
+  mutt_hash_free(&UserAddresses);
+  UserAddresses = mutt_hash_new(8, MUTT_HASH_STRCASECMP | MUTT_HASH_STRDUP_KEYS);
+
+  // Resolve the handles, so that we notice the next change
+  cc_string(&cc_hostname);
+  cc_bool(&cc_hidden_host);
+  const struct Address *c_from = (const struct Address *) cc_native(&cc_from);
+
+  const char *user = NeoMutt->username;
+  if (user)
+    mutt_hash_insert(UserAddresses, user, (void *) "user name");
+
+  user_address_add(UserAddresses, user, ShortHostname, "short host name");
+  user_address_add(UserAddresses, user, mutt_fqdn(false, NeoMutt->sub), "fqdn");
+  user_address_add(UserAddresses, user, mutt_fqdn(true, NeoMutt->sub), "hidden fqdn");
+
+  if (c_from && c_from->mailbox)
+    mutt_hash_insert(UserAddresses, buf_string(c_from->mailbox), (void *) "$from");
+
+  return UserAddresses;
 }
 
 /**
@@ -275,14 +315,11 @@ static bool string_is_address(const char *str, const char *user, const char *dom
  */
 struct AddressList *alias_lookup(const char *name)
 {
-  struct Alias *a = NULL;
+  struct Alias *a = alias_index_find(name);
+  if (!a)
+    return NULL;
 
-  TAILQ_FOREACH(a, &Aliases, entries)
-  {
-    if (mutt_istr_equal(name, a->name))
-      return &a->addr;
-  }
-  return NULL;
+  return &a->addr;
 }
 
 /**
@@ -509,6 +546,11 @@ retry_name:
 
   alias_reverse_add(alias);
   TAILQ_INSERT_TAIL(&Aliases, alias, entries);
+  alias_index_add(alias);
+
+  mutt_debug(LL_NOTIFY, "NT_ALIAS_ADD: %s\n", alias->name);
+  struct EventAlias ev_a = { alias };
+  notify_send(NeoMutt->notify, NT_ALIAS, NT_ALIAS_ADD, &ev_a);
 
   const char *const c_alias_file = cs_subset_path(sub, "alias_file");
   buf_strcpy(buf, c_alias_file);
@@ -605,38 +647,10 @@ bool mutt_addr_is_user(const struct Address *addr)
     return false;
   }
 
-  if (mutt_istr_equal(buf_string(addr->mailbox), NeoMutt->username))
-  {
-    mutt_debug(LL_DEBUG5, "#1 yes, %s = %s\n", buf_string(addr->mailbox),
-               NeoMutt->username);
-    return true;
-  }
-  if (string_is_address(buf_string(addr->mailbox), NeoMutt->username, ShortHostname))
-  {
-    mutt_debug(LL_DEBUG5, "#2 yes, %s = %s @ %s\n", buf_string(addr->mailbox),
-               NeoMutt->username, ShortHostname);
-    return true;
-  }
-  const char *fqdn = mutt_fqdn(false, NeoMutt->sub);
-  if (string_is_address(buf_string(addr->mailbox), NeoMutt->username, fqdn))
-  {
-    mutt_debug(LL_DEBUG5, "#3 yes, %s = %s @ %s\n", buf_string(addr->mailbox),
-               NeoMutt->username, NONULL(fqdn));
-    return true;
-  }
-  fqdn = mutt_fqdn(true, NeoMutt->sub);
-  if (string_is_address(buf_string(addr->mailbox), NeoMutt->username, fqdn))
-  {
-    mutt_debug(LL_DEBUG5, "#4 yes, %s = %s @ %s\n", buf_string(addr->mailbox),
-               NeoMutt->username, NONULL(fqdn));
-    return true;
-  }
-
-  const struct Address *c_from = cs_subset_address(NeoMutt->sub, "from");
-  if (c_from && mutt_istr_equal(buf_string(c_from->mailbox), buf_string(addr->mailbox)))
+  const char *desc = mutt_hash_find(user_addresses(), buf_string(addr->mailbox));
+  if (desc)
   {
-    mutt_debug(LL_DEBUG5, "#5 yes, %s = %s\n", buf_string(addr->mailbox),
-               buf_string(c_from->mailbox));
+    mutt_debug(LL_DEBUG5, "yes, %s is the user's %s\n", buf_string(addr->mailbox), desc);
     return true;
   }
 
@@ -710,6 +724,7 @@ void aliaslist_clear(struct AliasList *al)
 void alias_init(void)
 {
   alias_reverse_init();
+  alias_index_init();
 }
 
 /**
@@ -722,6 +737,8 @@ void alias_cleanup(void)
   {
     alias_reverse_delete(np);
   }
+  alias_index_shutdown();
+  mutt_hash_free(&UserAddresses);
   aliaslist_clear(&Aliases);
   alias_reverse_shutdown();
 }
@@ -38,6 +38,7 @@
 #include "commands/lib.h"
 #include "parse/lib.h"
 #include "alias.h"
+#include "index.h"
 #include "reverse.h"
 
 /**
@@ -180,12 +181,7 @@ enum CommandResult parse_alias(const struct Command *cmd, struct Buffer *line,
   }
 
   /* check to see if an alias with this name already exists */
-  TAILQ_FOREACH(tmp, &Aliases, entries)
-  {
-    if (mutt_istr_equal(tmp->name, name))
-      break;
-  }
-
+  tmp = alias_index_find(name);
   if (tmp)
   {
     FREE(&name);
@@ -201,6 +197,7 @@ enum CommandResult parse_alias(const struct Command *cmd, struct Buffer *line,
     tmp = alias_new();
     tmp->name = name;
     TAILQ_INSERT_TAIL(&Aliases, tmp, entries);
+    alias_index_add(tmp);
     event = NT_ALIAS_ADD;
   }
   tmp->addr = al;
@@ -276,21 +273,20 @@ enum CommandResult parse_unalias(const struct Command *cmd, struct Buffer *line,
       TAILQ_FOREACH(np, &Aliases, entries)
       {
         alias_reverse_delete(np);
+        alias_index_delete(np);
       }
 
       aliaslist_clear(&Aliases);
       goto done;
     }
 
-    TAILQ_FOREACH(np, &Aliases, entries)
+    np = alias_index_find(buf_string(token));
+    if (np)
     {
-      if (!mutt_istr_equal(buf_string(token), np->name))
-        continue;
-
       TAILQ_REMOVE(&Aliases, np, entries);
       alias_reverse_delete(np);
+      alias_index_delete(np);
       alias_free(&np);
-      break;
     }
   } while (MoreArgs(line));
 
@@ -93,7 +93,9 @@
 #include "expando.h"
 #include "functions.h"
 #include "gui.h"
+#include "index.h"
 #include "mutt_logging.h"
+#include "reverse.h"
 
 /// Help Bar for the Alias dialog (address book)
 static const struct Mapping AliasHelp[] = {
@@ -337,7 +339,6 @@ int alias_complete(struct Buffer *buf, struct ConfigSubset *sub)
   struct Alias *np = NULL;
   char bestname[8192] = { 0 };
   struct Alias *a_best = NULL;
-  int count = 0;
 
   struct AliasMenuData mdata = { ARRAY_HEAD_INITIALIZER, NULL, sub };
   mdata.limit = buf_strdup(buf);
@@ -345,27 +346,22 @@ int alias_complete(struct Buffer *buf, struct ConfigSubset *sub)
 
   if (buf_at(buf, 0) != '\0')
   {
-    TAILQ_FOREACH(np, &Aliases, entries)
+    /* The matches are sorted, so the first and last share the longest prefix */
+    size_t count = 0;
+    struct Alias **matches = alias_index_prefix(buf_string(buf), &count);
+    if (matches)
     {
-      if (np->name && mutt_strn_equal(np->name, buf_string(buf), buf_len(buf)))
-      {
-        a_best = np;
-        count++;
+      a_best = matches[0];
+      struct Alias *a_last = matches[count - 1];
 
-        if (bestname[0] == '\0') /* init */
-        {
-          mutt_str_copy(bestname, np->name,
-                        MIN(mutt_str_len(np->name) + 1, sizeof(bestname)));
-        }
-        else
-        {
-          int i;
-          for (i = 0; np->name[i] && (np->name[i] == bestname[i]); i++)
-            ; // do nothing
+      mutt_str_copy(bestname, a_best->name,
+                    MIN(mutt_str_len(a_best->name) + 1, sizeof(bestname)));
 
-          bestname[i] = '\0';
-        }
-      }
+      int i;
+      for (i = 0; a_last->name[i] && (a_last->name[i] == bestname[i]); i++)
+        ; // do nothing
+
+      bestname[i] = '\0';
     }
 
     // Exactly one match, so expand the Alias and return
@@ -457,6 +453,8 @@ done:
       continue;
 
     TAILQ_REMOVE(&Aliases, avp->alias, entries);
+    alias_reverse_delete(avp->alias);
+    alias_index_delete(avp->alias);
     alias_free(&avp->alias);
   }
 
@@ -516,6 +514,8 @@ done:
     if (avp->is_deleted)
     {
       TAILQ_REMOVE(&Aliases, avp->alias, entries);
+      alias_reverse_delete(avp->alias);
+      alias_index_delete(avp->alias);
       alias_free(&avp->alias);
     }
   }
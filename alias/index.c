@@ -0,0 +1,225 @@
+/**
+ * @file
+ * Manage alias name lookups
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page alias_index Alias name lookups
+ *
+ * Manage alias name lookups
+ *
+ * Aliases are looked up by name, ignoring case, when addresses are expanded.
+ * Completion looks them up by a case-sensitive prefix.
+ *
+ * The names are kept in a Hash Table, updated as Aliases are added and
+ * removed.  Each name has a list of its Aliases, in the order they were added,
+ * so that the first one is found, even if several share a name.
+ *
+ * For completion, an array of the Aliases, sorted by name, is built when it's
+ * first needed after a change.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "mutt/lib.h"
+#include "index.h"
+#include "alias.h"
+
+ARRAY_HEAD(AliasPtrArray, struct Alias *);
+
+static struct HashTable *AliasNames = NULL; ///< Hash Table of aliases (name -> AliasPtrArray)
+static struct AliasPtrArray AliasSorted = ARRAY_HEAD_INITIALIZER; ///< Aliases sorted by name
+static bool AliasSortedValid = false; ///< AliasSorted matches the Aliases
+
+/**
+ * alias_names_free - Free our hash table data - Implements ::hash_hdata_free_t - @ingroup hash_hdata_free_api
+ */
+static void alias_names_free(int type, void *obj, intptr_t data)
+{
+  struct AliasPtrArray *apa = obj;
+  ARRAY_FREE(apa);
+  FREE(&apa);
+}
+
+/**
+ * alias_index_init - Set up the Alias name Hash Table
+ */
+void alias_index_init(void)
+{
+  /* the Aliases may be freed before their names are removed */
+  AliasNames = mutt_hash_new(1031, MUTT_HASH_STRCASECMP | MUTT_HASH_STRDUP_KEYS);
+  mutt_hash_set_destructor(AliasNames, alias_names_free, 0);
+}
+
+/**
+ * alias_index_shutdown - Clear up the Alias name Hash Table
+ */
+void alias_index_shutdown(void)
+{
+  mutt_hash_free(&AliasNames);
+  ARRAY_FREE(&AliasSorted);
+  AliasSortedValid = false;
+}
+
+/**
+ * alias_index_add - Add a name lookup for an Alias
+ * @param alias Alias to use
+ *
+ * If other Aliases have the same name, they're found first.
+ */
+void alias_index_add(struct Alias *alias)
+{
+  if (!AliasNames || !alias || !alias->name)
+    return;
+
+  struct AliasPtrArray *apa = mutt_hash_find(AliasNames, alias->name);
+  if (!apa)
+  {
+    apa = MUTT_MEM_CALLOC(1, struct AliasPtrArray);
+    mutt_hash_insert(AliasNames, alias->name, apa);
+  }
+
+  ARRAY_ADD(apa, alias);
+  AliasSortedValid = false;
+}
+
+/**
+ * alias_index_delete - Remove a name lookup for an Alias
+ * @param alias Alias to use
+ *
+ * If other Aliases have the same name, they can still be found.
+ */
+void alias_index_delete(struct Alias *alias)
+{
+  if (!alias || !alias->name)
+    return;
+
+  AliasSortedValid = false;
+
+  struct AliasPtrArray *apa = mutt_hash_find(AliasNames, alias->name);
+  if (!apa)
+    return;
+
+  struct Alias **ap = NULL;
+  ARRAY_FOREACH(ap, apa)
+  {
+    if (*ap == alias)
+    {
+      ARRAY_REMOVE(apa, ap);
+      break;
+    }
+  }
+
+  if (ARRAY_EMPTY(apa))
+    mutt_hash_delete(AliasNames, alias->name, apa);
+}
+
+/**
+ * alias_index_find - Find an Alias by name
+ * @param name Name of the Alias
+ * @retval ptr  Matching Alias
+ * @retval NULL No such Alias
+ *
+ * If several Aliases have the name, the first one added is returned.
+ *
+ * @note The search is case-insensitive
+ */
+struct Alias *alias_index_find(const char *name)
+{
+  if (!name)
+    return NULL;
+
+  struct AliasPtrArray *apa = mutt_hash_find(AliasNames, name);
+  if (!apa)
+    return NULL;
+
+  struct Alias **ap = ARRAY_FIRST(apa);
+  return ap ? *ap : NULL;
+}
+
+/**
+ * alias_sort_ptr_name - Compare two Aliases by name - Implements ::sort_t - @ingroup sort_api
+ */
+static int alias_sort_ptr_name(const void *a, const void *b, void *sdata)
+{
+  const struct Alias *aa = *(struct Alias const *const *) a;
+  const struct Alias *ab = *(struct Alias const *const *) b;
+
+  return mutt_str_cmp(aa->name, ab->name);
+}
+
+/**
+ * alias_index_prefix - Find the Aliases whose names start with a prefix
+ * @param[in]  prefix Prefix to match
+ * @param[out] count  Number of matching Aliases
+ * @retval ptr  First of the matching Aliases, sorted by name
+ * @retval NULL No matches
+ *
+ * @note The search is case-sensitive
+ * @note The results are only valid until the Aliases are changed
+ */
+struct Alias **alias_index_prefix(const char *prefix, size_t *count)
+{
+  *count = 0;
+  if (!prefix)
+    return NULL;
+
+  if (!AliasSortedValid)
+  {
+    ARRAY_SHRINK(&AliasSorted, ARRAY_SIZE(&AliasSorted));
+    struct Alias *np = NULL;
+    TAILQ_FOREACH(np, &Aliases, entries)
+    {
+      if (np->name)
+        ARRAY_ADD(&AliasSorted, np);
+    }
+    ARRAY_SORT(&AliasSorted, alias_sort_ptr_name, NULL);
+    AliasSortedValid = true;
+  }
+
+  // Binary search for the first name >= prefix
+  size_t lo = 0;
+  size_t hi = ARRAY_SIZE(&AliasSorted);
+  while (lo < hi)
+  {
+    size_t mid = lo + ((hi - lo) / 2);
+    if (mutt_str_cmp((*ARRAY_GET(&AliasSorted, mid))->name, prefix) < 0)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  const size_t len = mutt_str_len(prefix);
+  size_t end = lo;
+  while ((end < ARRAY_SIZE(&AliasSorted)) &&
+         mutt_strn_equal((*ARRAY_GET(&AliasSorted, end))->name, prefix, len))
+  {
+    end++;
+  }
+
+  if (end == lo)
+    return NULL;
+
+  *count = end - lo;
+  return ARRAY_GET(&AliasSorted, lo);
+}
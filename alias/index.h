@@ -0,0 +1,37 @@
+/**
+ * @file
+ * Manage alias name lookups
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_ALIAS_INDEX_H
+#define MUTT_ALIAS_INDEX_H
+
+#include <stddef.h>
+
+struct Alias;
+
+void          alias_index_init    (void);
+void          alias_index_add     (struct Alias *alias);
+void          alias_index_delete  (struct Alias *alias);
+struct Alias *alias_index_find    (const char *name);
+struct Alias **alias_index_prefix (const char *prefix, size_t *count);
+void          alias_index_shutdown(void);
+
+#endif /* MUTT_ALIAS_INDEX_H */
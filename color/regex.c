@@ -281,7 +281,8 @@ static enum CommandResult add_pattern(struct RegexColorList *rcl, const char *s,
       const char *const c_simple_search = cs_subset_string(NeoMutt->sub, "simple_search");
       mutt_check_simple(buf, NONULL(c_simple_search));
       struct MailboxView *mv_cur = get_current_mailbox_view();
-      rcol->color_pattern = mutt_pattern_comp(mv_cur, buf_string(buf), MUTT_PC_FULL_MSG, err);
+      rcol->color_pattern = mutt_pattern_comp(mv_cur, buf_string(buf),
+                                              MUTT_PC_FULL_MSG | MUTT_PC_RULE, err);
       buf_pool_release(&buf);
       if (!rcol->color_pattern)
       {
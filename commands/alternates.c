@@ -24,11 +24,19 @@
  * @page commands_alternates Parse Alternate Commands
  *
  * Parse Alternate Commands
+ *
+ * mutt_alternates_match() is called for every address that might be the
+ * user's, so the Alternates are prepared for matching when they're first
+ * needed after a change:
+ * - Regexes that match exactly one address, e.g. `^me@example\.com$`, are
+ *   put in a Hash Table
+ * - The rest are combined into one Regex, so the address is only scanned once
  */
 
 #include "config.h"
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include "mutt/lib.h"
 #include "address/lib.h"
 #include "email/lib.h"
@@ -42,6 +50,110 @@ static struct RegexList Alternates = STAILQ_HEAD_INITIALIZER(Alternates); ///< L
 static struct RegexList UnAlternates = STAILQ_HEAD_INITIALIZER(UnAlternates); ///< List of regexes to exclude false matches in Alternates
 static struct Notify *AlternatesNotify = NULL; ///< Notifications: #NotifyAlternates
 
+static struct HashTable *AlternatesExact = NULL; ///< Alternates that match a single address
+static struct Regex *AlternatesCombined = NULL;  ///< All the other Alternates, combined
+static bool AlternatesUseList = false;           ///< Alternates can't be combined, use the list
+static bool AlternatesReady = false;             ///< Matcher is up to date
+
+/**
+ * alternates_matcher_free - Free the prepared Alternates
+ */
+static void alternates_matcher_free(void)
+{
+  mutt_hash_free(&AlternatesExact);
+  mutt_regex_free(&AlternatesCombined);
+  AlternatesUseList = false;
+  AlternatesReady = false;
+}
+
+/**
+ * alternate_literal - Does a Regex match exactly one address?
+ * @param[in]  str Regex string, e.g. `^me@example\.com$`
+ * @param[out] buf Buffer for the address
+ * @retval true The Regex is anchored and only contains literal characters
+ */
+static bool alternate_literal(const char *str, struct Buffer *buf)
+{
+  static const char *const special = ".[]()*+?{}|^$\\";
+
+  buf_reset(buf);
+  if (!str || (str[0] != '^'))
+    return false;
+
+  for (const char *p = str + 1; *p; p++)
+  {
+    if ((p[0] == '$') && (p[1] == '\0'))
+      return !buf_is_empty(buf);
+
+    if (*p == '\\')
+    {
+      // Only an escaped special character is literal, e.g. \. but not \< or \1
+      p++;
+      if ((*p == '\0') || !strchr(special, *p))
+        return false;
+    }
+    else if (strchr(special, *p) || (*p & 0x80))
+    {
+      // Leave any non-ASCII case-folding to the regex library
+      return false;
+    }
+
+    buf_addch(buf, *p);
+  }
+
+  return false;
+}
+
+/**
+ * alternates_matcher_build - Prepare the Alternates for matching
+ */
+static void alternates_matcher_build(void)
+{
+  alternates_matcher_free();
+
+  struct Buffer *addr = buf_pool_get();
+  struct Buffer *combined = buf_pool_get();
+
+  struct RegexNode *np = NULL;
+  STAILQ_FOREACH(np, &Alternates, entries)
+  {
+    const char *pattern = np->regex->pattern;
+    if (alternate_literal(pattern, addr))
+    {
+      if (!AlternatesExact)
+      {
+        AlternatesExact = mutt_hash_new(32, MUTT_HASH_STRCASECMP | MUTT_HASH_STRDUP_KEYS);
+      }
+      mutt_hash_insert(AlternatesExact, buf_string(addr), np->regex);
+      continue;
+    }
+
+    // Back-references would be renumbered by combining the Regexes
+    for (const char *p = strchr(pattern, '\\'); p; p = strchr(p + 2, '\\'))
+    {
+      if ((p[1] >= '1') && (p[1] <= '9'))
+        AlternatesUseList = true;
+      if (p[1] == '\0')
+        break;
+    }
+
+    if (!buf_is_empty(combined))
+      buf_addch(combined, '|');
+    buf_add_printf(combined, "(%s)", pattern);
+  }
+
+  if (!AlternatesUseList && !buf_is_empty(combined))
+  {
+    AlternatesCombined = mutt_regex_compile(buf_string(combined), REG_ICASE | REG_NOSUB);
+    if (!AlternatesCombined)
+      AlternatesUseList = true;
+  }
+
+  buf_pool_release(&addr);
+  buf_pool_release(&combined);
+  AlternatesReady = true;
+}
+
 /**
  * alternates_cleanup - Free the alternates lists
  */
@@ -49,6 +161,7 @@ void alternates_cleanup(void)
 {
   notify_free(&AlternatesNotify);
 
+  alternates_matcher_free();
   mutt_regexlist_free(&Alternates);
   mutt_regexlist_free(&UnAlternates);
 }
@@ -111,6 +224,8 @@ enum CommandResult parse_alternates(const struct Command *cmd,
     if (parse_grouplist(&gl, token, line, err, NeoMutt->groups) == -1)
       goto done;
 
+    // Invalidate the matcher before changing the lists, even if we fail
+    AlternatesReady = false;
     mutt_regexlist_remove(&UnAlternates, buf_string(token));
 
     if (mutt_regexlist_add(&Alternates, buf_string(token), REG_ICASE, err) != 0)
@@ -152,6 +267,9 @@ enum CommandResult parse_unalternates(const struct Command *cmd,
   do
   {
     parse_extract_token(token, line, TOKEN_NO_FLAGS);
+
+    // Invalidate the matcher before changing the lists, even if we fail
+    AlternatesReady = false;
     mutt_regexlist_remove(&Alternates, buf_string(token));
 
     if (!mutt_str_equal(buf_string(token), "*") &&
@@ -182,7 +300,19 @@ bool mutt_alternates_match(const char *addr)
   if (!addr)
     return false;
 
-  if (mutt_regexlist_match(&Alternates, addr))
+  if (!AlternatesReady)
+    alternates_matcher_build();
+
+  bool match = mutt_hash_find(AlternatesExact, addr);
+  if (!match)
+  {
+    if (AlternatesUseList)
+      match = mutt_regexlist_match(&Alternates, addr);
+    else
+      match = mutt_regex_match(AlternatesCombined, addr);
+  }
+
+  if (match)
   {
     mutt_debug(LL_DEBUG5, "yes, %s matched by alternates\n", addr);
     if (mutt_regexlist_match(&UnAlternates, addr))
@@ -909,6 +909,7 @@ const struct MxOps MxCompOps = {
   .msg_commit       = comp_msg_commit,
   .msg_close        = comp_msg_close,
   .msg_padding_size = comp_msg_padding_size,
+  .msg_prefetch     = NULL,
   .msg_save_hcache  = comp_msg_save_hcache,
   .tags_edit        = comp_tags_edit,
   .tags_commit      = comp_tags_commit,
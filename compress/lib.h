@@ -45,11 +45,15 @@
  * Usage with Compression Level set to X:
  * - open(level X) -> N times compress() -> close()
  * - open(level X) -> N times decompress() -> close()
+ *
+ * Backends that support dictionaries can be given one, between open() and
+ * compress(), by load_dict() or train().
  */
 
 #ifndef MUTT_COMPRESS_LIB_H
 #define MUTT_COMPRESS_LIB_H
 
+#include <stdbool.h>
 #include <stdlib.h>
 
 /// Opaque type for compression data
@@ -110,6 +114,49 @@ struct ComprOps
    */
   void *(*decompress)(ComprHandle *handle, const char *cbuf, size_t clen);
 
+  /**
+   * @defgroup compress_train train()
+   * @ingroup compress_api
+   *
+   * train - Create a compression dictionary from sample data
+   * @param[in]  handle  Compression handle
+   * @param[in]  samples Sample data, concatenated
+   * @param[in]  sizes   Sizes of the samples
+   * @param[in]  count   Number of samples
+   * @param[out] dlen    Length of the returned dictionary
+   * @retval ptr  Success, pointer to the dictionary
+   * @retval NULL Otherwise
+   *
+   * The new dictionary will be used by subsequent calls to compress() and
+   * decompress().  Data compressed without a dictionary can still be
+   * decompressed.
+   *
+   * @note This function returns a pointer to data, which will be freed by the
+   *       close() function.
+   *
+   * @note This function is optional
+   */
+  void *(*train)(ComprHandle *handle, const void *samples, const size_t *sizes,
+                 size_t count, size_t *dlen);
+
+  /**
+   * @defgroup compress_load_dict load_dict()
+   * @ingroup compress_api
+   *
+   * load_dict - Use a compression dictionary
+   * @param[in] handle Compression handle
+   * @param[in] dict   Dictionary, created by train()
+   * @param[in] dlen   Length of the dictionary
+   * @retval true Success
+   *
+   * The dictionary will be used by subsequent calls to compress() and
+   * decompress().  Data compressed without a dictionary can still be
+   * decompressed.
+   *
+   * @note This function is optional
+   */
+  bool (*load_dict)(ComprHandle *handle, const void *dict, size_t dlen);
+
   /**
    * @defgroup compress_close close()
    * @ingroup compress_api
@@ -30,7 +30,9 @@
  */
 
 #include "config.h"
+#include <stdbool.h>
 #include <stdio.h>
+#include <zdict.h>
 #include <zstd.h>
 #include "private.h"
 #include "mutt/lib.h"
@@ -38,6 +40,7 @@
 
 #define MIN_COMP_LEVEL 1  ///< Minimum compression level for zstd
 #define MAX_COMP_LEVEL 22 ///< Maximum compression level for zstd
+#define MAX_DICT_SIZE (16 * 1024) ///< Maximum size of a trained dictionary
 
 /**
  * struct ZstdComprData - Private Zstandard Compression Data
@@ -49,6 +52,11 @@ struct ZstdComprData
 
   ZSTD_CCtx *cctx; ///< Compression context
   ZSTD_DCtx *dctx; ///< Decompression context
+
+  void *dict;            ///< Trained dictionary
+  ZSTD_CDict *cdict;     ///< Compression dictionary
+  ZSTD_DDict *ddict;     ///< Decompression dictionary
+  unsigned int dict_id;  ///< Id of the dictionary
 };
 
 /**
@@ -62,6 +70,7 @@ void zstd_cdata_free(struct ZstdComprData **ptr)
 
   struct ZstdComprData *cdata = *ptr;
   FREE(&cdata->buf);
+  FREE(&cdata->dict);
 
   FREE(ptr);
 }
@@ -124,7 +133,11 @@ static void *compr_zstd_compress(ComprHandle *handle, const char *data,
   size_t len = ZSTD_compressBound(dlen);
   mutt_mem_realloc(&cdata->buf, len);
 
-  size_t rc = ZSTD_compressCCtx(cdata->cctx, cdata->buf, len, data, dlen, cdata->level);
+  size_t rc;
+  if (cdata->cdict)
+    rc = ZSTD_compress_usingCDict(cdata->cctx, cdata->buf, len, data, dlen, cdata->cdict);
+  else
+    rc = ZSTD_compressCCtx(cdata->cctx, cdata->buf, len, data, dlen, cdata->level);
   if (ZSTD_isError(rc))
     return NULL; // LCOV_EXCL_LINE
 
@@ -151,15 +164,95 @@ static void *compr_zstd_decompress(ComprHandle *handle, const char *cbuf, size_t
     return NULL;
   else if (len == 0)
     return NULL; // LCOV_EXCL_LINE
+  // Data compressed with a different dictionary can't be decompressed
+  unsigned int dict_id = ZSTD_getDictID_fromFrame(cbuf, clen);
+  if ((dict_id != 0) && (dict_id != cdata->dict_id))
+    return NULL;
+
   mutt_mem_realloc(&cdata->buf, len);
 
-  size_t rc = ZSTD_decompressDCtx(cdata->dctx, cdata->buf, len, cbuf, clen);
+  size_t rc;
+  if (dict_id != 0)
+    rc = ZSTD_decompress_usingDDict(cdata->dctx, cdata->buf, len, cbuf, clen, cdata->ddict);
+  else
+    rc = ZSTD_decompressDCtx(cdata->dctx, cdata->buf, len, cbuf, clen);
   if (ZSTD_isError(rc))
     return NULL; // LCOV_EXCL_LINE
 
   return cdata->buf;
 }
 
+/**
+ * compr_zstd_load_dict - Use a compression dictionary - Implements ComprOps::load_dict() - @ingroup compress_load_dict
+ */
+static bool compr_zstd_load_dict(ComprHandle *handle, const void *dict, size_t dlen)
+{
+  if (!handle || !dict || (dlen == 0))
+    return false;
+
+  // Decloak an opaque pointer
+  struct ZstdComprData *cdata = handle;
+
+  // Only trained dictionaries have an id, which is needed to decompress
+  unsigned int dict_id = ZSTD_getDictID_fromDict(dict, dlen);
+  if (dict_id == 0)
+    return false;
+
+  ZSTD_CDict *cdict = ZSTD_createCDict(dict, dlen, cdata->level);
+  ZSTD_DDict *ddict = ZSTD_createDDict(dict, dlen);
+  if (!cdict || !ddict)
+  {
+    // LCOV_EXCL_START
+    ZSTD_freeCDict(cdict);
+    ZSTD_freeDDict(ddict);
+    return false;
+    // LCOV_EXCL_STOP
+  }
+
+  ZSTD_freeCDict(cdata->cdict);
+  ZSTD_freeDDict(cdata->ddict);
+  cdata->cdict = cdict;
+  cdata->ddict = ddict;
+  cdata->dict_id = dict_id;
+
+  return true;
+}
+
+/**
+ * compr_zstd_train - Create a compression dictionary from sample data - Implements ComprOps::train() - @ingroup compress_train
+ */
+static void *compr_zstd_train(ComprHandle *handle, const void *samples,
+                              const size_t *sizes, size_t count, size_t *dlen)
+{
+  if (!handle || !samples || !sizes || (count == 0) || !dlen)
+    return NULL;
+
+  // Decloak an opaque pointer
+  struct ZstdComprData *cdata = handle;
+
+  void *dict = mutt_mem_malloc(MAX_DICT_SIZE);
+  size_t rc = ZDICT_trainFromBuffer(dict, MAX_DICT_SIZE, samples, sizes, count);
+  if (ZDICT_isError(rc))
+  {
+    mutt_debug(LL_DEBUG1, "Can't train a %s dictionary: %s\n",
+               compr_zstd_ops.name, ZDICT_getErrorName(rc));
+    FREE(&dict);
+    return NULL;
+  }
+
+  if (!compr_zstd_load_dict(handle, dict, rc))
+  {
+    FREE(&dict); // LCOV_EXCL_LINE
+    return NULL; // LCOV_EXCL_LINE
+  }
+
+  FREE(&cdata->dict);
+  cdata->dict = dict;
+  *dlen = rc;
+
+  return dict;
+}
+
 /**
  * compr_zstd_close - Close a compression context - Implements ComprOps::close() - @ingroup compress_close
  */
@@ -177,7 +270,10 @@ static void compr_zstd_close(ComprHandle **ptr)
   if (cdata->dctx)
     ZSTD_freeDCtx(cdata->dctx);
 
+  ZSTD_freeCDict(cdata->cdict);
+  ZSTD_freeDDict(cdata->ddict);
+
   zstd_cdata_free((struct ZstdComprData **) ptr);
 }
 
-COMPRESS_OPS(zstd, MIN_COMP_LEVEL, MAX_COMP_LEVEL)
+COMPRESS_DICT_OPS(zstd, MIN_COMP_LEVEL, MAX_COMP_LEVEL)
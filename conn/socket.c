@@ -190,6 +190,35 @@ int mutt_socket_poll(struct Connection *conn, time_t wait_secs)
   return -1;
 }
 
+/**
+ * socket_fill - Refill the Connection's read buffer
+ * @param conn Connection to a server
+ * @retval >0 Success, number of bytes available
+ * @retval -1 Error
+ */
+static int socket_fill(struct Connection *conn)
+{
+  if (conn->fd < 0)
+  {
+    mutt_debug(LL_DEBUG1, "attempt to read from closed connection\n");
+    return -1;
+  }
+
+  conn->available = conn->read(conn, conn->inbuf, sizeof(conn->inbuf));
+  conn->bufpos = 0;
+  if (conn->available == 0)
+  {
+    mutt_error(_("Connection to %s closed"), conn->account.host);
+  }
+  if (conn->available <= 0)
+  {
+    mutt_socket_close(conn);
+    return -1;
+  }
+
+  return conn->available;
+}
+
 /**
  * mutt_socket_readchar - Simple read buffering to speed things up
  * @param[in]  conn Connection to a server
@@ -199,33 +228,36 @@ int mutt_socket_poll(struct Connection *conn, time_t wait_secs)
  */
 int mutt_socket_readchar(struct Connection *conn, char *c)
 {
-  if (conn->bufpos >= conn->available)
-  {
-    if (conn->fd >= 0)
-    {
-      conn->available = conn->read(conn, conn->inbuf, sizeof(conn->inbuf));
-    }
-    else
-    {
-      mutt_debug(LL_DEBUG1, "attempt to read from closed connection\n");
-      return -1;
-    }
-    conn->bufpos = 0;
-    if (conn->available == 0)
-    {
-      mutt_error(_("Connection to %s closed"), conn->account.host);
-    }
-    if (conn->available <= 0)
-    {
-      mutt_socket_close(conn);
-      return -1;
-    }
-  }
+  if ((conn->bufpos >= conn->available) && (socket_fill(conn) < 0))
+    return -1;
+
   *c = conn->inbuf[conn->bufpos];
   conn->bufpos++;
   return 1;
 }
 
+/**
+ * mutt_socket_readbytes - Read a block of data through the read buffer
+ * @param conn Connection to a server
+ * @param buf  Buffer to store the data
+ * @param len  Maximum number of bytes to read
+ * @retval >0 Success, number of bytes read
+ * @retval -1 Error
+ *
+ * Copy whatever is already buffered, up to len bytes.  The socket is only
+ * read if the buffer is empty, so this may return fewer than len bytes.
+ */
+int mutt_socket_readbytes(struct Connection *conn, char *buf, size_t len)
+{
+  if ((conn->bufpos >= conn->available) && (socket_fill(conn) < 0))
+    return -1;
+
+  const size_t n = MIN(len, (size_t) (conn->available - conn->bufpos));
+  memcpy(buf, conn->inbuf + conn->bufpos, n);
+  conn->bufpos += n;
+  return n;
+}
+
 /**
  * mutt_socket_readln_d - Read a line from a socket
  * @param buf    Buffer to store the line
@@ -237,20 +269,31 @@ int mutt_socket_readchar(struct Connection *conn, char *c)
  */
 int mutt_socket_readln_d(char *buf, size_t buflen, struct Connection *conn, int dbg)
 {
-  char ch;
-  int i;
+  size_t i = 0;
 
-  for (i = 0; i < buflen - 1; i++)
+  while (i < (buflen - 1))
   {
-    if (mutt_socket_readchar(conn, &ch) != 1)
+    if ((conn->bufpos >= conn->available) && (socket_fill(conn) < 0))
     {
       buf[i] = '\0';
       return -1;
     }
 
-    if (ch == '\n')
+    /* copy up to the end of the line, or as much as will fit */
+    const char *start = conn->inbuf + conn->bufpos;
+    const size_t avail = MIN((size_t) (conn->available - conn->bufpos), buflen - 1 - i);
+    const char *nl = memchr(start, '\n', avail);
+    const size_t n = nl ? (nl - start) : avail;
+
+    memcpy(buf + i, start, n);
+    i += n;
+    conn->bufpos += n;
+
+    if (nl)
+    {
+      conn->bufpos++;
       break;
-    buf[i] = ch;
+    }
   }
 
   /* strip \r from \r\n termination */
@@ -327,29 +370,34 @@ void mutt_socket_empty(struct Connection *conn)
  */
 int mutt_socket_buffer_readln_d(struct Buffer *buf, struct Connection *conn, int dbg)
 {
-  char ch;
-  bool has_cr = false;
-
   buf_reset(buf);
 
   while (true)
   {
-    if (mutt_socket_readchar(conn, &ch) != 1)
+    if ((conn->bufpos >= conn->available) && (socket_fill(conn) < 0))
       return -1;
 
-    if (ch == '\n')
-      break;
+    const char *start = conn->inbuf + conn->bufpos;
+    const size_t avail = conn->available - conn->bufpos;
+    const char *nl = memchr(start, '\n', avail);
+    const size_t n = nl ? (nl - start) : avail;
 
-    if (has_cr)
+    buf_addstr_n(buf, start, n);
+    conn->bufpos += n;
+
+    if (nl)
     {
-      buf_addch(buf, '\r');
-      has_cr = false;
+      conn->bufpos++;
+      break;
     }
+  }
 
-    if (ch == '\r')
-      has_cr = true;
-    else
-      buf_addch(buf, ch);
+  /* strip \r from \r\n termination */
+  const size_t len = buf_len(buf);
+  if ((len > 0) && (buf->data[len - 1] == '\r'))
+  {
+    buf->data[len - 1] = '\0';
+    buf_fix_dptr(buf);
   }
 
   mutt_debug(dbg, "%d< %s\n", conn->fd, buf_string(buf));
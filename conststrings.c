@@ -0,0 +1,21 @@
+ unsigned char cc_cflags[] = {
+  0x2d, 0x73, 0x74, 0x64, 0x3d, 0x63, 0x31, 0x31, 0x20, 0x2d, 0x66, 0x6e, 
+  0x6f, 0x2d, 0x64, 0x65, 0x6c, 0x65, 0x74, 0x65, 0x2d, 0x6e, 0x75, 0x6c, 
+  0x6c, 0x2d, 0x70, 0x6f, 0x69, 0x6e, 0x74, 0x65, 0x72, 0x2d, 0x63, 0x68, 
+  0x65, 0x63, 0x6b, 0x73, 0x20, 0x2d, 0x44, 0x5f, 0x41, 0x4c, 0x4c, 0x5f, 
+  0x53, 0x4f, 0x55, 0x52, 0x43, 0x45, 0x3d, 0x31, 0x20, 0x2d, 0x44, 0x5f, 
+  0x47, 0x4e, 0x55, 0x5f, 0x53, 0x4f, 0x55, 0x52, 0x43, 0x45, 0x3d, 0x31, 
+  0x20, 0x2d, 0x44, 0x5f, 0x5f, 0x45, 0x58, 0x54, 0x45, 0x4e, 0x53, 0x49, 
+  0x4f, 0x4e, 0x53, 0x5f, 0x5f, 0x20, 0x2d, 0x44, 0x5f, 0x58, 0x4f, 0x50, 
+  0x45, 0x4e, 0x5f, 0x53, 0x4f, 0x55, 0x52, 0x43, 0x45, 0x5f, 0x45, 0x58, 
+  0x54, 0x45, 0x4e, 0x44, 0x45, 0x44, 0x20, 0x2d, 0x44, 0x4e, 0x43, 0x55, 
+  0x52, 0x53, 0x45, 0x53, 0x5f, 0x57, 0x49, 0x44, 0x45, 0x43, 0x48, 0x41, 
+  0x52, 0x20, 0x2d, 0x49, 0x2f, 0x75, 0x73, 0x72, 0x2f, 0x69, 0x6e, 0x63, 
+  0x6c, 0x75, 0x64, 0x65, 0x20, 0x2d, 0x4f, 0x32, 0x00
+};
+ unsigned char configure_options[] = {
+  0x2d, 0x2d, 0x64, 0x69, 0x73, 0x61, 0x62, 0x6c, 0x65, 0x2d, 0x64, 0x6f, 
+  0x63, 0x20, 0x2d, 0x2d, 0x64, 0x69, 0x73, 0x61, 0x62, 0x6c, 0x65, 0x2d, 
+  0x6e, 0x6c, 0x73, 0x00
+};
+
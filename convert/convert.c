@@ -31,12 +31,202 @@
 #include <errno.h>
 #include <iconv.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include "mutt/lib.h"
 #include "email/lib.h"
 #include "lib.h"
 
+#define CONVERT_BUFSIZE (16 * 1024) ///< Size of the input buffer
+
+/**
+ * enum ConvertTextClass - Classification of a file's text
+ */
+enum ConvertTextClass
+{
+  CONVERT_TEXT_ASCII, ///< Only 7-bit characters
+  CONVERT_TEXT_UTF8,  ///< Valid UTF-8, with some 8-bit characters
+  CONVERT_TEXT_OTHER, ///< Anything else
+};
+
+/**
+ * struct Utf8Scan - State of a UTF-8 validity scan
+ */
+struct Utf8Scan
+{
+  bool utf8;          ///< Accept UTF-8, not just ASCII
+  bool eight_bit;     ///< An 8-bit character has been seen
+  unsigned char need; ///< Number of continuation bytes still expected
+  unsigned char lo;   ///< Lowest valid value of the next continuation byte
+  unsigned char hi;   ///< Highest valid value of the next continuation byte
+};
+
+/**
+ * utf8_scan - Check a block of text is valid UTF-8
+ * @param[in]     buf Text to check
+ * @param[in]     len Length of the text
+ * @param[in,out] us  Scan state, carried between blocks
+ * @retval true The text is valid so far
+ *
+ * Runs of ASCII are skipped a word at a time.  Overlong forms, surrogates and
+ * code points above U+10FFFF are rejected, as iconv would.
+ */
+static bool utf8_scan(const unsigned char *buf, size_t len, struct Utf8Scan *us)
+{
+  size_t i = 0;
+  while (i < len)
+  {
+    if (us->need == 0)
+    {
+      while ((len - i) >= sizeof(uint64_t))
+      {
+        uint64_t word;
+        memcpy(&word, buf + i, sizeof(word));
+        if (word & 0x8080808080808080ULL)
+          break;
+        i += sizeof(word);
+      }
+      if (i == len)
+        break;
+
+      const unsigned char c = buf[i++];
+      if (c < 0x80)
+        continue;
+
+      if (!us->utf8)
+        return false;
+
+      us->eight_bit = true;
+      us->lo = 0x80;
+      us->hi = 0xBF;
+      if (c < 0xC2)
+      {
+        return false;
+      }
+      else if (c < 0xE0)
+      {
+        us->need = 1;
+      }
+      else if (c < 0xF0)
+      {
+        us->need = 2;
+        if (c == 0xE0)
+          us->lo = 0xA0;
+        else if (c == 0xED)
+          us->hi = 0x9F;
+      }
+      else if (c < 0xF5)
+      {
+        us->need = 3;
+        if (c == 0xF0)
+          us->lo = 0x90;
+        else if (c == 0xF4)
+          us->hi = 0x8F;
+      }
+      else
+      {
+        return false;
+      }
+    }
+    else
+    {
+      const unsigned char c = buf[i++];
+      if ((c < us->lo) || (c > us->hi))
+        return false;
+      us->lo = 0x80;
+      us->hi = 0xBF;
+      us->need--;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * utf8_complete - Find the end of the last complete UTF-8 character
+ * @param buf Valid UTF-8 text
+ * @param len Length of the text
+ * @retval num Length of the text, without any trailing partial character
+ */
+static size_t utf8_complete(const char *buf, size_t len)
+{
+  size_t i = len;
+  size_t cont = 0;
+  while ((cont < 3) && (i > 0) && ((buf[i - 1] & 0xC0) == 0x80))
+  {
+    i--;
+    cont++;
+  }
+  if (i == 0)
+    return len;
+
+  const unsigned char c = buf[i - 1];
+  const size_t seqlen = (c < 0x80) ? 1 : (c < 0xE0) ? 2 : (c < 0xF0) ? 3 : 4;
+  return (seqlen == (cont + 1)) ? len : (i - 1);
+}
+
+/**
+ * convert_classify - Classify the text of a file
+ * @param[in]  fp    File to read
+ * @param[in]  utf8  Accept UTF-8, not just ASCII
+ * @param[in]  buf   Buffer of #CONVERT_BUFSIZE bytes
+ * @param[out] info  Encoding information
+ * @param[out] state Content state, for the EOF update
+ * @retval enum Classification, e.g. #CONVERT_TEXT_ASCII
+ *
+ * The scan stops as soon as the text is known to be #CONVERT_TEXT_OTHER.
+ * Otherwise, @a info describes the whole file.
+ */
+static enum ConvertTextClass convert_classify(FILE *fp, bool utf8, char *buf,
+                                              struct Content *info,
+                                              struct ContentState *state)
+{
+  struct Utf8Scan us = { .utf8 = utf8 };
+
+  rewind(fp);
+  size_t n;
+  while ((n = fread(buf, 1, CONVERT_BUFSIZE, fp)) > 0)
+  {
+    if (!utf8_scan((const unsigned char *) buf, n, &us))
+      return CONVERT_TEXT_OTHER;
+    mutt_update_content_info(info, state, buf, n);
+  }
+
+  if (us.need != 0)
+    return CONVERT_TEXT_OTHER;
+
+  return us.eight_bit ? CONVERT_TEXT_UTF8 : CONVERT_TEXT_ASCII;
+}
+
+/**
+ * iconv_ascii_transparent - Does a conversion leave ASCII unchanged?
+ * @param cd iconv handle
+ * @retval true Every 7-bit character converts to itself
+ */
+static bool iconv_ascii_transparent(iconv_t cd)
+{
+  char in[128];
+  char out[4 * sizeof(in)];
+
+  for (size_t i = 0; i < sizeof(in); i++)
+    in[i] = (char) i;
+
+  const char *ib = in;
+  size_t ibl = sizeof(in);
+  char *ob = out;
+  size_t obl = sizeof(out);
+
+  iconv(cd, NULL, NULL, NULL, NULL);
+  size_t n = iconv(cd, (ICONV_CONST char **) &ib, &ibl, &ob, &obl);
+  if (n != ICONV_ILLEGAL_SEQ)
+    n = iconv(cd, NULL, NULL, &ob, &obl);
+  iconv(cd, NULL, NULL, NULL, NULL);
+
+  return (n == 0) && (ibl == 0) && ((ob - out) == sizeof(in)) &&
+         (memcmp(in, out, sizeof(in)) == 0);
+}
+
 /**
  * mutt_convert_file_to - Change the encoding of a file
  * @param[in]  fp         File to convert
@@ -57,6 +247,11 @@
  * doing the second conversion because iconv_open("UTF-8", "UTF-8")
  * fails with some libraries.
  *
+ * Plain ASCII and valid UTF-8 files are recognised first, by a single scan.
+ * Their UTF-8 form is the file itself, so the first conversion is skipped,
+ * ASCII-compatible candidates are accepted without a trial, and the trials
+ * stop once no earlier candidate can win.
+ *
  * We assume that the output from iconv is never more than 4 times as
  * long as the input for any pair of charsets we might be interested
  * in.
@@ -64,34 +259,63 @@
 size_t mutt_convert_file_to(FILE *fp, const char *fromcode, struct Slist const *const tocodes,
                             int *tocode, struct Content *info)
 {
-  char bufi[256] = { 0 };
-  char bufu[512] = { 0 };
-  char bufo[4 * sizeof(bufi)] = { 0 };
   size_t rc;
 
   const iconv_t cd1 = mutt_ch_iconv_open("utf-8", fromcode, MUTT_ICONV_NO_FLAGS);
   if (!iconv_t_valid(cd1))
     return -1;
 
+  char *bufi = MUTT_MEM_MALLOC(CONVERT_BUFSIZE, char);
+  char *bufu = MUTT_MEM_MALLOC(2 * CONVERT_BUFSIZE, char);
+  char *bufo = MUTT_MEM_MALLOC(4 * CONVERT_BUFSIZE, char);
+
+  /* If the file is ASCII or UTF-8, it's already in the intermediate form */
+  struct Content raw_info = { 0 };
+  struct ContentState raw_state = { 0 };
+  enum ConvertTextClass tc = CONVERT_TEXT_OTHER;
+  const bool from_utf8 = mutt_ch_is_utf8(fromcode);
+  if (from_utf8 || iconv_ascii_transparent(cd1))
+    tc = convert_classify(fp, from_utf8, bufi, &raw_info, &raw_state);
+  const bool direct = (tc != CONVERT_TEXT_OTHER);
+
   int ncodes = tocodes->count;
   iconv_t *cd = MUTT_MEM_CALLOC(ncodes, iconv_t);
   size_t *score = MUTT_MEM_CALLOC(ncodes, size_t);
   struct ContentState *states = MUTT_MEM_CALLOC(ncodes, struct ContentState);
   struct Content *infos = MUTT_MEM_CALLOC(ncodes, struct Content);
 
+  /* Only candidates before the first certain winner need a trial */
+  int ntrials = ncodes;
+
   struct ListNode *np = NULL;
   int ni = 0;
   STAILQ_FOREACH(np, &tocodes->head, entries)
   {
+    bool winner = false;
     if (!mutt_istr_equal(np->data, "utf-8"))
     {
       cd[ni] = mutt_ch_iconv_open(np->data, "utf-8", MUTT_ICONV_NO_FLAGS);
+      if (direct && iconv_t_valid(cd[ni]))
+      {
+        if ((tc == CONVERT_TEXT_ASCII) && iconv_ascii_transparent(cd[ni]))
+          winner = true;
+        else if ((tc == CONVERT_TEXT_UTF8) && mutt_ch_is_us_ascii(np->data))
+          score[ni] = ICONV_ILLEGAL_SEQ;
+      }
     }
     else
     {
       /* Special case for conversion to UTF-8 */
       cd[ni] = ICONV_T_INVALID;
       score[ni] = ICONV_ILLEGAL_SEQ;
+      winner = direct;
+    }
+
+    if (winner && (ntrials == ncodes))
+    {
+      infos[ni] = raw_info;
+      states[ni] = raw_state;
+      ntrials = ni;
     }
     ni += 1;
   }
@@ -100,31 +324,60 @@ size_t mutt_convert_file_to(FILE *fp, const char *fromcode, struct Slist const *
   size_t ibl = 0;
   while (true)
   {
+    if (direct)
+    {
+      /* Stop when all the remaining trials have failed */
+      bool pending = false;
+      for (int i = 0; i < ntrials; i++)
+      {
+        if (iconv_t_valid(cd[i]) && (score[i] != ICONV_ILLEGAL_SEQ))
+          pending = true;
+      }
+      if (!pending)
+      {
+        rc = 0;
+        break;
+      }
+    }
+
     /* Try to fill input buffer */
-    size_t n = fread(bufi + ibl, 1, sizeof(bufi) - ibl, fp);
+    size_t n = fread(bufi + ibl, 1, CONVERT_BUFSIZE - ibl, fp);
     ibl += n;
 
-    /* Convert to UTF-8 */
     const char *ib = bufi;
-    char *ob = bufu;
-    size_t obl = sizeof(bufu);
-    n = iconv(cd1, (ICONV_CONST char **) ((ibl != 0) ? &ib : 0), &ibl, &ob, &obl);
-    if ((n == ICONV_ILLEGAL_SEQ) && (((errno != EINVAL) && (errno != E2BIG)) || (ib == bufi)))
+    const char *ubuf = bufu;
+    size_t ubl1;
+    if (direct)
     {
-      rc = ICONV_ILLEGAL_SEQ;
-      break;
+      /* Already UTF-8, pass on whole characters */
+      ubuf = bufi;
+      ubl1 = (n == 0) ? ibl : utf8_complete(bufi, ibl);
+      ib += ubl1;
+      ibl -= ubl1;
+    }
+    else
+    {
+      /* Convert to UTF-8 */
+      char *ob = bufu;
+      size_t obl = 2 * CONVERT_BUFSIZE;
+      n = iconv(cd1, (ICONV_CONST char **) ((ibl != 0) ? &ib : 0), &ibl, &ob, &obl);
+      if ((n == ICONV_ILLEGAL_SEQ) && (((errno != EINVAL) && (errno != E2BIG)) || (ib == bufi)))
+      {
+        rc = ICONV_ILLEGAL_SEQ;
+        break;
+      }
+      ubl1 = ob - bufu;
     }
-    const size_t ubl1 = ob - bufu;
 
     /* Convert from UTF-8 */
-    for (int i = 0; i < ncodes; i++)
+    for (int i = 0; i < ntrials; i++)
     {
       if (iconv_t_valid(cd[i]) && (score[i] != ICONV_ILLEGAL_SEQ))
       {
-        const char *ub = bufu;
+        const char *ub = ubuf;
         size_t ubl = ubl1;
-        ob = bufo;
-        obl = sizeof(bufo);
+        char *ob = bufo;
+        size_t obl = 4 * CONVERT_BUFSIZE;
         n = iconv(cd[i], (ICONV_CONST char **) ((ibl || ubl) ? &ub : 0), &ubl, &ob, &obl);
         if (n == ICONV_ILLEGAL_SEQ)
         {
@@ -139,7 +392,7 @@ size_t mutt_convert_file_to(FILE *fp, const char *fromcode, struct Slist const *
       else if (!iconv_t_valid(cd[i]) && (score[i] == ICONV_ILLEGAL_SEQ))
       {
         /* Special case for conversion to UTF-8 */
-        mutt_update_content_info(&infos[i], &states[i], bufu, ubl1);
+        mutt_update_content_info(&infos[i], &states[i], (char *) ubuf, ubl1);
       }
     }
 
@@ -148,7 +401,7 @@ size_t mutt_convert_file_to(FILE *fp, const char *fromcode, struct Slist const *
       /* Save unused input */
       memmove(bufi, ib, ibl);
     }
-    else if (!ubl1 && (ib < bufi + sizeof(bufi)))
+    else if (!ubl1 && (ib < bufi + CONVERT_BUFSIZE))
     {
       rc = 0;
       break;
@@ -187,6 +440,9 @@ size_t mutt_convert_file_to(FILE *fp, const char *fromcode, struct Slist const *
     }
   }
 
+  FREE(&bufi);
+  FREE(&bufu);
+  FREE(&bufo);
   FREE(&cd);
   FREE(&infos);
   FREE(&score);
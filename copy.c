@@ -472,27 +472,7 @@ int mutt_copy_header(FILE *fp_in, struct Email *e, FILE *fp_out,
   }
 
   if ((chflags & CH_UPDATE) && ((chflags & CH_NOSTATUS) == 0))
-  {
-    if ((e->old || e->read))
-    {
-      fputs("Status: ", fp_out);
-      if (e->read)
-        fputs("RO", fp_out);
-      else if (e->old)
-        fputc('O', fp_out);
-      fputc('\n', fp_out);
-    }
-
-    if ((e->flagged || e->replied))
-    {
-      fputs("X-Status: ", fp_out);
-      if (e->replied)
-        fputc('A', fp_out);
-      if (e->flagged)
-        fputc('F', fp_out);
-      fputc('\n', fp_out);
-    }
-  }
+    mutt_write_status(fp_out, e, (chflags & CH_PAD_STATUS));
 
   if (chflags & CH_UPDATE_LEN && ((chflags & CH_NOLEN) == 0) &&
       !(c_weed && mutt_matches_ignore("Content-Length")))
@@ -43,6 +43,8 @@ static const struct Slist *CachedAssumedCharset = NULL;
 static const char *CachedCharset = NULL;
 /// Cached value of $maildir_field_delimiter
 static const char *CachedMaildirFieldDelimiter = NULL;
+/// Config handles that have been used
+static struct CachedConfig *CachedConfigs = NULL;
 
 /**
  * cc_config_observer - Notification that a Config Variable has changed - Implements ::observer_t - @ingroup observer_api
@@ -73,6 +75,12 @@ static int cc_config_observer(struct NotifyCallback *nc)
                                                                          ev_c->he, NULL);
   }
 
+  for (struct CachedConfig *cc = CachedConfigs; cc; cc = cc->next)
+  {
+    if (mutt_str_equal(ev_c->name, cc->name))
+      cc->valid = false;
+  }
+
   mutt_debug(LL_DEBUG5, "config done\n");
   return 0;
 }
@@ -139,6 +147,34 @@ const char *cc_maildir_field_delimiter(void)
   return CachedMaildirFieldDelimiter;
 }
 
+/**
+ * cc_resolve - Look up a config variable and cache its value
+ * @param cc Config handle
+ * @retval num Native value
+ *
+ * @note Use cc_bool(), cc_number(), etc, rather than calling this directly
+ */
+intptr_t cc_resolve(struct CachedConfig *cc)
+{
+  if (!CacheActive)
+    cache_setup();
+
+  struct HashElem *he = cs_subset_create_inheritance(NeoMutt->sub, cc->name);
+  ASSERT(he);
+
+  cc->value = cs_subset_he_native_get(NeoMutt->sub, he, NULL);
+  cc->valid = true;
+
+  if (!cc->listed)
+  {
+    cc->next = CachedConfigs;
+    CachedConfigs = cc;
+    cc->listed = true;
+  }
+
+  return cc->value;
+}
+
 /**
  * config_cache_cleanup - Cleanup the cache of charset config variables
  */
@@ -152,5 +188,15 @@ void config_cache_cleanup(void)
   CachedCharset = NULL;
   CachedMaildirFieldDelimiter = NULL;
 
+  struct CachedConfig *next = NULL;
+  for (struct CachedConfig *cc = CachedConfigs; cc; cc = next)
+  {
+    next = cc->next;
+    cc->valid = false;
+    cc->listed = false;
+    cc->next = NULL;
+  }
+  CachedConfigs = NULL;
+
   CacheActive = false;
 }
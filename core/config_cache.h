@@ -24,6 +24,95 @@
 #ifndef MUTT_CORE_CONFIG_CACHE_H
 #define MUTT_CORE_CONFIG_CACHE_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
+struct MbTable;
+struct Regex;
+
+/**
+ * struct CachedConfig - A handle to a cached config variable
+ *
+ * Define one as a static variable, using CACHED_CONFIG(), then read it with
+ * cc_bool(), cc_number(), etc.  The variable is looked up on first use and
+ * its value is cached until the config changes.
+ *
+ * This is for code that reads the same variable for every Email.
+ */
+struct CachedConfig
+{
+  const char *name;          ///< Name of the config variable
+  intptr_t value;            ///< Cached native value
+  bool valid;                ///< Is the cached value up to date?
+  bool listed;               ///< Is the handle in the list of used handles?
+  struct CachedConfig *next; ///< Next handle in the list
+};
+
+/// Initialise a CachedConfig for a config variable
+#define CACHED_CONFIG(NAME) { .name = (NAME) }
+
+intptr_t cc_resolve(struct CachedConfig *cc);
+
+/**
+ * cc_native - Get the cached native value of a config variable
+ * @param cc Config handle
+ * @retval num Native value
+ */
+static inline intptr_t cc_native(struct CachedConfig *cc)
+{
+  return cc->valid ? cc->value : cc_resolve(cc);
+}
+
+/**
+ * cc_bool - Get the cached value of a boolean config variable
+ * @param cc Config handle
+ * @retval bool Value
+ */
+static inline bool cc_bool(struct CachedConfig *cc)
+{
+  return (bool) cc_native(cc);
+}
+
+/**
+ * cc_number - Get the cached value of a number config variable
+ * @param cc Config handle
+ * @retval num Value
+ */
+static inline short cc_number(struct CachedConfig *cc)
+{
+  return (short) cc_native(cc);
+}
+
+/**
+ * cc_string - Get the cached value of a string or path config variable
+ * @param cc Config handle
+ * @retval ptr Value, owned by the config system
+ */
+static inline const char *cc_string(struct CachedConfig *cc)
+{
+  return (const char *) cc_native(cc);
+}
+
+/**
+ * cc_mbtable - Get the cached value of a multibyte table config variable
+ * @param cc Config handle
+ * @retval ptr Value, owned by the config system
+ */
+static inline const struct MbTable *cc_mbtable(struct CachedConfig *cc)
+{
+  return (const struct MbTable *) cc_native(cc);
+}
+
+/**
+ * cc_regex - Get the cached value of a regex config variable
+ * @param cc Config handle
+ * @retval ptr Value, owned by the config system
+ */
+static inline const struct Regex *cc_regex(struct CachedConfig *cc)
+{
+  return (const struct Regex *) cc_native(cc);
+}
+
 const struct Slist *cc_assumed_charset        (void);
 const char *        cc_charset                (void);
 const char *        cc_maildir_field_delimiter(void);
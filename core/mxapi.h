@@ -270,6 +270,23 @@ struct MxOps
    */
   int (*msg_padding_size)(struct Mailbox *m);
 
+  /**
+   * @defgroup mx_msg_prefetch msg_prefetch()
+   * @ingroup mx_api
+   *
+   * msg_prefetch - Start reading a message in the background
+   * @param m Mailbox
+   * @param e Email
+   *
+   * This is only a hint that msg_open() will be called for this Email soon.
+   * The backend may begin fetching the message, so that the later read
+   * doesn't have to wait.  Errors are ignored.
+   *
+   * @pre m is not NULL
+   * @pre e is not NULL
+   */
+  void (*msg_prefetch)(struct Mailbox *m, struct Email *e);
+
   /**
    * @defgroup mx_msg_save_hcache msg_save_hcache()
    * @ingroup mx_api
@@ -1732,6 +1732,17 @@
 */
 
 #ifdef USE_HCACHE_COMPRESSION
+{ "header_cache_compress_dictionary", DT_BOOL, false },
+/*
+** .pp
+** When \fIset\fP, and $$header_cache_compress_method is "zstd", NeoMutt
+** will build a compression dictionary for each header cache file.
+** .pp
+** The dictionary is trained from the first emails stored in the cache and
+** saved in the cache file.  Email headers are small and repetitive, so a
+** dictionary gives much smaller cache files than compressing each one alone.
+*/
+
 { "header_cache_compress_level", DT_NUMBER, 1 },
 /*
 ** .pp
@@ -2012,6 +2023,9 @@
 ** disconnect when opening the mailbox, by sending a FETCH per set
 ** of this many headers, instead of a single FETCH for all new
 ** headers.
+** .pp
+** Up to $$imap_pipeline_depth of these requests are kept in flight at
+** once, so the connection isn't idle while waiting for each one to finish.
 */
 
 { "imap_headers", DT_STRING, 0 },
@@ -2485,6 +2499,20 @@
 */
 #endif
 
+{ "maildir_read_ahead", DT_NUMBER, 16 },
+/*
+** .pp
+** When reading a maildir folder, NeoMutt parses the headers of each message
+** that isn't in the header cache.  This variable controls how many message
+** files are opened ahead of the parser, so that the operating system can
+** fetch them in the background.  This can speed up opening large folders,
+** particularly on network filesystems.
+** .pp
+** The value can be between 0 and 64.  It's also limited to a quarter of the
+** process's file descriptor limit, see \fCulimit -n\fP.  Set this to 0 to
+** disable the read-ahead.
+*/
+
 { "maildir_trash", DT_BOOL, false },
 /*
 ** .pp
@@ -2538,6 +2566,29 @@
 ** Also see the $$move variable.
 */
 
+#ifdef USE_HCACHE
+{ "mbox_header_cache", DT_BOOL, false },
+/*
+** .pp
+** If \fIset\fP, NeoMutt will use the $$header_cache for mbox and mmdf
+** mailboxes.  When a mailbox is unchanged, its messages are restored from the
+** cache.  When new mail has been appended to it, only the new messages are
+** parsed.
+** .pp
+** If the mailbox has been modified in any other way, it will be parsed in full.
+*/
+#endif
+
+{ "mbox_sync_in_place", DT_BOOL, false },
+/*
+** .pp
+** If \fIset\fP, NeoMutt will pad the \fCStatus:\fP and \fCX-Status:\fP
+** header fields when it writes an mbox or mmdf mailbox.  Later, if the only
+** changes to the mailbox are to the flags of messages, NeoMutt will update
+** the fields in place, rather than rewriting the mailbox from the first
+** changed message.  Deleting messages still requires a rewrite.
+*/
+
 { "mbox_type", DT_ENUM, MUTT_MBOX },
 /*
 ** .pp
@@ -4302,6 +4353,25 @@
 ** before search results. By default, search results will be top-aligned.
 */
 
+#ifdef USE_HCACHE
+{ "search_index", DT_BOOL, false },
+/*
+** .pp
+** If \fIset\fP, NeoMutt will remember which words occur in the messages that
+** the \fC~b\fP and \fC~B\fP patterns have searched.  The index is kept in
+** the $$header_cache.  Later searches can skip the messages that can't match,
+** without reading them.
+** .pp
+** Only local mailboxes (Maildir, MH, mbox and MMDF) are indexed.  Encrypted
+** and signed messages are never indexed.  Messages are indexed the first time
+** they're searched, so the first search isn't any faster.
+** .pp
+** When $$thorough_search is \fIset\fP, changing the settings that decode a
+** message, e.g. $$charset, \fCalternative_order\fP, \fCauto_view\fP or the
+** mailcap files, means that the messages will be indexed again.
+*/
+#endif
+
 { "send_charset", DT_SLIST, "us-ascii:iso-8859-1:utf-8" },
 /*
 ** .pp
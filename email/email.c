@@ -39,6 +39,9 @@
 
 void nm_edata_free(void **ptr);
 
+/// Changes to data shared by all Emails, see email_changed_all()
+static unsigned int EmailGeneration = 0;
+
 /**
  * email_free - Free an Email
  * @param[out] ptr Email to free
@@ -61,6 +64,9 @@ void email_free(struct Email **ptr)
   mutt_body_free(&e->body);
   FREE(&e->tree);
   FREE(&e->path);
+  if (e->line)
+    FREE(&e->line->text);
+  FREE(&e->line);
 #ifdef USE_NOTMUCH
   nm_edata_free(&e->nm_edata);
 #endif
@@ -205,3 +211,54 @@ void header_free(struct ListHead *hdrlist, struct ListNode *target)
   FREE(&target->data);
   FREE(&target);
 }
+
+/**
+ * email_changed - Note that an Email's displayed data has changed
+ * @param e Email
+ *
+ * e.g. flags, tags or score.  Any cached line of the Index will be formatted
+ * again.
+ */
+void email_changed(struct Email *e)
+{
+  if (e)
+    e->gen++;
+}
+
+/**
+ * email_changed_all - Note that data shared by many Emails has changed
+ *
+ * e.g. threads, sorting or config.  Every cached line of the Index will be
+ * formatted again.
+ */
+void email_changed_all(void)
+{
+  EmailGeneration++;
+}
+
+/**
+ * email_generation - Get the generation of the data shared by all Emails
+ * @retval num Generation, see email_changed_all()
+ */
+unsigned int email_generation(void)
+{
+  return EmailGeneration;
+}
+
+/**
+ * email_tags_replace - Replace an Email's tags
+ * @param e    Email
+ * @param tags String of all tags separated by space
+ * @retval true Tags are updated
+ *
+ * Backends must use this, rather than driver_tags_replace(), so that any
+ * cached line of the Index shows the new tags.
+ */
+bool email_tags_replace(struct Email *e, const char *tags)
+{
+  if (!e || !driver_tags_replace(&e->tags, tags))
+    return false;
+
+  email_changed(e);
+  return true;
+}
@@ -27,11 +27,30 @@
 
 #include "config.h"
 #include <stdbool.h>
+#include <stdint.h>
 #include <time.h>
 #include "mutt/lib.h"
 #include "ncrypt/lib.h"
 #include "tags.h"
 
+/**
+ * struct EmailLine - Cached line of the Index
+ *
+ * The line may be reused while the change counters and the formatting
+ * parameters match, see email_changed() and email_changed_all().
+ */
+struct EmailLine
+{
+  char *text;            ///< Formatted line
+  int cols;              ///< Screen columns used by the line
+  unsigned int gen;      ///< Email::gen when the line was formatted
+  unsigned int gen_all;  ///< email_generation() when the line was formatted
+  int max_cols;          ///< Screen columns available
+  uint8_t flags;         ///< Format flags, e.g. #MUTT_FORMAT_TREE
+  bool in_pager;         ///< The Email was being shown in the Pager
+  time_t minute;         ///< When the line was formatted, in minutes
+};
+
 /**
  * struct Email - The envelope/body of an email
  */
@@ -123,6 +142,9 @@ struct Email
   size_t num_hidden;           ///< Number of hidden messages in this view
                                ///< (only valid when collapsed is set)
   char *tree;                  ///< Character string to print thread tree
+
+  unsigned int gen;            ///< Change counter, see email_changed()
+  struct EmailLine *line;      ///< Cached line of the Index
 };
 ARRAY_HEAD(EmailArray, struct Email *);
 
@@ -223,6 +245,11 @@ void          email_free      (struct Email **ptr);
 struct Email *email_new       (void);
 size_t        email_get_size  (const struct Email *e);
 
+void          email_changed     (struct Email *e);
+void          email_changed_all (void);
+unsigned int  email_generation  (void);
+bool          email_tags_replace(struct Email *e, const char *tags);
+
 struct ListNode *header_add   (struct ListHead *hdrlist, const char *header);
 struct ListNode *header_find  (const struct ListHead *hdrlist, const char *header);
 void             header_free  (struct ListHead *hdrlist, struct ListNode *target);
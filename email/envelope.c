@@ -73,7 +73,8 @@ void mutt_env_set_subject(struct Envelope *env, const char *subj)
   if (env->subject)
   {
     regmatch_t match;
-    const struct Regex *c_reply_regex = cs_subset_regex(NeoMutt->sub, "reply_regex");
+    static struct CachedConfig cc_reply_regex = CACHED_CONFIG("reply_regex");
+    const struct Regex *c_reply_regex = cc_regex(&cc_reply_regex);
     if (mutt_regex_capture(c_reply_regex, env->subject, 1, &match))
     {
       if (env->subject[match.rm_eo] != '\0')
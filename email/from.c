@@ -50,6 +50,10 @@ bool is_from(const char *s, char *path, size_t pathlen, time_t *tp)
 {
   bool lax = false;
 
+  /* Most lines aren't separators, don't bother with the regexes */
+  if (!mutt_str_startswith(s, "From "))
+    return false;
+
   const regmatch_t *match = mutt_prex_capture(PREX_MBOX_FROM, s);
   if (!match)
   {
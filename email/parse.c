@@ -865,8 +865,8 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e,
           {
             FREE(&env->list_post);
             env->list_post = mailto;
-            const bool c_auto_subscribe = cs_subset_bool(NeoMutt->sub, "auto_subscribe");
-            if (c_auto_subscribe)
+            static struct CachedConfig cc_auto_subscribe = CACHED_CONFIG("auto_subscribe");
+            if (cc_bool(&cc_auto_subscribe))
               mutt_auto_subscribe(env->list_post);
           }
         }
@@ -256,7 +256,8 @@ void rfc2231_decode_parameters(struct ParameterList *pl)
   purge_empty_parameters(pl);
 
   struct Parameter *np = NULL, *tmp = NULL;
-  const bool c_rfc2047_parameters = cs_subset_bool(NeoMutt->sub, "rfc2047_parameters");
+  static struct CachedConfig cc_rfc2047_parameters = CACHED_CONFIG("rfc2047_parameters");
+  const bool c_rfc2047_parameters = cc_bool(&cc_rfc2047_parameters);
   const struct Slist *c_assumed_charset = cc_assumed_charset();
   const char *c_charset = cc_charset();
 
@@ -32,7 +32,9 @@
 
 #include "config.h"
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include "mutt/lib.h"
 #include "address/lib.h"
 #include "config/lib.h"
@@ -142,8 +144,8 @@ const char *mutt_get_name(const struct Address *a)
 
   if (a)
   {
-    const bool c_reverse_alias = cs_subset_bool(NeoMutt->sub, "reverse_alias");
-    if (c_reverse_alias && (ali = alias_reverse_lookup(a)) && ali->personal)
+    static struct CachedConfig cc_reverse_alias = CACHED_CONFIG("reverse_alias");
+    if (cc_bool(&cc_reverse_alias) && (ali = alias_reverse_lookup(a)) && ali->personal)
       return buf_string(ali->personal);
     if (a->personal)
       return buf_string(a->personal);
@@ -159,11 +161,12 @@ const char *mutt_get_name(const struct Address *a)
  */
 static int email_sort_to(const struct Email *a, const struct Email *b, bool reverse)
 {
-  char fa[128] = { 0 };
-
-  mutt_str_copy(fa, mutt_get_name(TAILQ_FIRST(&a->env->to)), sizeof(fa));
+  /* mutt_get_name() may return a static buffer */
+  struct Buffer *fa = buf_pool_get();
+  buf_strcpy(fa, mutt_get_name(TAILQ_FIRST(&a->env->to)));
   const char *fb = mutt_get_name(TAILQ_FIRST(&b->env->to));
-  int result = mutt_istrn_cmp(fa, fb, sizeof(fa));
+  int result = mutt_istr_cmp(buf_string(fa), fb);
+  buf_pool_release(&fa);
   return reverse ? -result : result;
 }
 
@@ -172,11 +175,12 @@ static int email_sort_to(const struct Email *a, const struct Email *b, bool reve
  */
 static int email_sort_from(const struct Email *a, const struct Email *b, bool reverse)
 {
-  char fa[128] = { 0 };
-
-  mutt_str_copy(fa, mutt_get_name(TAILQ_FIRST(&a->env->from)), sizeof(fa));
+  /* mutt_get_name() may return a static buffer */
+  struct Buffer *fa = buf_pool_get();
+  buf_strcpy(fa, mutt_get_name(TAILQ_FIRST(&a->env->from)));
   const char *fb = mutt_get_name(TAILQ_FIRST(&b->env->from));
-  int result = mutt_istrn_cmp(fa, fb, sizeof(fa));
+  int result = mutt_istr_cmp(buf_string(fa), fb);
+  buf_pool_release(&fa);
   return reverse ? -result : result;
 }
 
@@ -347,6 +351,308 @@ int mutt_compare_emails(const struct Email *a, const struct Email *b,
   return rc;
 }
 
+/**
+ * enum SortKeyType - How a precomputed sort key is compared
+ */
+enum SortKeyType
+{
+  SORT_KEY_NUMBER, ///< Signed number, e.g. date, size
+  SORT_KEY_STRING, ///< Case-insensitive string, e.g. author's name
+  SORT_KEY_SUBJECT, ///< Subject, or the date if there isn't one
+  SORT_KEY_EMAIL,  ///< No key, use the sort function
+};
+
+/**
+ * union SortKey - A precomputed sort key
+ */
+union SortKey
+{
+  int64_t num;     ///< #SORT_KEY_NUMBER
+  uint64_t radix;  ///< #SORT_KEY_NUMBER, mapped for a radix sort
+  const char *str; ///< #SORT_KEY_STRING, #SORT_KEY_SUBJECT
+  size_t offset;   ///< #SORT_KEY_STRING, offset into the name Buffer
+};
+
+/**
+ * struct EmailSortKey - Precomputed sort keys for an Email
+ *
+ * The keys are: $sort, $sort_aux and the unsorted index, as a tie-breaker.
+ */
+struct EmailSortKey
+{
+  struct Email *email; ///< Email
+  union SortKey key[3]; ///< Sort keys
+};
+
+/**
+ * struct EmailSortKeys - How to compare EmailSortKeys
+ */
+struct EmailSortKeys
+{
+  enum SortKeyType type[2]; ///< How to compare each key
+  bool reverse[2];          ///< Reverse each key
+  sort_email_t func[2];     ///< Sort functions, for #SORT_KEY_EMAIL
+};
+
+/**
+ * sort_key_type - How should a sort method be keyed?
+ * @param method Sort type, see #EmailSortType
+ * @param type   Mailbox type
+ * @retval enum #SortKeyType
+ */
+static enum SortKeyType sort_key_type(enum EmailSortType method, enum MailboxType type)
+{
+  switch (method)
+  {
+    case EMAIL_SORT_DATE:
+    case EMAIL_SORT_DATE_RECEIVED:
+    case EMAIL_SORT_SCORE:
+    case EMAIL_SORT_SIZE:
+      return SORT_KEY_NUMBER;
+    case EMAIL_SORT_UNSORTED:
+      return (type == MUTT_NNTP) ? SORT_KEY_EMAIL : SORT_KEY_NUMBER;
+    case EMAIL_SORT_FROM:
+    case EMAIL_SORT_TO:
+      return SORT_KEY_STRING;
+    case EMAIL_SORT_SUBJECT:
+      return SORT_KEY_SUBJECT;
+    default:
+      return SORT_KEY_EMAIL;
+  }
+}
+
+/**
+ * sort_key_number - Get the numeric sort key of an Email
+ * @param e      Email
+ * @param method Sort type, see #EmailSortType
+ * @retval num Sort key
+ *
+ * @sa email_sort_date(), email_sort_score(), etc
+ */
+static int64_t sort_key_number(const struct Email *e, enum EmailSortType method)
+{
+  switch (method)
+  {
+    case EMAIL_SORT_DATE:
+      return e->date_sent;
+    case EMAIL_SORT_DATE_RECEIVED:
+      return e->received;
+    case EMAIL_SORT_SCORE:
+      return -(int64_t) e->score; /* highest score first */
+    case EMAIL_SORT_SIZE:
+      return e->body->length;
+    default:
+      return e->index;
+  }
+}
+
+/**
+ * sort_key_name - Add the name sort key of an Email to a Buffer
+ * @param e      Email
+ * @param method Sort type, #EMAIL_SORT_FROM or #EMAIL_SORT_TO
+ * @param names  Buffer for the names
+ * @retval num Offset of the name in the Buffer
+ *
+ * The whole name is used, like email_sort_from().
+ */
+static size_t sort_key_name(const struct Email *e, enum EmailSortType method,
+                            struct Buffer *names)
+{
+  const struct AddressList *al = (method == EMAIL_SORT_FROM) ? &e->env->from : &e->env->to;
+
+  size_t offset = buf_len(names);
+  buf_addstr(names, mutt_get_name(TAILQ_FIRST(al)));
+  buf_addch(names, '\0');
+  return offset;
+}
+
+/**
+ * email_sort_keys - Compare the precomputed keys of two emails - Implements ::sort_t - @ingroup sort_api
+ */
+static int email_sort_keys(const void *a, const void *b, void *sdata)
+{
+  const struct EmailSortKey *ka = a;
+  const struct EmailSortKey *kb = b;
+  const struct EmailSortKeys *esk = sdata;
+
+  for (int i = 0; i < 2; i++)
+  {
+    int rc;
+    switch (esk->type[i])
+    {
+      case SORT_KEY_NUMBER:
+        rc = mutt_numeric_cmp(ka->key[i].num, kb->key[i].num);
+        break;
+      case SORT_KEY_STRING:
+        rc = mutt_istr_cmp(ka->key[i].str, kb->key[i].str);
+        break;
+      case SORT_KEY_SUBJECT:
+        /* see email_sort_subject() */
+        if (ka->key[i].str && kb->key[i].str)
+          rc = mutt_istr_cmp(ka->key[i].str, kb->key[i].str);
+        else if (ka->key[i].str)
+          rc = 1;
+        else if (kb->key[i].str)
+          rc = -1;
+        else
+          rc = mutt_numeric_cmp(ka->email->date_sent, kb->email->date_sent);
+        break;
+      default:
+        rc = esk->func[i](ka->email, kb->email, esk->reverse[i]);
+        if (rc != 0)
+          return rc;
+        continue;
+    }
+
+    if (rc != 0)
+      return esk->reverse[i] ? -rc : rc;
+  }
+
+  return mutt_numeric_cmp(ka->key[2].num, kb->key[2].num);
+}
+
+/**
+ * radix_sort - Sort Emails by their numeric keys
+ * @param keys Keys to sort
+ * @param tmp  Scratch space, the same size as keys
+ * @param num  Number of keys
+ * @retval ptr Sorted keys, either keys or tmp
+ *
+ * This is a stable, least-significant-byte-first radix sort.  The keys are
+ * sorted by the tie-breaker first and the primary key last.  Bytes that are
+ * the same for every key are skipped.
+ */
+static struct EmailSortKey *radix_sort(struct EmailSortKey *keys,
+                                       struct EmailSortKey *tmp, size_t num)
+{
+  size_t count[256];
+
+  for (int k = 2; k >= 0; k--)
+  {
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+      memset(count, 0, sizeof(count));
+      for (size_t i = 0; i < num; i++)
+        count[(keys[i].key[k].radix >> shift) & 0xff]++;
+
+      if (count[(keys[0].key[k].radix >> shift) & 0xff] == num)
+        continue;
+
+      size_t pos = 0;
+      for (int b = 0; b < 256; b++)
+      {
+        size_t c = count[b];
+        count[b] = pos;
+        pos += c;
+      }
+
+      for (size_t i = 0; i < num; i++)
+        tmp[count[(keys[i].key[k].radix >> shift) & 0xff]++] = keys[i];
+
+      struct EmailSortKey *swap = keys;
+      keys = tmp;
+      tmp = swap;
+    }
+  }
+
+  return keys;
+}
+
+/**
+ * sort_emails - Sort the Emails of a Mailbox
+ * @param m        Mailbox
+ * @param sort     Primary sort, e.g. $sort
+ * @param sort_aux Secondary sort, e.g. $sort_aux
+ *
+ * This gives the same order as sorting with mutt_compare_emails().
+ *
+ * The sort keys, e.g. dates or the authors' names, are looked up once for
+ * each Email, rather than for every comparison.  If all the keys are numeric,
+ * the Emails are radix sorted.
+ */
+static void sort_emails(struct Mailbox *m, short sort, short sort_aux)
+{
+  const size_t num = m->msg_count;
+  if (num < 2)
+    return;
+
+  const enum MailboxType type = mx_type(m);
+  const short methods[2] = { sort, sort_aux };
+
+  struct EmailSortKeys esk = { 0 };
+  for (int i = 0; i < 2; i++)
+  {
+    esk.type[i] = sort_key_type(methods[i] & SORT_MASK, type);
+    esk.reverse[i] = (methods[i] & SORT_REVERSE);
+    esk.func[i] = get_sort_func(methods[i] & SORT_MASK, type);
+    if (!esk.func[i])
+      return;
+  }
+
+  struct EmailSortKey *keys = MUTT_MEM_CALLOC(num, struct EmailSortKey);
+  struct Buffer *names = buf_pool_get();
+
+  for (size_t n = 0; n < num; n++)
+  {
+    struct Email *e = m->emails[n];
+    keys[n].email = e;
+    keys[n].key[2].num = e->index;
+
+    for (int i = 0; i < 2; i++)
+    {
+      if (esk.type[i] == SORT_KEY_NUMBER)
+        keys[n].key[i].num = sort_key_number(e, methods[i] & SORT_MASK);
+      else if (esk.type[i] == SORT_KEY_STRING)
+        keys[n].key[i].offset = sort_key_name(e, methods[i] & SORT_MASK, names);
+      else if (esk.type[i] == SORT_KEY_SUBJECT)
+        keys[n].key[i].str = e->env->real_subj;
+    }
+  }
+
+  struct EmailSortKey *sorted = keys;
+  if ((esk.type[0] == SORT_KEY_NUMBER) && (esk.type[1] == SORT_KEY_NUMBER))
+  {
+    /* Map the signed keys to unsigned, preserving their order */
+    for (size_t n = 0; n < num; n++)
+    {
+      for (int i = 0; i < 3; i++)
+      {
+        keys[n].key[i].radix ^= (UINT64_C(1) << 63);
+        if ((i < 2) && esk.reverse[i])
+          keys[n].key[i].radix = ~keys[n].key[i].radix;
+      }
+    }
+
+    struct EmailSortKey *tmp = MUTT_MEM_MALLOC(num, struct EmailSortKey);
+    sorted = radix_sort(keys, tmp, num);
+    if (sorted == keys)
+      FREE(&tmp);
+    else
+      FREE(&keys);
+    keys = sorted;
+  }
+  else
+  {
+    /* The Buffer has stopped growing, so the names won't move */
+    for (size_t n = 0; n < num; n++)
+    {
+      for (int i = 0; i < 2; i++)
+      {
+        if (esk.type[i] == SORT_KEY_STRING)
+          keys[n].key[i].str = names->data + keys[n].key[i].offset;
+      }
+    }
+
+    mutt_qsort_r(keys, num, sizeof(struct EmailSortKey), email_sort_keys, &esk);
+  }
+
+  for (size_t n = 0; n < num; n++)
+    m->emails[n] = sorted[n].email;
+
+  buf_pool_release(&names);
+  FREE(&keys);
+}
+
 /**
  * mutt_sort_headers - Sort emails by their headers
  * @param mv    Mailbox View
@@ -362,6 +668,7 @@ void mutt_sort_headers(struct MailboxView *mv, bool init)
     return;
 
   OptNeedResort = false;
+  email_changed_all();
 
   if (m->msg_count == 0)
   {
@@ -406,12 +713,8 @@ void mutt_sort_headers(struct MailboxView *mv, bool init)
   }
   else
   {
-    struct EmailCompare cmp = { 0 };
-    cmp.type = mx_type(m);
-    cmp.sort = cs_subset_sort(NeoMutt->sub, "sort");
-    cmp.sort_aux = cs_subset_sort(NeoMutt->sub, "sort_aux");
-    mutt_qsort_r((void *) m->emails, m->msg_count, sizeof(struct Email *),
-                 email_sort_shim, &cmp);
+    sort_emails(m, cs_subset_sort(NeoMutt->sub, "sort"),
+                cs_subset_sort(NeoMutt->sub, "sort_aux"));
   }
 
   /* adjust the virtual message numbers */
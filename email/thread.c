@@ -112,6 +112,7 @@ void insert_message(struct MuttThread **add, struct MuttThread *parent, struct M
   cur->parent = parent;
   cur->next = *add;
   cur->prev = NULL;
+  cur->sort_moved = true;
   *add = cur;
 }
 
@@ -37,6 +37,7 @@
 #include "node_padding.h"
 #include "node_text.h"
 #include "parse.h"
+#include "program.h"
 #include "render.h"
 
 struct ExpandoDefinition;
@@ -65,6 +66,7 @@ void expando_free(struct Expando **ptr)
 
   struct Expando *exp = *ptr;
 
+  program_free(&exp->program);
   node_free(&exp->node);
   FREE(&exp->string);
 
@@ -102,6 +104,8 @@ struct Expando *expando_parse(const char *str, const struct ExpandoDefinition *d
   node_padding_repad(&exp->node);
   node_container_collapse_all(&exp->node);
 
+  exp->program = program_compile(exp->node);
+
   return exp;
 }
 
@@ -125,6 +129,9 @@ int expando_render(const struct Expando *exp, const struct ExpandoRenderCallback
   if (max_cols == -1)
     max_cols = 8192;
 
+  if (exp->program)
+    return program_render(exp->program, erc, buf, max_cols, data, flags);
+
   return node_render(exp->node, erc, buf, max_cols, data, flags);
 }
 
@@ -42,6 +42,7 @@
  * | expando/node_padding.c            | @subpage expando_node_padding   |
  * | expando/node_text.c               | @subpage expando_node_text      |
  * | expando/parse.c                   | @subpage expando_parse          |
+ * | expando/program.c                 | @subpage expando_program        |
  * | expando/render.c                  | @subpage expando_render         |
  * | expando/serial.c                  | @subpage expando_serial         |
  */
@@ -65,6 +66,7 @@
 #include "node_padding.h"
 #include "node_text.h"
 #include "parse.h"
+#include "program.h"
 #include "render.h"
 #include "serial.h"
 #include "uid.h"
@@ -24,8 +24,13 @@
 #ifndef MUTT_EXPANDO_NODE_CONTAINER_H
 #define MUTT_EXPANDO_NODE_CONTAINER_H
 
+#include "render.h"
+
+struct Buffer;
+
 struct ExpandoNode *node_container_new(void);
 
 void node_container_collapse_all(struct ExpandoNode **ptr);
+int  node_container_render(const struct ExpandoNode *node, const struct ExpandoRenderCallback *erc, struct Buffer *buf, int max_cols, void *data, MuttFormatFlags flags);
 
 #endif /* MUTT_EXPANDO_NODE_CONTAINER_H */
@@ -499,14 +499,20 @@ void add_color(struct Buffer *buf, enum ColorId cid)
 }
 
 /**
- * node_expando_render - Render an Expando Node - Implements ExpandoNode::render() - @ingroup expando_render
+ * node_expando_render_data - Render an Expando Node using its callbacks
+ * @param node       Node to render
+ * @param get_string Callback to get a string (preferred), may be NULL
+ * @param get_number Callback to get a number, may be NULL
+ * @param buf        Buffer in which to save string
+ * @param max_cols   Maximum number of screen columns to use
+ * @param data       Private data
+ * @param flags      Flags, see #MuttFormatFlags
+ * @retval num Number of screen columns used
  */
-int node_expando_render(const struct ExpandoNode *node,
-                        const struct ExpandoRenderCallback *erc, struct Buffer *buf,
-                        int max_cols, void *data, MuttFormatFlags flags)
+int node_expando_render_data(const struct ExpandoNode *node, get_string_t get_string,
+                             get_number_t get_number, struct Buffer *buf,
+                             int max_cols, void *data, MuttFormatFlags flags)
 {
-  ASSERT(node->type == ENT_EXPANDO);
-
   struct Buffer *buf_expando = buf_pool_get();
   struct Buffer *buf_format = buf_pool_get();
 
@@ -517,20 +523,18 @@ int node_expando_render(const struct ExpandoNode *node,
   // Numbers and strings get treated slightly differently. We prefer strings.
   // This allows dates to be stored as 1729850182, but displayed as "2024-10-25".
 
-  const struct ExpandoRenderCallback *erc_match = find_get_string(erc, node->did, node->uid);
-  if (erc_match)
+  if (get_string)
   {
-    erc_match->get_string(node, data, flags, buf_expando);
+    get_string(node, data, flags, buf_expando);
 
     if (fmt && fmt->lower)
       buf_lower_special(buf_expando);
   }
   else
   {
-    erc_match = find_get_number(erc, node->did, node->uid);
-    ASSERT(erc_match && "Unknown UID");
+    ASSERT(get_number && "Unknown UID");
 
-    const long num = erc_match->get_number(node, data, flags);
+    const long num = get_number(node, data, flags);
 
     int precision = 1;
 
@@ -580,3 +584,30 @@ int node_expando_render(const struct ExpandoNode *node,
 
   return total_cols;
 }
+
+/**
+ * node_expando_render - Render an Expando Node - Implements ExpandoNode::render() - @ingroup expando_render
+ */
+int node_expando_render(const struct ExpandoNode *node,
+                        const struct ExpandoRenderCallback *erc, struct Buffer *buf,
+                        int max_cols, void *data, MuttFormatFlags flags)
+{
+  ASSERT(node->type == ENT_EXPANDO);
+
+  get_string_t get_string = NULL;
+  get_number_t get_number = NULL;
+
+  const struct ExpandoRenderCallback *erc_match = find_get_string(erc, node->did, node->uid);
+  if (erc_match)
+  {
+    get_string = erc_match->get_string;
+  }
+  else
+  {
+    erc_match = find_get_number(erc, node->did, node->uid);
+    ASSERT(erc_match && "Unknown UID");
+    get_number = erc_match->get_number;
+  }
+
+  return node_expando_render_data(node, get_string, get_number, buf, max_cols, data, flags);
+}
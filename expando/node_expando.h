@@ -53,6 +53,7 @@ struct ExpandoNode *parse_short_name(const char *str, const struct ExpandoDefini
 struct ExpandoNode *node_expando_parse(const char *str, const struct ExpandoDefinition *defs, ExpandoParserFlags flags, const char **parsed_until, struct ExpandoParseError *err);
 struct ExpandoNode *node_expando_parse_name(const char *str, const struct ExpandoDefinition *defs, ExpandoParserFlags flags, const char **parsed_until, struct ExpandoParseError *err);
 int node_expando_render(const struct ExpandoNode *node, const struct ExpandoRenderCallback *erc, struct Buffer *buf, int max_cols, void *data, MuttFormatFlags flags);
+int node_expando_render_data(const struct ExpandoNode *node, get_string_t get_string, get_number_t get_number, struct Buffer *buf, int max_cols, void *data, MuttFormatFlags flags);
 
 struct ExpandoNode *node_expando_parse_enclosure(const char *str, int did, int uid, char terminator, struct ExpandoFormat *fmt, const char **parsed_until, struct ExpandoParseError *err);
 
@@ -26,6 +26,7 @@
 
 #include "definition.h"
 
+struct Buffer;
 struct ExpandoFormat;
 struct ExpandoNode;
 struct ExpandoParseError;
@@ -66,6 +67,8 @@ struct NodePaddingPrivate
   enum ExpandoPadType  pad_type;        ///< Padding type
 };
 
+int pad_string(const struct ExpandoNode *node, struct Buffer *buf, int max_cols);
+
 struct ExpandoNode *node_padding_parse(const char *str, struct ExpandoFormat *fmt, int did, int uid, ExpandoParserFlags flags, const char **parsed_until, struct ExpandoParseError *err);
 
 void node_padding_repad(struct ExpandoNode **parent);
@@ -0,0 +1,598 @@
+/**
+ * @file
+ * Compiled Expando
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page expando_program Compiled Expando
+ *
+ * A tree of ExpandoNodes, flattened into an array of Ops.
+ *
+ * Rendering the tree looks up every callback by Domain and UID, and renders
+ * every Container into a temporary Buffer, only to format it a second time.
+ *
+ * The Program does the lookups once, when it's bound to a set of callbacks.
+ * The width of plain ASCII text and padding is measured when it's compiled.
+ * A Container is only reformatted if its children overflowed, or if one of
+ * them may have produced text that formatting would alter.
+ *
+ * The output is identical to node_render().
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include "mutt/lib.h"
+#include "program.h"
+#include "format.h"
+#include "helpers.h"
+#include "node.h"
+#include "node_condbool.h"
+#include "node_condition.h"
+#include "node_container.h"
+#include "node_expando.h"
+#include "node_padding.h"
+#include "render.h"
+
+static int op_render(const struct ExpandoProgram *prog, int idx,
+                     const struct ExpandoRenderCallback *erc, struct Buffer *buf,
+                     int max_cols, void *data, MuttFormatFlags flags);
+
+/**
+ * text_cols - Measure some plain ASCII text
+ * @param text Text to measure
+ * @param len  Length of the text
+ * @retval num Number of screen columns
+ * @retval -1  Text contains other characters
+ *
+ * Printable ASCII characters are one column wide, whatever the locale.
+ */
+static int text_cols(const char *text, size_t len)
+{
+  for (size_t i = 0; i < len; i++)
+  {
+    if ((text[i] < ' ') || (text[i] > '~'))
+      return -1;
+  }
+
+  return len;
+}
+
+/**
+ * compile_node - Compile a Node and its children
+ * @param prog Program to add to
+ * @param node Node to compile, may be NULL
+ * @retval num Index of the new Op
+ */
+static int compile_node(struct ExpandoProgram *prog, const struct ExpandoNode *node)
+{
+  const int idx = ARRAY_SIZE(&prog->ops);
+
+  struct ExpandoOp op = { 0 };
+  op.node = node;
+  op.cols = -1;
+  ARRAY_ADD(&prog->ops, op);
+
+  // The children may move the array, so fill in the Op afterwards
+  enum ExpandoOpCode code = EOP_NODE;
+  bool exact = false;
+  bool exact_kids = true;
+  int len = 0;
+  int cols = -1;
+
+  if (!node || !node->render)
+  {
+    code = EOP_EMPTY;
+    exact = true;
+  }
+  else if (node->type == ENT_TEXT)
+  {
+    code = EOP_TEXT;
+    len = mutt_str_len(node->text);
+    cols = text_cols(node->text, len);
+    exact = true;
+  }
+  else if ((node->type == ENT_EXPANDO) && (node->render == node_expando_render) && node->ndata)
+  {
+    const struct NodeExpandoPrivate *priv = node->ndata;
+    code = EOP_EXPANDO;
+    // A colour of zero would embed a NUL in the output
+    exact = (priv->color != 0);
+  }
+  else if ((node->type == ENT_CONDBOOL) && (node->render == node_condbool_render))
+  {
+    code = EOP_CONDBOOL;
+  }
+  else if (node->type == ENT_CONDITION)
+  {
+    code = EOP_CONDITION;
+    compile_node(prog, node_get_child(node, ENC_CONDITION));
+    const int idx_true = compile_node(prog, node_get_child(node, ENC_TRUE));
+    const int idx_false = compile_node(prog, node_get_child(node, ENC_FALSE));
+
+    // With formatting, the output is always reformatted
+    exact = node->format || (ARRAY_GET(&prog->ops, idx_true)->exact &&
+                             ARRAY_GET(&prog->ops, idx_false)->exact);
+  }
+  else if ((node->type == ENT_CONTAINER) && (node->render == node_container_render))
+  {
+    code = EOP_CONTAINER;
+    struct ExpandoNode **np = NULL;
+    ARRAY_FOREACH(np, &node->children)
+    {
+      if (!*np)
+        continue;
+
+      const int idx_child = compile_node(prog, *np);
+      exact_kids &= ARRAY_GET(&prog->ops, idx_child)->exact;
+    }
+
+    // A Container normalises its output
+    exact = true;
+  }
+  else if ((node->type == ENT_PADDING) && node->ndata)
+  {
+    const struct NodePaddingPrivate *priv = node->ndata;
+    switch (priv->pad_type)
+    {
+      case EPT_FILL_EOL:
+        code = EOP_PAD_EOL;
+        break;
+      case EPT_HARD_FILL:
+        code = EOP_PAD_HARD;
+        break;
+      case EPT_SOFT_FILL:
+        code = EOP_PAD_SOFT;
+        break;
+    }
+
+    const int idx_left = compile_node(prog, node_get_child(node, ENP_LEFT));
+    const int idx_right = compile_node(prog, node_get_child(node, ENP_RIGHT));
+
+    len = mutt_str_len(node->text);
+    cols = text_cols(node->text, len);
+    exact = (cols > 0) && ARRAY_GET(&prog->ops, idx_left)->exact &&
+            ARRAY_GET(&prog->ops, idx_right)->exact;
+  }
+
+  struct ExpandoOp *op_new = ARRAY_GET(&prog->ops, idx);
+  op_new->code = code;
+  op_new->next = ARRAY_SIZE(&prog->ops);
+  op_new->len = len;
+  op_new->cols = cols;
+  op_new->exact = exact;
+  op_new->exact_kids = exact_kids;
+
+  return idx;
+}
+
+/**
+ * program_compile - Compile a tree of ExpandoNodes
+ * @param node Root of the tree
+ * @retval ptr New ExpandoProgram
+ *
+ * @note The Program refers to the Nodes, so it must be freed first
+ */
+struct ExpandoProgram *program_compile(const struct ExpandoNode *node)
+{
+  struct ExpandoProgram *prog = MUTT_MEM_CALLOC(1, struct ExpandoProgram);
+
+  compile_node(prog, node);
+
+  return prog;
+}
+
+/**
+ * program_free - Free an ExpandoProgram
+ * @param ptr Program to free
+ */
+void program_free(struct ExpandoProgram **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct ExpandoProgram *prog = *ptr;
+
+  ARRAY_FREE(&prog->ops);
+
+  FREE(ptr);
+}
+
+/**
+ * program_bind - Look up the callbacks for the Ops
+ * @param prog Program to bind
+ * @param erc  Expando Render Callback functions
+ * @retval true  Every Expando has a callback
+ * @retval false An Expando has no callback
+ */
+static bool program_bind(struct ExpandoProgram *prog, const struct ExpandoRenderCallback *erc)
+{
+  if (prog->erc == erc)
+    return true;
+
+  prog->erc = NULL;
+
+  struct ExpandoOp *op = NULL;
+  ARRAY_FOREACH(op, &prog->ops)
+  {
+    if ((op->code != EOP_EXPANDO) && (op->code != EOP_CONDBOOL))
+      continue;
+
+    const int did = op->node->did;
+    const int uid = op->node->uid;
+
+    const struct ExpandoRenderCallback *erc_str = find_get_string(erc, did, uid);
+    const struct ExpandoRenderCallback *erc_num = find_get_number(erc, did, uid);
+
+    op->get_string = erc_str ? erc_str->get_string : NULL;
+    op->get_number = erc_num ? erc_num->get_number : NULL;
+
+    if ((op->code == EOP_EXPANDO) && !op->get_string && !op->get_number)
+      return false;
+  }
+
+  prog->erc = erc;
+  return true;
+}
+
+/**
+ * condbool_value - Evaluate a CondBool Op
+ * @param op    Op to evaluate
+ * @param data  Private data
+ * @param flags Flags, see #MuttFormatFlags
+ * @retval 1 True
+ * @retval 0 False
+ *
+ * @sa node_condbool_render()
+ */
+static int condbool_value(const struct ExpandoOp *op, void *data, MuttFormatFlags flags)
+{
+  if (op->get_number)
+    return (op->get_number(op->node, data, flags) != 0); // bool-ify
+
+  if (op->get_string)
+  {
+    struct Buffer *buf_str = buf_pool_get();
+    op->get_string(op->node, data, flags, buf_str);
+    const size_t len = buf_len(buf_str);
+    buf_pool_release(&buf_str);
+
+    return (len > 0); // bool-ify
+  }
+
+  return 0;
+}
+
+/**
+ * pad_op - Pad a Buffer with a Padding Op's character
+ * @param op       Padding Op
+ * @param buf      Buffer to populate
+ * @param max_cols Number of screen columns available
+ * @retval num Number of screen columns used
+ *
+ * @sa pad_string()
+ */
+static int pad_op(const struct ExpandoOp *op, struct Buffer *buf, int max_cols)
+{
+  if (op->cols <= 0)
+    return pad_string(op->node, buf, max_cols);
+
+  int total_cols = 0;
+  for (; op->cols <= max_cols; max_cols -= op->cols, total_cols += op->cols)
+    buf_addstr_n(buf, op->node->text, op->len);
+
+  if (max_cols > 0)
+  {
+    buf_add_printf(buf, "%*s", max_cols, "");
+    total_cols += max_cols;
+  }
+
+  return total_cols;
+}
+
+/**
+ * render_children - Render the children of a Container Op
+ * @param prog     Program
+ * @param idx      Index of the Container Op
+ * @param erc      Expando Render Callback functions
+ * @param buf      Buffer for the result
+ * @param max_cols Maximum number of screen columns to use
+ * @param data     Private data
+ * @param flags    Flags, see #MuttFormatFlags
+ * @retval num Number of screen columns used
+ */
+static int render_children(const struct ExpandoProgram *prog, int idx,
+                           const struct ExpandoRenderCallback *erc, struct Buffer *buf,
+                           int max_cols, void *data, MuttFormatFlags flags)
+{
+  const int end = ARRAY_GET(&prog->ops, idx)->next;
+  int total_cols = 0;
+
+  for (int i = idx + 1; i < end; i = ARRAY_GET(&prog->ops, i)->next)
+  {
+    if (total_cols >= max_cols)
+      break;
+    total_cols += op_render(prog, i, erc, buf, max_cols - total_cols, data, flags);
+  }
+
+  return total_cols;
+}
+
+/**
+ * render_container - Render a Container Op
+ * @param prog     Program
+ * @param idx      Index of the Container Op
+ * @param erc      Expando Render Callback functions
+ * @param buf      Buffer for the result
+ * @param max_cols Maximum number of screen columns to use
+ * @param data     Private data
+ * @param flags    Flags, see #MuttFormatFlags
+ * @retval num Number of screen columns used
+ *
+ * @sa node_container_render()
+ */
+static int render_container(const struct ExpandoProgram *prog, int idx,
+                            const struct ExpandoRenderCallback *erc, struct Buffer *buf,
+                            int max_cols, void *data, MuttFormatFlags flags)
+{
+  const struct ExpandoOp *op = ARRAY_GET(&prog->ops, idx);
+  const struct ExpandoFormat *fmt = op->node->format;
+
+  if (!fmt)
+  {
+    // Render straight into the Buffer.  If it all fits, formatting it again
+    // wouldn't change anything.
+    const size_t start = buf_len(buf);
+    int total_cols = render_children(prog, idx, erc, buf, max_cols, data, flags);
+    if (op->exact_kids && (total_cols <= max_cols))
+      return total_cols;
+
+    struct Buffer *tmp = buf_pool_get();
+    buf_addstr_n(tmp, buf_string(buf) + start, buf_len(buf) - start);
+    buf_seek(buf, start);
+    if (buf->dptr)
+      buf->dptr[0] = '\0';
+
+    total_cols = format_string(buf, 0, max_cols, JUSTIFY_LEFT, ' ',
+                               buf_string(tmp), buf_len(tmp), true);
+    buf_pool_release(&tmp);
+    return total_cols;
+  }
+
+  if (fmt->max_cols != -1)
+    max_cols = MIN(max_cols, fmt->max_cols);
+
+  struct Buffer *tmp = buf_pool_get();
+  render_children(prog, idx, erc, tmp, max_cols, data, flags);
+
+  int max = max_cols;
+  if (fmt->max_cols >= 0)
+    max = MIN(max_cols, fmt->max_cols);
+  int min = MIN(fmt->min_cols, max);
+
+  struct Buffer *tmp2 = buf_pool_get();
+  int total_cols = format_string(tmp2, min, max, fmt->justification, ' ',
+                                 buf_string(tmp), buf_len(tmp), true);
+
+  if (fmt->lower)
+    buf_lower_special(tmp2);
+
+  buf_addstr(buf, buf_string(tmp2));
+  buf_pool_release(&tmp2);
+  buf_pool_release(&tmp);
+
+  return total_cols;
+}
+
+/**
+ * render_condition - Render a Condition Op
+ * @param prog     Program
+ * @param idx      Index of the Condition Op
+ * @param erc      Expando Render Callback functions
+ * @param buf      Buffer for the result
+ * @param max_cols Maximum number of screen columns to use
+ * @param data     Private data
+ * @param flags    Flags, see #MuttFormatFlags
+ * @retval num Number of screen columns used
+ *
+ * @sa node_condition_render()
+ */
+static int render_condition(const struct ExpandoProgram *prog, int idx,
+                            const struct ExpandoRenderCallback *erc, struct Buffer *buf,
+                            int max_cols, void *data, MuttFormatFlags flags)
+{
+  const struct ExpandoOp *op = ARRAY_GET(&prog->ops, idx);
+  const struct ExpandoOp *op_cond = ARRAY_GET(&prog->ops, idx + 1);
+  const int idx_true = op_cond->next;
+  const int idx_false = ARRAY_GET(&prog->ops, idx_true)->next;
+
+  // Discard any text returned, just use the return value as a bool
+  int rc_cond = 0;
+  if (op_cond->code == EOP_CONDBOOL)
+  {
+    rc_cond = condbool_value(op_cond, data, flags);
+  }
+  else
+  {
+    struct Buffer *buf_cond = buf_pool_get();
+    rc_cond = op_render(prog, idx + 1, erc, buf_cond, max_cols, data, flags);
+    buf_pool_release(&buf_cond);
+  }
+
+  const int idx_branch = (rc_cond == true) ? idx_true : idx_false;
+
+  const struct ExpandoFormat *fmt = op->node->format;
+  if (!fmt)
+    return op_render(prog, idx_branch, erc, buf, max_cols, data, flags);
+
+  struct Buffer *buf_branch = buf_pool_get();
+  op_render(prog, idx_branch, erc, buf_branch, max_cols, data, flags);
+
+  struct Buffer *tmp = buf_pool_get();
+
+  int min_cols = MAX(fmt->min_cols, fmt->max_cols);
+  min_cols = MIN(min_cols, max_cols);
+  if (fmt->max_cols >= 0)
+    max_cols = MIN(max_cols, fmt->max_cols);
+  int rc = format_string(tmp, min_cols, max_cols, fmt->justification, ' ',
+                         buf_string(buf_branch), buf_len(buf_branch), true);
+  if (fmt->lower)
+    buf_lower_special(tmp);
+
+  buf_addstr(buf, buf_string(tmp));
+  buf_pool_release(&tmp);
+  buf_pool_release(&buf_branch);
+
+  return rc;
+}
+
+/**
+ * render_padding - Render a Padding Op
+ * @param prog     Program
+ * @param idx      Index of the Padding Op
+ * @param erc      Expando Render Callback functions
+ * @param buf      Buffer for the result
+ * @param max_cols Maximum number of screen columns to use
+ * @param data     Private data
+ * @param flags    Flags, see #MuttFormatFlags
+ * @retval num Number of screen columns used
+ *
+ * @sa node_padding_render_eol(), node_padding_render_hard(), node_padding_render_soft()
+ */
+static int render_padding(const struct ExpandoProgram *prog, int idx,
+                          const struct ExpandoRenderCallback *erc, struct Buffer *buf,
+                          int max_cols, void *data, MuttFormatFlags flags)
+{
+  const struct ExpandoOp *op = ARRAY_GET(&prog->ops, idx);
+  const int idx_left = idx + 1;
+  const int idx_right = ARRAY_GET(&prog->ops, idx_left)->next;
+
+  if (op->code == EOP_PAD_EOL)
+  {
+    int total_cols = op_render(prog, idx_left, erc, buf, max_cols, data, flags);
+    total_cols += pad_op(op, buf, max_cols - total_cols);
+    return total_cols;
+  }
+
+  // The left-hand side goes straight into the Buffer, the right-hand side
+  // waits until the padding has been added.
+  struct Buffer *buf_right = buf_pool_get();
+  int cols_used = 0;
+
+  if (op->code == EOP_PAD_HARD)
+  {
+    cols_used += op_render(prog, idx_left, erc, buf, max_cols - cols_used, data, flags);
+    cols_used += op_render(prog, idx_right, erc, buf_right, max_cols - cols_used, data, flags);
+  }
+  else
+  {
+    cols_used += op_render(prog, idx_right, erc, buf_right, max_cols - cols_used, data, flags);
+    cols_used += op_render(prog, idx_left, erc, buf, max_cols - cols_used, data, flags);
+  }
+
+  if (max_cols > cols_used)
+    cols_used += pad_op(op, buf, max_cols - cols_used);
+
+  buf_addstr(buf, buf_string(buf_right));
+  buf_pool_release(&buf_right);
+
+  return cols_used;
+}
+
+/**
+ * op_render - Render an Op
+ * @param prog     Program
+ * @param idx      Index of the Op
+ * @param erc      Expando Render Callback functions
+ * @param buf      Buffer for the result
+ * @param max_cols Maximum number of screen columns to use
+ * @param data     Private data
+ * @param flags    Flags, see #MuttFormatFlags
+ * @retval num Number of screen columns used
+ */
+static int op_render(const struct ExpandoProgram *prog, int idx,
+                     const struct ExpandoRenderCallback *erc, struct Buffer *buf,
+                     int max_cols, void *data, MuttFormatFlags flags)
+{
+  const struct ExpandoOp *op = ARRAY_GET(&prog->ops, idx);
+
+  switch (op->code)
+  {
+    case EOP_EMPTY:
+      return 0;
+
+    case EOP_TEXT:
+      if ((op->cols >= 0) && (op->cols <= max_cols))
+      {
+        buf_addstr_n(buf, op->node->text, op->len);
+        return op->cols;
+      }
+      return format_string(buf, 0, max_cols, JUSTIFY_LEFT, ' ', op->node->text,
+                           op->len, false);
+
+    case EOP_EXPANDO:
+      return node_expando_render_data(op->node, op->get_string, op->get_number,
+                                      buf, max_cols, data, flags);
+
+    case EOP_CONDBOOL:
+      return condbool_value(op, data, flags);
+
+    case EOP_CONDITION:
+      return render_condition(prog, idx, erc, buf, max_cols, data, flags);
+
+    case EOP_CONTAINER:
+      return render_container(prog, idx, erc, buf, max_cols, data, flags);
+
+    case EOP_PAD_EOL:
+    case EOP_PAD_HARD:
+    case EOP_PAD_SOFT:
+      return render_padding(prog, idx, erc, buf, max_cols, data, flags);
+
+    case EOP_NODE:
+      break;
+  }
+
+  return op->node->render(op->node, erc, buf, max_cols, data, flags);
+}
+
+/**
+ * program_render - Render a compiled Expando into a string
+ * @param prog     Program to render
+ * @param erc      Expando Render Callback functions
+ * @param buf      Buffer for the result
+ * @param max_cols Maximum number of screen columns to use
+ * @param data     Private data
+ * @param flags    Flags to control behaviour
+ * @retval num Number of screen columns used
+ *
+ * The output is identical to node_render() on the original tree.
+ */
+int program_render(struct ExpandoProgram *prog, const struct ExpandoRenderCallback *erc,
+                   struct Buffer *buf, int max_cols, void *data, MuttFormatFlags flags)
+{
+  if (!prog || ARRAY_EMPTY(&prog->ops))
+    return 0;
+
+  // Without a complete set of callbacks, let the tree deal with it
+  if (!program_bind(prog, erc))
+    return node_render(ARRAY_GET(&prog->ops, 0)->node, erc, buf, max_cols, data, flags);
+
+  return op_render(prog, 0, erc, buf, max_cols, data, flags);
+}
@@ -0,0 +1,88 @@
+/**
+ * @file
+ * Compiled Expando
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_EXPANDO_PROGRAM_H
+#define MUTT_EXPANDO_PROGRAM_H
+
+#include <stdbool.h>
+#include "mutt/lib.h"
+#include "render.h"
+
+struct Buffer;
+struct ExpandoNode;
+
+/**
+ * enum ExpandoOpCode - Type of Expando Op
+ */
+enum ExpandoOpCode
+{
+  EOP_EMPTY = 0,      ///< Missing Node, renders nothing
+  EOP_TEXT,           ///< Plain text
+  EOP_EXPANDO,        ///< Expando, e.g. '%n'
+  EOP_CONDBOOL,       ///< True/False boolean condition
+  EOP_CONDITION,      ///< True/False condition
+  EOP_CONTAINER,      ///< Container for other Ops
+  EOP_PAD_EOL,        ///< Padding: fill to the end-of-line
+  EOP_PAD_HARD,       ///< Padding: hard-fill
+  EOP_PAD_SOFT,       ///< Padding: soft-fill
+  EOP_NODE,           ///< Anything else, call ExpandoNode::render()
+};
+
+/**
+ * struct ExpandoOp - One step of a compiled Expando
+ *
+ * The Ops are stored in depth-first order.
+ * The children of an Op follow it directly and end at ExpandoOp::next.
+ */
+struct ExpandoOp
+{
+  enum ExpandoOpCode        code;        ///< Type of Op, e.g. #EOP_TEXT
+  const struct ExpandoNode *node;        ///< Node the Op was compiled from
+  int                       next;        ///< Index of the Op after this one's children
+  int                       len;         ///< Length of the text (or padding)
+  int                       cols;        ///< Screen width of the text, -1 if it must be measured
+  bool                      exact;       ///< Output is clean and its width is exactly the return value
+  bool                      exact_kids;  ///< All the children are exact (Containers)
+  get_string_t              get_string;  ///< Bound callback, see program_bind()
+  get_number_t              get_number;  ///< Bound callback, see program_bind()
+};
+ARRAY_HEAD(ExpandoOpArray, struct ExpandoOp);
+
+/**
+ * struct ExpandoProgram - A compiled tree of ExpandoNodes
+ *
+ * The tree is flattened into an array of Ops.
+ * The callbacks are looked up once, when the Program is bound to a set of
+ * ExpandoRenderCallback.
+ */
+struct ExpandoProgram
+{
+  struct ExpandoOpArray               ops;  ///< Flattened tree of Ops
+  const struct ExpandoRenderCallback *erc;  ///< Callbacks bound to the Ops
+};
+
+struct ExpandoProgram *program_compile(const struct ExpandoNode *node);
+void                   program_free   (struct ExpandoProgram **ptr);
+
+int program_render(struct ExpandoProgram *prog, const struct ExpandoRenderCallback *erc, struct Buffer *buf, int max_cols, void *data, MuttFormatFlags flags);
+
+#endif /* MUTT_EXPANDO_PROGRAM_H */
@@ -335,6 +335,12 @@ void mutt_set_flag(struct Mailbox *m, struct Email *e, enum MessageType flag,
 
   if (update)
   {
+    /* A thread's summary line may depend on the flags of its other emails */
+    if (e->thread && (e->thread->parent || e->thread->child))
+      email_changed_all();
+    else
+      email_changed(e);
+
     email_set_color(m, e);
     struct EventMailbox ev_m = { m };
     notify_send(m->notify, NT_MAILBOX, NT_MAILBOX_CHANGE, &ev_m);
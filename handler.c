@@ -251,6 +251,18 @@ static void qp_decode_line(char *dest, char *src, size_t *l, int last)
 
   for (d = dest, s = src; *s;)
   {
+    /* copy any plain characters up to the next '=' in one go */
+    const char *eq = strchr(s, '=');
+    const size_t run = eq ? (size_t) (eq - s) : strlen(s);
+    if (run > 0)
+    {
+      memcpy(d, s, run);
+      d += run;
+      s += run;
+      kind = -1;
+      continue;
+    }
+
     switch ((kind = qp_decode_triple(s, &c)))
     {
       case 0:
@@ -1533,87 +1545,83 @@ static int malformed_pgp_encrypted_handler(struct Body *b_email, struct State *s
  */
 void mutt_decode_base64(struct State *state, size_t len, bool istext, iconv_t cd)
 {
-  char buf[5] = { 0 };
-  int ch, i;
+  char raw[4096];
+  char b64[sizeof(raw) + 4];
+  char dec[(sizeof(b64) / 4) * 3];
+  size_t nb64 = 0;
   bool cr = false;
+  bool done = false;
   char bufi[BUFI_SIZE] = { 0 };
   size_t l = 0;
 
-  buf[4] = '\0';
-
   if (istext)
     state_set_prefix(state);
 
-  while (len > 0)
+  while (!done && (len > 0))
   {
-    for (i = 0; (i < 4) && (len > 0); len--)
-    {
-      ch = fgetc(state->fp_in);
-      if (ch == EOF)
-        break;
-      if ((ch >= 0) && (ch < 128) && ((base64val(ch) != -1) || (ch == '=')))
-        buf[i++] = ch;
-    }
-    if (i != 4)
-    {
-      /* "i" may be zero if there is trailing whitespace, which is not an error */
-      if (i != 0)
-        mutt_debug(LL_DEBUG2, "didn't get a multiple of 4 chars\n");
-      break;
-    }
-
-    const int c1 = base64val(buf[0]);
-    const int c2 = base64val(buf[1]);
-
-    /* first char */
-    ch = (c1 << 2) | (c2 >> 4);
-
-    if (cr && (ch != '\n'))
-      bufi[l++] = '\r';
-
-    cr = false;
-
-    if (istext && (ch == '\r'))
-      cr = true;
-    else
-      bufi[l++] = ch;
-
-    /* second char */
-    if (buf[2] == '=')
+    const size_t nraw = fread(raw, 1, MIN(sizeof(raw), len), state->fp_in);
+    if (nraw == 0)
       break;
-    const int c3 = base64val(buf[2]);
-    ch = ((c2 & 0xf) << 4) | (c3 >> 2);
+    len -= nraw;
 
-    if (cr && (ch != '\n'))
-      bufi[l++] = '\r';
+    /* Keep just the base64 characters, after any left from the last block */
+    for (size_t i = 0; i < nraw; i++)
+    {
+      const int ch = (unsigned char) raw[i];
+      if ((ch < 128) && ((base64val(ch) != -1) || (ch == '=')))
+        b64[nb64++] = ch;
+    }
 
-    cr = false;
+    size_t used = 0;
+    size_t ndec = mutt_b64_decode_quads(b64, nb64, dec, sizeof(dec), &used);
 
-    if (istext && (ch == '\r'))
-      cr = true;
+    if ((nb64 - used) >= 4)
+    {
+      /* This group contains padding, which marks the end of the data */
+      const char *quad = b64 + used;
+      if ((quad[0] != '=') && (quad[1] != '='))
+      {
+        const int c1 = base64val(quad[0]);
+        const int c2 = base64val(quad[1]);
+        dec[ndec++] = (c1 << 2) | (c2 >> 4);
+        if (quad[2] != '=')
+        {
+          const int c3 = base64val(quad[2]);
+          dec[ndec++] = ((c2 & 0xf) << 4) | (c3 >> 2);
+        }
+      }
+      done = true;
+    }
     else
-      bufi[l++] = ch;
+    {
+      /* Save the incomplete group for the next block */
+      nb64 -= used;
+      memmove(b64, b64 + used, nb64);
+    }
 
-    /* third char */
-    if (buf[3] == '=')
-      break;
-    const int c4 = base64val(buf[3]);
-    ch = ((c3 & 0x3) << 6) | c4;
+    for (size_t i = 0; i < ndec; i++)
+    {
+      const char ch = dec[i];
 
-    if (cr && (ch != '\n'))
-      bufi[l++] = '\r';
+      if (cr && (ch != '\n'))
+        bufi[l++] = '\r';
 
-    cr = false;
+      cr = false;
 
-    if (istext && (ch == '\r'))
-      cr = true;
-    else
-      bufi[l++] = ch;
+      if (istext && (ch == '\r'))
+        cr = true;
+      else
+        bufi[l++] = ch;
 
-    if ((l + 8) >= sizeof(bufi))
-      convert_to_state(cd, bufi, &l, state);
+      if ((l + 8) >= sizeof(bufi))
+        convert_to_state(cd, bufi, &l, state);
+    }
   }
 
+  /* trailing whitespace leaves nothing behind, which is not an error */
+  if (!done && (nb64 != 0))
+    mutt_debug(LL_DEBUG2, "didn't get a multiple of 4 chars\n");
+
   if (cr)
     bufi[l++] = '\r';
 
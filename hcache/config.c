@@ -146,6 +146,9 @@ static struct ConfigDef HcacheVarsComp[] = {
   { "header_cache_compress_level", DT_NUMBER|D_INTEGER_NOT_NEGATIVE, 1, 0, compress_level_validator,
     "(hcache) Level of compression for method"
   },
+  { "header_cache_compress_dictionary", DT_BOOL, false, 0, NULL,
+    "(hcache) Train a compression dictionary for each header cache"
+  },
   { NULL },
   // clang-format on
 };
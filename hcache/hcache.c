@@ -62,6 +62,29 @@
 /// Header Cache version
 static unsigned int HcacheVer = 0x0;
 
+ARRAY_HEAD(HeaderCacheArray, struct HeaderCache *);
+/// Header Caches that are open, see hcache_open()
+static struct HeaderCacheArray OpenCaches = ARRAY_HEAD_INITIALIZER;
+
+/// Reserved key for the compression dictionary
+#define HC_DICT_KEY "@dictionary"
+/// Number of emails to sample, before training a compression dictionary
+#define HC_DICT_SAMPLES 1000
+/// Minimum number of samples worth training a dictionary from
+#define HC_DICT_MIN_SAMPLES 100
+
+/**
+ * struct DictSample - An Email stored while sampling for a compression dictionary
+ */
+struct DictSample
+{
+  char *key;     ///< Key of the Email
+  size_t keylen; ///< Length of the key
+  char *data;    ///< Serialised Email, uncompressed
+  int dlen;      ///< Length of the data
+};
+ARRAY_HEAD(DictSampleArray, struct DictSample);
+
 /**
  * struct RealKey - Hcache key name (including compression method)
  */
@@ -98,6 +121,27 @@ static struct RealKey *realkey(struct HeaderCache *hc, const char *key,
   return &rk;
 }
 
+/**
+ * dict_samples_free - Free the samples for a compression dictionary
+ * @param ptr Samples to free
+ */
+static void dict_samples_free(struct DictSampleArray **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct DictSampleArray *samples = *ptr;
+  struct DictSample *ds = NULL;
+  ARRAY_FOREACH(ds, samples)
+  {
+    FREE(&ds->key);
+    FREE(&ds->data);
+  }
+  ARRAY_FREE(samples);
+
+  FREE(ptr);
+}
+
 /**
  * hcache_free - Free a header cache
  * @param ptr header cache to free
@@ -109,6 +153,8 @@ static void hcache_free(struct HeaderCache **ptr)
 
   struct HeaderCache *hc = *ptr;
   FREE(&hc->folder);
+  FREE(&hc->path);
+  dict_samples_free(&hc->samples);
 
   FREE(ptr);
 }
@@ -122,6 +168,43 @@ static struct HeaderCache *hcache_new(void)
   return MUTT_MEM_CALLOC(1, struct HeaderCache);
 }
 
+/**
+ * hcache_find_open - Find a Header Cache that's already open
+ * @param path File of the Store
+ * @retval ptr  Open Header Cache
+ * @retval NULL The file isn't open
+ */
+static struct HeaderCache *hcache_find_open(const char *path)
+{
+  struct HeaderCache **hcp = NULL;
+  ARRAY_FOREACH(hcp, &OpenCaches)
+  {
+    if (mutt_str_equal((*hcp)->path, path))
+      return *hcp;
+  }
+  return NULL;
+}
+
+/**
+ * hcache_forget_open - Remove a Header Cache from the list of open ones
+ * @param hc Header Cache
+ */
+static void hcache_forget_open(struct HeaderCache *hc)
+{
+  struct HeaderCache **hcp = NULL;
+  ARRAY_FOREACH(hcp, &OpenCaches)
+  {
+    if (*hcp == hc)
+    {
+      ARRAY_REMOVE(&OpenCaches, hcp);
+      break;
+    }
+  }
+
+  if (ARRAY_EMPTY(&OpenCaches))
+    ARRAY_FREE(&OpenCaches);
+}
+
 /**
  * header_size - Compute the size of the header with uuid validity and crc
  * @retval num Size of the header
@@ -467,6 +550,205 @@ static unsigned int generate_hcachever(void)
   return digest.intval;
 }
 
+/**
+ * store_email_data - Compress and store a serialised Email
+ * @param hc     Header cache handle
+ * @param key    Message identification string
+ * @param keylen Length of the key
+ * @param data   Serialised Email, from dump_email()
+ * @param dlen   Length of the data
+ * @retval 0   Success
+ * @retval num Generic or backend-specific error code otherwise
+ */
+static int store_email_data(struct HeaderCache *hc, const char *key,
+                            size_t keylen, char *data, int dlen)
+{
+  char *whole = NULL;
+
+#ifdef USE_HCACHE_COMPRESSION
+  if (hc->compr_ops)
+  {
+    /* We don't compress uidvalidity and the crc, so we can check them before
+     * decompressing on fetch().  */
+    size_t hlen = header_size();
+
+    /* data / dlen gets ptr to compressed data here */
+    size_t clen = dlen;
+    void *cdata = hc->compr_ops->compress(hc->compr_handle, data + hlen, dlen - hlen, &clen);
+    if (!cdata)
+      return -1;
+
+    whole = MUTT_MEM_MALLOC(hlen + clen, char);
+    memcpy(whole, data, hlen);
+    memcpy(whole + hlen, cdata, clen);
+
+    data = whole;
+    dlen = hlen + clen;
+  }
+#endif
+
+  struct RealKey *rk = realkey(hc, key, keylen, true);
+  int rc = hc->store_ops->store(hc->store_handle, rk->key, rk->keylen, data, dlen);
+
+  FREE(&whole);
+
+  return rc;
+}
+
+#ifdef USE_HCACHE_COMPRESSION
+/**
+ * dict_init - Load, or prepare to train, a compression dictionary
+ * @param hc Header cache handle
+ *
+ * If the cache doesn't have a dictionary yet, the first Emails stored will
+ * be sampled to train one.
+ */
+static void dict_init(struct HeaderCache *hc)
+{
+  if (!hc->compr_ops || !hc->compr_ops->load_dict || !hc->compr_ops->train)
+    return;
+
+  const bool c_header_cache_compress_dictionary = cs_subset_bool(NeoMutt->sub, "header_cache_compress_dictionary");
+  if (!c_header_cache_compress_dictionary)
+    return;
+
+  size_t dlen = 0;
+  void *dict = hcache_fetch_raw_data(hc, HC_DICT_KEY, sizeof(HC_DICT_KEY) - 1, &dlen);
+  if (dict && hc->compr_ops->load_dict(hc->compr_handle, dict, dlen))
+  {
+    mutt_debug(LL_DEBUG3, "Header cache has a %zu byte dictionary\n", dlen);
+  }
+  else
+  {
+    hc->samples = MUTT_MEM_CALLOC(1, struct DictSampleArray);
+  }
+  FREE(&dict);
+}
+
+/**
+ * dict_sample_find - Find a sampled Email
+ * @param hc     Header cache handle
+ * @param key    Message identification string
+ * @param keylen Length of the key
+ * @retval ptr  Sample
+ * @retval NULL Not found
+ */
+static struct DictSample *dict_sample_find(struct HeaderCache *hc,
+                                           const char *key, size_t keylen)
+{
+  struct DictSample *ds = NULL;
+  ARRAY_FOREACH(ds, hc->samples)
+  {
+    if ((ds->keylen == keylen) && (memcmp(ds->key, key, keylen) == 0))
+      return ds;
+  }
+  return NULL;
+}
+
+/**
+ * dict_train - Train a compression dictionary from the sampled Emails
+ * @param hc Header cache handle
+ *
+ * The dictionary is saved in the cache and the sampled Emails are stored
+ * again, using it.  Training is only attempted once.
+ */
+static void dict_train(struct HeaderCache *hc)
+{
+  struct DictSampleArray *samples = hc->samples;
+  hc->samples = NULL;
+
+  const size_t num = ARRAY_SIZE(samples);
+  if (num < HC_DICT_MIN_SAMPLES)
+    goto done;
+
+  // Train on the compressed part of the data
+  const size_t hlen = header_size();
+  size_t total = 0;
+  struct DictSample *ds = NULL;
+  ARRAY_FOREACH(ds, samples)
+  {
+    total += ds->dlen - hlen;
+  }
+
+  char *all = MUTT_MEM_MALLOC(total, char);
+  size_t *sizes = MUTT_MEM_CALLOC(num, size_t);
+  size_t off = 0;
+  ARRAY_FOREACH(ds, samples)
+  {
+    sizes[ARRAY_FOREACH_IDX_ds] = ds->dlen - hlen;
+    memcpy(all + off, ds->data + hlen, ds->dlen - hlen);
+    off += ds->dlen - hlen;
+  }
+
+  size_t dlen = 0;
+  void *dict = hc->compr_ops->train(hc->compr_handle, all, sizes, num, &dlen);
+  FREE(&all);
+  FREE(&sizes);
+
+  if (!dict)
+    goto done;
+
+  mutt_debug(LL_DEBUG3, "Trained a %zu byte dictionary from %zu emails\n", dlen, num);
+  hcache_store_raw(hc, HC_DICT_KEY, sizeof(HC_DICT_KEY) - 1, dict, dlen);
+
+  ARRAY_FOREACH(ds, samples)
+  {
+    store_email_data(hc, ds->key, ds->keylen, ds->data, ds->dlen);
+  }
+
+done:
+  dict_samples_free(&samples);
+}
+
+/**
+ * dict_sample_add - Sample an Email for a compression dictionary
+ * @param hc     Header cache handle
+ * @param key    Message identification string
+ * @param keylen Length of the key
+ * @param data   Serialised Email, ownership is taken
+ * @param dlen   Length of the data
+ */
+static void dict_sample_add(struct HeaderCache *hc, const char *key,
+                            size_t keylen, char **data, int dlen)
+{
+  struct DictSample *ds = dict_sample_find(hc, key, keylen);
+  if (ds)
+  {
+    FREE(&ds->data);
+  }
+  else
+  {
+    struct DictSample sample = { mutt_strn_dup(key, keylen), keylen, NULL, 0 };
+    ARRAY_ADD(hc->samples, sample);
+    ds = ARRAY_LAST(hc->samples);
+  }
+
+  ds->data = *data;
+  ds->dlen = dlen;
+  *data = NULL;
+
+  if (ARRAY_SIZE(hc->samples) >= HC_DICT_SAMPLES)
+    dict_train(hc);
+}
+
+/**
+ * dict_sample_remove - Forget a sampled Email
+ * @param hc     Header cache handle
+ * @param key    Message identification string
+ * @param keylen Length of the key
+ */
+static void dict_sample_remove(struct HeaderCache *hc, const char *key, size_t keylen)
+{
+  struct DictSample *ds = dict_sample_find(hc, key, keylen);
+  if (!ds)
+    return;
+
+  FREE(&ds->key);
+  FREE(&ds->data);
+  ARRAY_REMOVE(hc->samples, ds);
+}
+#endif
+
 /**
  * hcache_open - Multiplexor for StoreOps::open
  */
@@ -515,6 +797,19 @@ struct HeaderCache *hcache_open(const char *path, const char *folder,
   struct Buffer *hcpath = buf_pool_get();
   hcache_per_folder(hc, hcpath, path, namer);
 
+  /* Some Stores, e.g. LMDB and GDBM, can't be opened twice by one process.
+   * If a backend and the search index both want the file, share the handle. */
+  struct HeaderCache *hc_open = hcache_find_open(buf_string(hcpath));
+  if (hc_open)
+  {
+    if (hc->compr_ops)
+      hc->compr_ops->close(&hc->compr_handle);
+    hcache_free(&hc);
+    buf_pool_release(&hcpath);
+    hc_open->refs++;
+    return hc_open;
+  }
+
   hc->store_handle = hc->store_ops->open(buf_string(hcpath), create);
   if (!hc->store_handle)
   {
@@ -533,6 +828,15 @@ struct HeaderCache *hcache_open(const char *path, const char *folder,
     }
     hcache_free(&hc);
   }
+  else
+  {
+#ifdef USE_HCACHE_COMPRESSION
+    dict_init(hc);
+#endif
+    hc->path = buf_strdup(hcpath);
+    hc->refs = 1;
+    ARRAY_ADD(&OpenCaches, hc);
+  }
 
   buf_pool_release(&hcpath);
   return hc;
@@ -547,6 +851,19 @@ void hcache_close(struct HeaderCache **ptr)
     return;
 
   struct HeaderCache *hc = *ptr;
+  if (--hc->refs > 0)
+  {
+    *ptr = NULL;
+    return;
+  }
+  hcache_forget_open(hc);
+
+#ifdef USE_HCACHE_COMPRESSION
+  if (hc->samples)
+    dict_train(hc);
+#endif
+
+  hcache_commit_batch(hc);
 
 #ifdef USE_HCACHE_COMPRESSION
   if (hc->compr_ops)
@@ -558,6 +875,37 @@ void hcache_close(struct HeaderCache **ptr)
   hcache_free(ptr);
 }
 
+/**
+ * hcache_begin_batch - Multiplexor for StoreOps::begin
+ */
+int hcache_begin_batch(struct HeaderCache *hc)
+{
+  if (!hc)
+    return -1;
+  if (hc->in_batch)
+    return 0;
+
+  int rc = hc->store_ops->begin(hc->store_handle);
+  if (rc == 0)
+    hc->in_batch = true;
+
+  return rc;
+}
+
+/**
+ * hcache_commit_batch - Multiplexor for StoreOps::commit
+ */
+int hcache_commit_batch(struct HeaderCache *hc)
+{
+  if (!hc)
+    return -1;
+  if (!hc->in_batch)
+    return 0;
+
+  hc->in_batch = false;
+  return hc->store_ops->commit(hc->store_handle);
+}
+
 /**
  * hcache_fetch_email - Multiplexor for StoreOps::fetch
  */
@@ -666,6 +1014,35 @@ char *hcache_fetch_raw_str(struct HeaderCache *hc, const char *key, size_t keyle
   return res;
 }
 
+/**
+ * hcache_fetch_raw_data - Fetch a block of data from the cache
+ * @param[in]  hc     Pointer to the struct HeaderCache structure got by hcache_open()
+ * @param[in]  key    Message identification string
+ * @param[in]  keylen Length of the string pointed to by key
+ * @param[out] dlen   Length of the data
+ * @retval ptr  Success, the data if found (the caller must free it)
+ * @retval NULL Otherwise
+ */
+void *hcache_fetch_raw_data(struct HeaderCache *hc, const char *key, size_t keylen, size_t *dlen)
+{
+  if (!hc || !dlen)
+    return NULL;
+
+  char *res = NULL;
+  size_t srclen = 0;
+
+  struct RealKey *rk = realkey(hc, key, keylen, false);
+  void *src = hc->store_ops->fetch(hc->store_handle, rk->key, rk->keylen, &srclen);
+  if (src)
+  {
+    res = MUTT_MEM_MALLOC(MAX(srclen, 1), char);
+    memcpy(res, src, srclen);
+    *dlen = srclen;
+    free_raw(hc, &src);
+  }
+  return res;
+}
+
 /**
  * hcache_store_email - Multiplexor for StoreOps::store
  */
@@ -678,36 +1055,13 @@ int hcache_store_email(struct HeaderCache *hc, const char *key, size_t keylen,
   int dlen = 0;
   char *data = dump_email(hc, e, &dlen, uidvalidity);
 
-#ifdef USE_HCACHE_COMPRESSION
-  if (hc->compr_ops)
-  {
-    /* We don't compress uidvalidity and the crc, so we can check them before
-     * decompressing on fetch().  */
-    size_t hlen = header_size();
-
-    /* data / dlen gets ptr to compressed data here */
-    size_t clen = dlen;
-    void *cdata = hc->compr_ops->compress(hc->compr_handle, data + hlen, dlen - hlen, &clen);
-    if (!cdata)
-    {
-      FREE(&data);
-      return -1;
-    }
+  int rc = store_email_data(hc, key, keylen, data, dlen);
 
-    char *whole = MUTT_MEM_MALLOC(hlen + clen, char);
-    memcpy(whole, data, hlen);
-    memcpy(whole + hlen, cdata, clen);
-
-    FREE(&data);
-
-    data = whole;
-    dlen = hlen + clen;
-  }
+#ifdef USE_HCACHE_COMPRESSION
+  if ((rc == 0) && hc->samples)
+    dict_sample_add(hc, key, keylen, &data, dlen);
 #endif
 
-  struct RealKey *rk = realkey(hc, key, keylen, true);
-  int rc = hc->store_ops->store(hc->store_handle, rk->key, rk->keylen, data, dlen);
-
   FREE(&data);
 
   return rc;
@@ -743,6 +1097,11 @@ int hcache_delete_email(struct HeaderCache *hc, const char *key, size_t keylen)
   if (!hc)
     return -1;
 
+#ifdef USE_HCACHE_COMPRESSION
+  if (hc->samples)
+    dict_sample_remove(hc, key, keylen);
+#endif
+
   struct RealKey *rk = realkey(hc, key, keylen, true);
 
   return hc->store_ops->delete_record(hc->store_handle, rk->key, rk->keylen);
@@ -74,6 +74,7 @@
 #include "store/lib.h"
 
 struct Buffer;
+struct DictSampleArray;
 struct Email;
 
 /**
@@ -85,11 +86,15 @@ struct Email;
 struct HeaderCache
 {
   char *folder;                       ///< Folder name
+  char *path;                         ///< File of the Store
+  int refs;                           ///< Number of users, see hcache_open()
   unsigned int crc;                   ///< CRC of the cache entry
   const struct StoreOps *store_ops;   ///< Store backend
   StoreHandle *store_handle;          ///< Store handle
   const struct ComprOps *compr_ops;   ///< Compression backend
   ComprHandle *compr_handle;          ///< Compression handle
+  bool in_batch;                      ///< A batch of changes has been started
+  struct DictSampleArray *samples;    ///< Emails to train a compression dictionary
 };
 
 /**
@@ -121,6 +126,9 @@ typedef void (*hcache_namer_t)(const char *path, struct Buffer *dest);
  * @param create Create the file if it's not there?
  * @retval ptr  Success, struct HeaderCache struct
  * @retval NULL Otherwise
+ *
+ * If the file is already open, e.g. by the search index, the same handle is
+ * returned.  Each call must be matched by a call to hcache_close().
  */
 struct HeaderCache *hcache_open(const char *path, const char *folder, hcache_namer_t namer, bool create);
 
@@ -128,10 +136,32 @@ struct HeaderCache *hcache_open(const char *path, const char *folder, hcache_nam
  * hcache_close - Close the connection to the header cache
  * @param ptr Pointer to the struct HeaderCache structure got by hcache_open()
  *
+ * The file is only closed, and any batch of changes written, when the last
+ * user of a shared handle closes it.
+ *
  * @note The pointer will be set to NULL
  */
 void hcache_close(struct HeaderCache **ptr);
 
+/**
+ * hcache_begin_batch - Start a batch of changes
+ * @param hc Pointer to the struct HeaderCache structure got by hcache_open()
+ * @retval 0   Success
+ * @retval num Generic or backend-specific error code otherwise
+ *
+ * Use this before storing many emails.  The Store may write the changes in one
+ * go, when hcache_commit_batch() or hcache_close() is called.
+ */
+int hcache_begin_batch(struct HeaderCache *hc);
+
+/**
+ * hcache_commit_batch - Write a batch of changes
+ * @param hc Pointer to the struct HeaderCache structure got by hcache_open()
+ * @retval 0   Success
+ * @retval num Generic or backend-specific error code otherwise
+ */
+int hcache_commit_batch(struct HeaderCache *hc);
+
 /**
  * hcache_store_email - Store a Header along with a validity datum
  * @param hc          Pointer to the struct HeaderCache structure got by hcache_open()
@@ -157,6 +187,7 @@ int hcache_store_email(struct HeaderCache *hc, const char *key, size_t keylen, s
  */
 struct HCacheEntry hcache_fetch_email(struct HeaderCache *hc, const char *key, size_t keylen, uint32_t uidvalidity);
 
+void *hcache_fetch_raw_data(struct HeaderCache *hc, const char *key, size_t keylen, size_t *dlen);
 char *hcache_fetch_raw_str(struct HeaderCache *hc, const char *key, size_t keylen);
 bool  hcache_fetch_raw_obj_full(struct HeaderCache *hc, const char *key, size_t keylen, void *dst, size_t dstlen);
 #define hcache_fetch_raw_obj(hc, key, keylen, dst) hcache_fetch_raw_obj_full(hc, key, keylen, dst, sizeof(*dst))
@@ -258,6 +258,66 @@ unsigned char *serial_dump_address(const struct AddressList *al,
   return d;
 }
 
+/**
+ * restore_buffer_string - Unpack the string of a Buffer from a binary blob
+ * @param[in]     d       Binary blob to read from
+ * @param[in,out] off     Offset into the blob
+ * @param[in]     convert If true, the strings will be converted from utf-8
+ * @param[out]    conv    Converted copy of the string, caller must free
+ * @retval ptr  String, either in the blob, or in conv
+ * @retval NULL The string is empty, or isn't terminated within its size
+ *
+ * Most strings are ASCII, so can be used directly from the blob.  A corrupt
+ * entry might not have a NUL, so the string is never read past its size.
+ */
+static const char *restore_buffer_string(const unsigned char *d, int *off,
+                                         bool convert, char **conv)
+{
+  unsigned int size = 0;
+  serial_restore_int(&size, d, off);
+  if (size == 0)
+    return NULL;
+
+  const char *str = (const char *) d + *off;
+  *off += size;
+
+  if (strnlen(str, size) == size)
+    return NULL;
+
+  if (!convert || mutt_str_is_ascii(str, size))
+    return str;
+
+  *conv = mutt_strn_dup(str, size);
+  mutt_ch_convert_string(conv, "utf-8", cc_charset(), MUTT_ICONV_NO_FLAGS);
+  return *conv;
+}
+
+/**
+ * restore_buffer_new - Unpack an optional Buffer from a binary blob
+ * @param[in]     d       Binary blob to read from
+ * @param[in,out] off     Offset into the blob
+ * @param[in]     convert If true, the strings will be converted from utf-8
+ * @retval ptr  New Buffer
+ * @retval NULL The stored Buffer was empty
+ */
+static struct Buffer *restore_buffer_new(const unsigned char *d, int *off, bool convert)
+{
+  unsigned int used = 0;
+  serial_restore_int(&used, d, off);
+  if (used == 0)
+    return NULL;
+
+  char *conv = NULL;
+  const char *str = restore_buffer_string(d, off, convert, &conv);
+
+  struct Buffer *buf = NULL;
+  if (str && (str[0] != '\0'))
+    buf = buf_new(str);
+
+  FREE(&conv);
+  return buf;
+}
+
 /**
  * serial_restore_address - Unpack an Address from a binary blob
  * @param[out]    al      Store the unpacked AddressList here
@@ -277,19 +337,8 @@ void serial_restore_address(struct AddressList *al, const unsigned char *d,
   {
     struct Address *a = mutt_addr_new();
 
-    a->personal = buf_new(NULL);
-    serial_restore_buffer(a->personal, d, off, convert);
-    if (buf_is_empty(a->personal))
-    {
-      buf_free(&a->personal);
-    }
-
-    a->mailbox = buf_new(NULL);
-    serial_restore_buffer(a->mailbox, d, off, false);
-    if (buf_is_empty(a->mailbox))
-    {
-      buf_free(&a->mailbox);
-    }
+    a->personal = restore_buffer_new(d, off, convert);
+    a->mailbox = restore_buffer_new(d, off, false);
 
     serial_restore_int(&g, d, off);
     a->group = !!g;
@@ -381,18 +430,14 @@ unsigned char *serial_dump_buffer(const struct Buffer *buf, unsigned char *d,
  */
 void serial_restore_buffer(struct Buffer *buf, const unsigned char *d, int *off, bool convert)
 {
-  buf_alloc(buf, 1);
-
   unsigned int used = 0;
   serial_restore_int(&used, d, off);
   if (used == 0)
     return;
 
-  char *str = NULL;
-  serial_restore_char(&str, d, off, convert);
-
-  buf_addstr(buf, str);
-  FREE(&str);
+  char *conv = NULL;
+  buf_addstr(buf, restore_buffer_string(d, off, convert, &conv));
+  FREE(&conv);
 }
 
 /**
@@ -648,9 +693,12 @@ void serial_restore_envelope(struct Envelope *env, const unsigned char *d, int *
   serial_restore_char(&env->list_subscribe, d, off, convert);
   serial_restore_char(&env->list_unsubscribe, d, off, convert);
 
-  const bool c_auto_subscribe = cs_subset_bool(NeoMutt->sub, "auto_subscribe");
-  if (c_auto_subscribe)
-    mutt_auto_subscribe(env->list_post);
+  if (env->list_post)
+  {
+    static struct CachedConfig cc_auto_subscribe = CACHED_CONFIG("auto_subscribe");
+    if (cc_bool(&cc_auto_subscribe))
+      mutt_auto_subscribe(env->list_post);
+  }
 
   serial_restore_char((char **) &env->subject, d, off, convert);
   serial_restore_int((unsigned int *) (&real_subj_off), d, off);
@@ -252,7 +252,7 @@ enum CommandResult parse_hook_pattern(const struct Command *cmd,
     comp_flags = MUTT_PC_FULL_MSG;
 
   struct MailboxView *mv_cur = get_current_mailbox_view();
-  pat = mutt_pattern_comp(mv_cur, buf_string(pattern), comp_flags, err);
+  pat = mutt_pattern_comp(mv_cur, buf_string(pattern), comp_flags | MUTT_PC_RULE, err);
   if (!pat)
     goto cleanup;
 
@@ -316,7 +316,7 @@ enum CommandResult add_mailbox_hook(enum CommandId id, struct Buffer *mailbox,
     comp_flags = MUTT_PC_FULL_MSG;
 
   struct MailboxView *mv_cur = get_current_mailbox_view();
-  pat = mutt_pattern_comp(mv_cur, buf_string(pattern), comp_flags, err);
+  pat = mutt_pattern_comp(mv_cur, buf_string(pattern), comp_flags | MUTT_PC_RULE, err);
   if (!pat)
     return MUTT_CMD_ERROR;
 
@@ -1120,7 +1120,7 @@ enum CommandResult parse_hook_index(const struct Command *cmd,
    * the hook compilation time.  */
   struct MailboxView *mv_cur = get_current_mailbox_view();
   struct PatternList *pat = mutt_pattern_comp(mv_cur, buf_string(pattern),
-                                              MUTT_PC_FULL_MSG | MUTT_PC_PATTERN_DYNAMIC,
+                                              MUTT_PC_FULL_MSG | MUTT_PC_PATTERN_DYNAMIC | MUTT_PC_RULE,
                                               err);
   if (!pat)
     goto out;
@@ -697,7 +697,7 @@ void imap_logout_all(void)
  * @retval  0 Success
  * @retval -1 Failure
  *
- * Not explicitly buffered, relies on FILE buffering.
+ * The data is copied out of the Connection's read buffer a block at a time.
  *
  * @note Strips `\r` from `\r\n`.
  *       Apparently even literals use `\r\n`-terminated strings ?!
@@ -705,7 +705,7 @@ void imap_logout_all(void)
 int imap_read_literal(FILE *fp, struct ImapAccountData *adata,
                       unsigned long bytes, struct Progress *progress)
 {
-  char c;
+  char chunk[8192];
   bool r = false;
   struct Buffer buf = { 0 }; // Do not allocate, maybe it won't be used
 
@@ -715,9 +715,12 @@ int imap_read_literal(FILE *fp, struct ImapAccountData *adata,
 
   mutt_debug(LL_DEBUG2, "reading %lu bytes\n", bytes);
 
-  for (unsigned long pos = 0; pos < bytes; pos++)
+  unsigned long pos = 0;
+  while (pos < bytes)
   {
-    if (mutt_socket_readchar(adata->conn, &c) != 1)
+    const int n = mutt_socket_readbytes(adata->conn, chunk,
+                                        MIN(sizeof(chunk), bytes - pos));
+    if (n <= 0)
     {
       mutt_debug(LL_DEBUG1, "error during read, %lu bytes read\n", pos);
       adata->status = IMAP_FATAL;
@@ -726,25 +729,35 @@ int imap_read_literal(FILE *fp, struct ImapAccountData *adata,
       return -1;
     }
 
-    if (r && (c != '\n'))
+    if (c_debug_level >= IMAP_LOG_LTRL)
+      buf_addstr_n(&buf, chunk, n);
+
+    /* Write the data out in runs, dropping any \r that precedes a \n */
+    const char *p = chunk;
+    const char *end = chunk + n;
+    if (r && (*p != '\n'))
       fputc('\r', fp);
+    r = false;
 
-    if (c == '\r')
-    {
-      r = true;
-      continue;
-    }
-    else
+    while (p < end)
     {
-      r = false;
-    }
+      const char *cr = memchr(p, '\r', end - p);
+      if (!cr)
+      {
+        fwrite(p, 1, end - p, fp);
+        break;
+      }
 
-    fputc(c, fp);
+      fwrite(p, 1, cr - p, fp);
+      p = cr + 1;
+      if (p == end)
+        r = true; // Decide when we see the next byte
+      else if (*p != '\n')
+        fputc('\r', fp);
+    }
 
-    if ((pos % 1024) == 0)
-      progress_update(progress, pos, -1);
-    if (c_debug_level >= IMAP_LOG_LTRL)
-      buf_addch(&buf, c);
+    pos += n;
+    progress_update(progress, pos, -1);
   }
 
   if (c_debug_level >= IMAP_LOG_LTRL)
@@ -2462,7 +2475,7 @@ static int imap_tags_commit(struct Mailbox *m, struct Email *e, const char *buf)
 
   /* We are good sync them */
   mutt_debug(LL_DEBUG1, "NEW TAGS: %s\n", buf);
-  driver_tags_replace(&e->tags, buf);
+  email_tags_replace(e, buf);
   FREE(&imap_edata_get(e)->flags_remote);
   struct Buffer *flags_remote = buf_pool_get();
   driver_tags_get_with_hidden(&e->tags, flags_remote);
@@ -2551,6 +2564,7 @@ const struct MxOps MxImapOps = {
   .msg_commit       = imap_msg_commit,
   .msg_close        = imap_msg_close,
   .msg_padding_size = NULL,
+  .msg_prefetch     = NULL,
   .msg_save_hcache  = imap_msg_save_hcache,
   .tags_edit        = imap_tags_edit,
   .tags_commit      = imap_tags_commit,
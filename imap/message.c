@@ -796,7 +796,7 @@ static int read_headers_normal_eval_cache(struct ImapAccountData *adata,
 
         /* We take a copy of the tags so we can split the string */
         char *tags_copy = mutt_str_dup(h.edata->flags_remote);
-        driver_tags_replace(&e->tags, tags_copy);
+        email_tags_replace(e, tags_copy);
         FREE(&tags_copy);
 
         m->msg_count++;
@@ -1112,6 +1112,10 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
   char *hdrreq = NULL;
   struct Buffer *tempfile = NULL;
   FILE *fp = NULL;
+#ifdef USE_FMEMOPEN
+  char *hdr_data = NULL;
+  size_t hdr_size = 0;
+#endif
   struct ImapHeader h = { 0 };
   struct Buffer *buf = NULL;
   static const char *const want_headers = "DATE FROM SENDER SUBJECT TO CC MESSAGE-ID REFERENCES "
@@ -1161,6 +1165,15 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
 
   /* instead of downloading all headers and then parsing them, we parse them
    * as they come in. */
+#ifdef USE_FMEMOPEN
+  /* Keep the headers in memory, rather than bouncing them off a file */
+  fp = open_memstream(&hdr_data, &hdr_size);
+  if (!fp)
+  {
+    mutt_perror(_("Error opening 'memory stream'"));
+    goto bail;
+  }
+#else
   tempfile = buf_pool_get();
   buf_mktemp(tempfile);
   fp = mutt_file_fopen(buf_string(tempfile), "w+");
@@ -1171,6 +1184,7 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
   }
   unlink(buf_string(tempfile));
   buf_pool_release(&tempfile);
+#endif
 
   if (m->verbose)
   {
@@ -1187,20 +1201,38 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
    *
    *   I believe the new chunking imap_fetch_msn_seqset()
    *   implementation and "msn_begin = fetch_msn_end + 1" assignment
-   *   at the end of the loop makes the comparison unneeded, but to be
+   *   after each command is sent makes the comparison unneeded, but to be
    *   cautious I'm keeping it.
    */
+
+  /* Keep several FETCH commands in flight, so the link isn't idle while each
+   * chunk completes.  The command queue was sized from $imap_pipeline_depth
+   * when the connection was opened; staying one below its capacity means
+   * queuing our commands never forces it to drain. */
+  const int max_in_flight = MAX(adata->cmdslots - 2, 1);
+  int in_flight = 0;
+  int msgno = msn_begin;
+
   edata = imap_edata_new();
-  while ((fetch_msn_end < msn_end) &&
-         imap_fetch_msn_seqset(buf, adata, evalhc, msn_begin, msn_end, &fetch_msn_end))
+  while (true)
   {
-    char *cmd = NULL;
-    mutt_str_asprintf(&cmd, "FETCH %s (UID FLAGS INTERNALDATE RFC822.SIZE %s)",
-                      buf_string(buf), hdrreq);
-    imap_cmd_start(adata, cmd);
-    FREE(&cmd);
+    while ((in_flight < max_in_flight) && (fetch_msn_end < msn_end) &&
+           imap_fetch_msn_seqset(buf, adata, evalhc, msn_begin, msn_end, &fetch_msn_end))
+    {
+      char *cmd = NULL;
+      mutt_str_asprintf(&cmd, "FETCH %s (UID FLAGS INTERNALDATE RFC822.SIZE %s)",
+                        buf_string(buf), hdrreq);
+      const int rc_start = imap_cmd_start(adata, cmd);
+      FREE(&cmd);
+      if (rc_start < 0)
+        goto bail;
 
-    int msgno = msn_begin;
+      in_flight++;
+      msn_begin = fetch_msn_end + 1;
+    }
+
+    if (in_flight == 0)
+      break;
 
     while (true)
     {
@@ -1220,6 +1252,17 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
         {
           goto bail;
         }
+        /* all the outstanding commands have completed */
+        in_flight = 0;
+        break;
+      }
+
+      /* a tagged response while others are still running */
+      if (adata->buf[0] != '*')
+      {
+        if (!imap_code(adata->buf))
+          goto bail;
+        in_flight--;
         break;
       }
 
@@ -1284,16 +1327,28 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
 
       /* We take a copy of the tags so we can split the string */
       char *tags_copy = mutt_str_dup(h.edata->flags_remote);
-      driver_tags_replace(&e->tags, tags_copy);
+      email_tags_replace(e, tags_copy);
       FREE(&tags_copy);
 
       if (*maxuid < h.edata->uid)
         *maxuid = h.edata->uid;
 
-      rewind(fp);
       /* NOTE: if Date: header is missing, mutt_rfc822_read_header depends
        *   on h.received being set */
+#ifdef USE_FMEMOPEN
+      fflush(fp);
+      FILE *fp_hdr = fmemopen(hdr_data, hdr_size, "r");
+      if (!fp_hdr)
+      {
+        mutt_perror(_("Error re-opening 'memory stream'"));
+        goto bail;
+      }
+      e->env = mutt_rfc822_read_header(fp_hdr, e, false, false);
+      mutt_file_fclose(&fp_hdr);
+#else
+      rewind(fp);
       e->env = mutt_rfc822_read_header(fp, e, false, false);
+#endif
       /* body built as a side-effect of mutt_rfc822_read_header */
       e->body->length = h.content_length;
       mailbox_size_add(m, e);
@@ -1321,8 +1376,8 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
      *   msn_begin = mdata->max_msn + 1;
      * but with chunking and header cache holes this
      * may not be correct.  So here we must assume the msn values have
-     * not been altered during or after the fetch.  */
-    msn_begin = fetch_msn_end + 1;
+     * not been altered during or after the fetch, and carry on from
+     * fetch_msn_end + 1.  */
   }
 
   rc = 0;
@@ -1332,6 +1387,9 @@ bail:
   buf_pool_release(&buf);
   buf_pool_release(&tempfile);
   mutt_file_fclose(&fp);
+#ifdef USE_FMEMOPEN
+  FREE(&hdr_data);
+#endif
   FREE(&hdrreq);
   imap_edata_free((void **) &edata);
   progress_free(&progress);
@@ -1390,6 +1448,7 @@ retry:
 
 #ifdef USE_HCACHE
   imap_hcache_open(adata, mdata, true);
+  hcache_begin_batch(mdata->hcache);
 
   if (mdata->hcache && initial_download)
   {
@@ -1958,7 +2017,7 @@ char *imap_set_flags(struct Mailbox *m, struct Email *e, char *s, bool *server_c
   /* Update tags system */
   /* We take a copy of the tags so we can split the string */
   char *tags_copy = mutt_str_dup(edata->flags_remote);
-  driver_tags_replace(&e->tags, tags_copy);
+  email_tags_replace(e, tags_copy);
   FREE(&tags_copy);
 
   /* YAUH (yet another ugly hack): temporarily set context to
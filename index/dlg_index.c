@@ -820,6 +820,9 @@ int mutt_make_string(struct Buffer *buf, size_t max_cols,
 /**
  * index_make_entry - Format an Email for the Menu - Implements Menu::make_entry() - @ingroup menu_make_entry
  *
+ * The formatted line is cached in the Email.  It's reused until the Email, or
+ * anything shared by all the Emails, changes.  See email_changed().
+ *
  * @sa $index_format
  */
 int index_make_entry(struct Menu *menu, int line, int max_cols, struct Buffer *buf)
@@ -917,7 +920,36 @@ int index_make_entry(struct Menu *menu, int line, int max_cols, struct Buffer *b
       max_cols -= (mutt_strwidth(c_arrow_string) + 1);
   }
 
-  return mutt_make_string(buf, max_cols, c_index_format, m, msg_in_pager, e, flags, NULL);
+  /* Reuse the Email's last line, if nothing has changed */
+  const bool in_pager = (msg_in_pager == e->msgno);
+  const time_t minute = mutt_date_now() / 60;
+  struct EmailLine *el = e->line;
+  if (el && (el->gen == e->gen) && (el->gen_all == email_generation()) &&
+      (el->max_cols == max_cols) && (el->flags == flags) &&
+      (el->in_pager == in_pager) && (el->minute == minute))
+  {
+    buf_strcpy(buf, el->text);
+    return el->cols;
+  }
+
+  const int cols = mutt_make_string(buf, max_cols, c_index_format, m,
+                                    msg_in_pager, e, flags, NULL);
+
+  if (!el)
+  {
+    el = MUTT_MEM_CALLOC(1, struct EmailLine);
+    e->line = el;
+  }
+  mutt_str_replace(&el->text, buf_string(buf));
+  el->cols = cols;
+  el->gen = e->gen;
+  el->gen_all = email_generation();
+  el->max_cols = max_cols;
+  el->flags = flags;
+  el->in_pager = in_pager;
+  el->minute = minute;
+
+  return cols;
 }
 
 /**
@@ -62,6 +62,14 @@
 #include "notmuch/lib.h"
 #endif
 
+/// Config variables read for every line of the Index
+static struct CachedConfig CcCryptChars = CACHED_CONFIG("crypt_chars");
+static struct CachedConfig CcDateFormat = CACHED_CONFIG("date_format");
+static struct CachedConfig CcFlagChars = CACHED_CONFIG("flag_chars");
+static struct CachedConfig CcFromChars = CACHED_CONFIG("from_chars");
+static struct CachedConfig CcSaveAddress = CACHED_CONFIG("save_address");
+static struct CachedConfig CcToChars = CACHED_CONFIG("to_chars");
+
 static void mailbox_mailbox_name(const struct ExpandoNode *node, void *data,
                                  MuttFormatFlags flags, struct Buffer *buf);
 
@@ -107,7 +115,7 @@ static const char *make_from_prefix(enum FieldType disp)
     [DISP_FROM] = "",  [DISP_PLAIN] = "",
   };
 
-  const struct MbTable *c_from_chars = cs_subset_mbtable(NeoMutt->sub, "from_chars");
+  const struct MbTable *c_from_chars = cc_mbtable(&CcFromChars);
 
   if (!c_from_chars || !c_from_chars->chars || (c_from_chars->len == 0))
     return long_prefixes[disp];
@@ -424,9 +432,9 @@ static void email_combined_flags(const struct ExpandoNode *node, void *data,
 
   const int msg_in_pager = efi->msg_in_pager;
 
-  const struct MbTable *c_crypt_chars = cs_subset_mbtable(NeoMutt->sub, "crypt_chars");
-  const struct MbTable *c_flag_chars = cs_subset_mbtable(NeoMutt->sub, "flag_chars");
-  const struct MbTable *c_to_chars = cs_subset_mbtable(NeoMutt->sub, "to_chars");
+  const struct MbTable *c_crypt_chars = cc_mbtable(&CcCryptChars);
+  const struct MbTable *c_flag_chars = cc_mbtable(&CcFlagChars);
+  const struct MbTable *c_to_chars = cc_mbtable(&CcToChars);
   const bool threads = mutt_using_threads();
 
   const char *first = NULL;
@@ -504,7 +512,7 @@ static void email_crypto_flags(const struct ExpandoNode *node, void *data,
   if (!e)
     return;
 
-  const struct MbTable *c_crypt_chars = cs_subset_mbtable(NeoMutt->sub, "crypt_chars");
+  const struct MbTable *c_crypt_chars = cc_mbtable(&CcCryptChars);
 
   const char *ch = NULL;
   if ((WithCrypto != 0) && (e->security & SEC_GOODSIGN))
@@ -544,7 +552,7 @@ static void email_date_format(const struct ExpandoNode *node, void *data,
   if (!e)
     return;
 
-  const char *c_date_format = cs_subset_string(NeoMutt->sub, "date_format");
+  const char *c_date_format = cc_string(&CcDateFormat);
   const char *cp = NONULL(c_date_format);
 
   index_email_date(node, e, SENT_SENDER, flags, buf, cp);
@@ -561,7 +569,7 @@ static void email_date_format_local(const struct ExpandoNode *node, void *data,
   if (!e)
     return;
 
-  const char *c_date_format = cs_subset_string(NeoMutt->sub, "date_format");
+  const char *c_date_format = cc_string(&CcDateFormat);
   const char *cp = NONULL(c_date_format);
 
   index_email_date(node, e, SENT_LOCAL, flags, buf, cp);
@@ -660,7 +668,7 @@ static void email_flag_chars(const struct ExpandoNode *node, void *data,
   if (!e)
     return;
 
-  const struct MbTable *c_flag_chars = cs_subset_mbtable(NeoMutt->sub, "flag_chars");
+  const struct MbTable *c_flag_chars = cc_mbtable(&CcFlagChars);
   const int msg_in_pager = efi->msg_in_pager;
 
   const char *wch = NULL;
@@ -759,7 +767,7 @@ static void email_list_or_save_folder(const struct ExpandoNode *node, void *data
   char *p = NULL;
 
   make_from_addr(e->env, tmp, sizeof(tmp), true);
-  const bool c_save_address = cs_subset_bool(NeoMutt->sub, "save_address");
+  const bool c_save_address = cc_bool(&CcSaveAddress);
   if (!c_save_address && (p = strpbrk(tmp, "%@")))
   {
     *p = '\0';
@@ -779,8 +787,8 @@ static void email_message_flags(const struct ExpandoNode *node, void *data,
   if (!e)
     return;
 
-  const struct MbTable *c_flag_chars = cs_subset_mbtable(NeoMutt->sub, "flag_chars");
-  const struct MbTable *c_to_chars = cs_subset_mbtable(NeoMutt->sub, "to_chars");
+  const struct MbTable *c_flag_chars = cc_mbtable(&CcFlagChars);
+  const struct MbTable *c_to_chars = cc_mbtable(&CcToChars);
 
   const char *ch = NULL;
   if (e->tagged)
@@ -872,7 +880,7 @@ static void email_status_flags(const struct ExpandoNode *node, void *data,
     return;
 
   const bool threads = mutt_using_threads();
-  const struct MbTable *c_flag_chars = cs_subset_mbtable(NeoMutt->sub, "flag_chars");
+  const struct MbTable *c_flag_chars = cc_mbtable(&CcFlagChars);
   const int msg_in_pager = efi->msg_in_pager;
 
   const char *ch = NULL;
@@ -1119,7 +1127,7 @@ static void email_to_chars(const struct ExpandoNode *node, void *data,
   if (!e)
     return;
 
-  const struct MbTable *c_to_chars = cs_subset_mbtable(NeoMutt->sub, "to_chars");
+  const struct MbTable *c_to_chars = cc_mbtable(&CcToChars);
 
   int i;
   const char *s = (c_to_chars && ((i = user_is_recipient(e))) < c_to_chars->len) ?
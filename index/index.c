@@ -52,6 +52,7 @@
  *
  * | Event Type            | Handler                 |
  * | :-------------------- | :---------------------- |
+ * | #NT_ALIAS             | index_alias_observer()  |
  * | #NT_ALTERN            | index_altern_observer() |
  * | #NT_ATTACH            | index_attach_observer() |
  * | #NT_COLOR             | index_color_observer()  |
@@ -216,6 +217,27 @@ static int config_reply_regex(struct MailboxView *mv)
   return 0;
 }
 
+/**
+ * index_alias_observer - Notification that an Alias has changed - Implements ::observer_t - @ingroup observer_api
+ *
+ * Aliases are used to display the names of the senders and recipients.
+ */
+static int index_alias_observer(struct NotifyCallback *nc)
+{
+  if (nc->event_type != NT_ALIAS)
+    return 0;
+  if (!nc->global_data)
+    return -1;
+
+  struct MuttWindow *win = nc->global_data;
+  struct Menu *menu = win->wdata;
+
+  email_changed_all();
+  menu_queue_redraw(menu, MENU_REDRAW_INDEX);
+  mutt_debug(LL_DEBUG5, "alias done\n");
+  return 0;
+}
+
 /**
  * index_altern_observer - Notification that an 'alternates' command has occurred - Implements ::observer_t - @ingroup observer_api
  */
@@ -231,6 +253,7 @@ static int index_altern_observer(struct NotifyCallback *nc)
   struct IndexSharedData *shared = dlg->wdata;
 
   mutt_alternates_reset(shared->mailbox_view);
+  email_changed_all();
   mutt_debug(LL_DEBUG5, "alternates done\n");
   return 0;
 }
@@ -250,6 +273,7 @@ static int index_attach_observer(struct NotifyCallback *nc)
   struct IndexSharedData *shared = dlg->wdata;
 
   mutt_attachments_reset(shared->mailbox_view);
+  email_changed_all();
   mutt_debug(LL_DEBUG5, "attachments done\n");
   return 0;
 }
@@ -395,6 +419,9 @@ static int index_config_observer(struct NotifyCallback *nc)
 
   struct MuttWindow *win = nc->global_data;
 
+  // Any config might be used by the $index_format expandos, or hooks
+  email_changed_all();
+
   if (!config_check_sort(ev_c->name) && !config_check_index(ev_c->name))
     return 0;
 
@@ -446,6 +473,9 @@ static int index_global_observer(struct NotifyCallback *nc)
   struct IndexSharedData *shared = dlg->wdata;
   mutt_check_rescore(shared->mailbox);
 
+  // The command may have changed aliases, hooks, etc
+  email_changed_all();
+
   return 0;
 }
 
@@ -543,6 +573,7 @@ static int index_subjrx_observer(struct NotifyCallback *nc)
   struct IndexSharedData *shared = dlg->wdata;
 
   subjrx_clear_mods(shared->mailbox_view);
+  email_changed_all();
   mutt_debug(LL_DEBUG5, "subjectrx done\n");
   return 0;
 }
@@ -573,6 +604,7 @@ static int index_window_observer(struct NotifyCallback *nc)
   struct IndexPrivateData *priv = menu->mdata;
 
   mutt_color_observer_remove(index_color_observer, win);
+  notify_observer_remove(NeoMutt->notify, index_alias_observer, win);
   notify_observer_remove(NeoMutt->notify, index_altern_observer, win);
   notify_observer_remove(NeoMutt->notify, index_attach_observer, win);
   notify_observer_remove(NeoMutt->sub->notify, index_config_observer, win);
@@ -666,6 +698,7 @@ struct MuttWindow *index_window_new(struct IndexPrivateData *priv)
   priv->menu = menu;
 
   mutt_color_observer_add(index_color_observer, win);
+  notify_observer_add(NeoMutt->notify, NT_ALIAS, index_alias_observer, win);
   notify_observer_add(NeoMutt->notify, NT_ALTERN, index_altern_observer, win);
   notify_observer_add(NeoMutt->notify, NT_ATTACH, index_attach_observer, win);
   notify_observer_add(NeoMutt->sub->notify, NT_CONFIG, index_config_observer, win);
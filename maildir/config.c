@@ -62,6 +62,26 @@ static int maildir_field_delimiter_validator(const struct ConfigDef *cdef,
   return CSR_SUCCESS;
 }
 
+/**
+ * maildir_read_ahead_validator - Validate the "maildir_read_ahead" config variable - Implements ConfigDef::validator() - @ingroup cfg_def_validator
+ *
+ * Each message that's read ahead holds a file descriptor open.
+ */
+static int maildir_read_ahead_validator(const struct ConfigDef *cdef,
+                                        intptr_t value, struct Buffer *err)
+{
+  const int min_files = 0;
+  const int max_files = 64;
+
+  if ((value >= min_files) && (value <= max_files))
+    return CSR_SUCCESS;
+
+  // L10N: This applies to the "$maildir_read_ahead" config variable.
+  buf_printf(err, _("Option %s must be between %d and %d inclusive"),
+             cdef->name, min_files, max_files);
+  return CSR_ERR_INVALID;
+}
+
 /**
  * MaildirVars - Config definitions for the Maildir library
  */
@@ -76,6 +96,9 @@ static struct ConfigDef MaildirVars[] = {
   { "maildir_field_delimiter", DT_STRING|D_NOT_EMPTY|D_ON_STARTUP, IP ":", 0, maildir_field_delimiter_validator,
     "Field delimiter to be used for maildir email files (default is colon, recommended alternative is semi-colon)"
   },
+  { "maildir_read_ahead", DT_NUMBER|D_INTEGER_NOT_NEGATIVE, 16, 0, maildir_read_ahead_validator,
+    "Number of message files to open in advance while reading a maildir"
+  },
   { "maildir_trash", DT_BOOL, false, 0, NULL,
     "Use the maildir 'trashed' flag, rather than deleting"
   },
@@ -92,6 +92,9 @@ int maildir_hcache_delete(struct HeaderCache *hc, struct Email *e)
 /**
  * maildir_hcache_open - Open the Header Cache
  * @param m Mailbox
+ *
+ * The cache is only kept open while the Mailbox is read or synced, so all the
+ * changes are written as one batch, when it's closed.
  */
 struct HeaderCache *maildir_hcache_open(struct Mailbox *m)
 {
@@ -100,7 +103,9 @@ struct HeaderCache *maildir_hcache_open(struct Mailbox *m)
 
   const char *const c_header_cache = cs_subset_path(NeoMutt->sub, "header_cache");
 
-  return hcache_open(c_header_cache, mailbox_path(m), NULL, true);
+  struct HeaderCache *hc = hcache_open(c_header_cache, mailbox_path(m), NULL, true);
+  hcache_begin_batch(hc);
+  return hc;
 }
 
 /**
@@ -125,8 +130,8 @@ struct Email *maildir_hcache_read(struct HeaderCache *hc, struct Email *e, const
   if (!hce.email)
     return NULL;
 
-  const bool c_maildir_header_cache_verify = cs_subset_bool(NeoMutt->sub, "maildir_header_cache_verify");
-  if (c_maildir_header_cache_verify)
+  static struct CachedConfig cc_maildir_header_cache_verify = CACHED_CONFIG("maildir_header_cache_verify");
+  if (cc_bool(&cc_maildir_header_cache_verify))
     rc = stat(fn, &st_lastchanged);
 
   if ((rc == 0) && (st_lastchanged.st_mtime <= hce.uidvalidity))
@@ -30,9 +30,11 @@
 #include "config.h"
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <limits.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/resource.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #include "mutt/lib.h"
@@ -330,16 +332,169 @@ cleanup:
   return rc;
 }
 
+/**
+ * maildir_open_ahead - Open a message file and ask the kernel to read it
+ * @param fn Filename
+ * @retval >=0 File descriptor
+ * @retval  -1 Error
+ *
+ * Opening the files a little ahead of the parser lets the kernel (or NFS
+ * client) fetch their contents while we're busy parsing earlier messages.
+ */
+static int maildir_open_ahead(const char *fn)
+{
+  int fd = open(fn, O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return -1;
+
+#ifdef HAVE_POSIX_FADVISE
+  posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+#endif
+  return fd;
+}
+
+/**
+ * maildir_read_ahead_limit - Limit the read-ahead to the spare file descriptors
+ * @param read_ahead Number of files to read ahead, `$maildir_read_ahead`
+ * @retval num Number of files to read ahead
+ */
+static int maildir_read_ahead_limit(int read_ahead)
+{
+  struct rlimit rl = { 0 };
+  if ((getrlimit(RLIMIT_NOFILE, &rl) == 0) && (rl.rlim_cur != RLIM_INFINITY))
+  {
+    // Leave most of the file descriptors for everything else
+    const int max_files = rl.rlim_cur / 4;
+    if (read_ahead > max_files)
+      read_ahead = max_files;
+  }
+
+  return read_ahead;
+}
+
+/**
+ * maildir_close_ahead - Close the files that have been read ahead
+ * @param fds   File descriptors
+ * @param first First one to close
+ * @param last  One after the last one to close
+ */
+static void maildir_close_ahead(int *fds, size_t first, size_t last)
+{
+  for (size_t i = first; fds && (i < last); i++)
+  {
+    if (fds[i] >= 0)
+      close(fds[i]);
+    fds[i] = -1;
+  }
+}
+
+/**
+ * maildir_parse_ahead - Parse some message files, reading ahead
+ * @param dir        Path to the Maildir
+ * @param mda        Maildir array to parse
+ * @param read_ahead Number of files to open in advance
+ * @param hc         Header cache to store the Emails in, may be NULL
+ * @param progress   Progress bar, may be NULL
+ * @param num_done   Number of Emails already done, for the Progress bar
+ *
+ * The files are parsed in order, while the next `read_ahead` of them are
+ * opened in advance, so that their I/O overlaps with the parsing.
+ *
+ * If the process runs out of file descriptors, the files that have been read
+ * ahead are closed and the rest are opened as they're parsed.
+ */
+void maildir_parse_ahead(const char *dir, struct MdEmailArray *mda, int read_ahead,
+                         struct HeaderCache *hc, struct Progress *progress,
+                         size_t num_done)
+{
+  if (!dir || !mda)
+    return;
+
+  char fn[PATH_MAX] = { 0 };
+  const size_t num_parse = ARRAY_SIZE(mda);
+  read_ahead = maildir_read_ahead_limit(read_ahead);
+
+  int *fds = NULL;
+  if ((read_ahead > 0) && (num_parse > 1))
+  {
+    fds = mutt_mem_malloc(num_parse * sizeof(int));
+    for (size_t i = 0; i < num_parse; i++)
+      fds[i] = -1;
+  }
+
+  size_t next_ahead = 0;
+  struct MdEmail **mdp = NULL;
+  ARRAY_FOREACH(mdp, mda)
+  {
+    struct MdEmail *md = *mdp;
+    const size_t idx = ARRAY_FOREACH_IDX_mdp;
+
+    progress_update(progress, num_done++, -1);
+
+    for (; fds && (next_ahead < num_parse) && (next_ahead <= (idx + read_ahead));
+         next_ahead++)
+    {
+      struct MdEmail *md_ahead = *ARRAY_GET(mda, next_ahead);
+      snprintf(fn, sizeof(fn), "%s/%s", dir, md_ahead->email->path);
+      fds[next_ahead] = maildir_open_ahead(fn);
+    }
+
+    snprintf(fn, sizeof(fn), "%s/%s", dir, md->email->path);
+
+    FILE *fp = NULL;
+    if (fds && (fds[idx] >= 0))
+    {
+      fp = fdopen(fds[idx], "r");
+      if (!fp)
+        close(fds[idx]);
+      fds[idx] = -1;
+    }
+
+    if (!fp)
+    {
+      fp = mutt_file_fopen(fn, "r");
+      if (!fp && fds && (next_ahead > (idx + 1)))
+      {
+        // We may have run out of file descriptors, give back the read-ahead
+        maildir_close_ahead(fds, idx + 1, next_ahead);
+        read_ahead = 0;
+        fp = mutt_file_fopen(fn, "r");
+      }
+    }
+
+    const bool parsed = maildir_parse_stream(fp, fn, md->email->old, md->email);
+    mutt_file_fclose(&fp);
+
+    if (parsed)
+    {
+      md->header_parsed = true;
+      maildir_hcache_store(hc, md->email);
+    }
+    else
+    {
+      email_free(&md->email);
+    }
+  }
+
+  maildir_close_ahead(fds, 0, next_ahead);
+  FREE(&fds);
+}
+
 /**
  * maildir_delayed_parsing - This function does the second parsing pass
  * @param[in]  m   Mailbox
  * @param[out] mda Maildir array to parse
  * @param[in]  progress Progress bar
+ *
+ * The Emails are looked up in the header cache first.  The remaining files
+ * are then parsed by maildir_parse_ahead().
  */
 static void maildir_delayed_parsing(struct Mailbox *m, struct MdEmailArray *mda,
                                     struct Progress *progress)
 {
   char fn[PATH_MAX] = { 0 };
+  size_t num_done = 0;
+  struct MdEmailArray mda_parse = ARRAY_HEAD_INITIALIZER;
 
   struct HeaderCache *hc = maildir_hcache_open(m);
 
@@ -351,8 +506,6 @@ static void maildir_delayed_parsing(struct Mailbox *m, struct MdEmailArray *mda,
     if (!md || !md->email || md->header_parsed)
       continue;
 
-    progress_update(progress, ARRAY_FOREACH_IDX_mdp, -1);
-
     snprintf(fn, sizeof(fn), "%s/%s", mailbox_path(m), md->email->path);
 
     struct Email *e = maildir_hcache_read(hc, md->email, fn);
@@ -360,21 +513,19 @@ static void maildir_delayed_parsing(struct Mailbox *m, struct MdEmailArray *mda,
     {
       email_free(&md->email);
       md->email = e;
+      progress_update(progress, num_done++, -1);
     }
     else
     {
-      if (maildir_parse_message(fn, md->email->old, md->email))
-      {
-        md->header_parsed = true;
-        maildir_hcache_store(hc, md->email);
-      }
-      else
-      {
-        email_free(&md->email);
-      }
+      ARRAY_ADD(&mda_parse, md);
     }
   }
 
+  const short c_maildir_read_ahead = cs_subset_number(NeoMutt->sub, "maildir_read_ahead");
+  maildir_parse_ahead(mailbox_path(m), &mda_parse, c_maildir_read_ahead, hc,
+                      progress, num_done);
+
+  ARRAY_FREE(&mda_parse);
   maildir_hcache_close(&hc);
 }
 
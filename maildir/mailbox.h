@@ -24,10 +24,14 @@
 #define MUTT_MAILDIR_MAILBOX_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include "core/lib.h"
 
 struct Email;
+struct HeaderCache;
+struct MdEmailArray;
+struct Progress;
 
 enum MxStatus      maildir_mbox_check      (struct Mailbox *m);
 enum MxStatus      maildir_mbox_check_stats(struct Mailbox *m, uint8_t flags);
@@ -35,6 +39,7 @@ enum MxStatus      maildir_mbox_close      (struct Mailbox *m);
 enum MxOpenReturns maildir_mbox_open       (struct Mailbox *m);
 bool               maildir_mbox_open_append(struct Mailbox *m, OpenMailboxFlags flags);
 enum MxStatus      maildir_mbox_sync       (struct Mailbox *m);
+void               maildir_parse_ahead     (const char *dir, struct MdEmailArray *mda, int read_ahead, struct HeaderCache *hc, struct Progress *progress, size_t num_done);
 void               maildir_parse_flags     (struct Email *e, const char *path);
 
 #endif /* MUTT_MAILDIR_MAILBOX_H */
@@ -59,6 +59,7 @@ const struct MxOps MxMaildirOps = {
   .msg_commit       = maildir_msg_commit,
   .msg_close        = maildir_msg_close,
   .msg_padding_size = NULL,
+  .msg_prefetch     = maildir_msg_prefetch,
   .msg_save_hcache  = maildir_msg_save_hcache,
   .tags_edit        = NULL,
   .tags_commit      = NULL,
@@ -520,6 +520,17 @@ bool maildir_msg_open(struct Mailbox *m, struct Message *msg, struct Email *e)
   return true;
 }
 
+/**
+ * maildir_msg_prefetch - Start reading a message in the background - Implements MxOps::msg_prefetch() - @ingroup mx_msg_prefetch
+ */
+void maildir_msg_prefetch(struct Mailbox *m, struct Email *e)
+{
+  char path[PATH_MAX] = { 0 };
+
+  snprintf(path, sizeof(path), "%s/%s", mailbox_path(m), e->path);
+  mutt_file_prefetch(path);
+}
+
 /**
  * maildir_msg_open_new - Open a new message in a Mailbox - Implements MxOps::msg_open_new() - @ingroup mx_msg_open_new
  *
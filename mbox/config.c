@@ -39,14 +39,37 @@ static struct ConfigDef MboxVars[] = {
   { "check_mbox_size", DT_BOOL, false, 0, NULL,
     "(mbox,mmdf) Use mailbox size as an indicator of new mail"
   },
+  { "mbox_sync_in_place", DT_BOOL, false, 0, NULL,
+    "(mbox,mmdf) Update changed flags in place, rather than rewriting the mailbox"
+  },
   { NULL },
   // clang-format on
 };
 
+#if defined(USE_HCACHE)
+/**
+ * MboxVarsHcache - Config definitions for the Mbox header cache
+ */
+static struct ConfigDef MboxVarsHcache[] = {
+  // clang-format off
+  { "mbox_header_cache", DT_BOOL, false, 0, NULL,
+    "(mbox,mmdf) Use the header cache for mbox and mmdf mailboxes"
+  },
+  { NULL },
+  // clang-format on
+};
+#endif
+
 /**
  * config_init_mbox - Register mbox config variables - Implements ::module_init_config_t - @ingroup cfg_module_api
  */
 bool config_init_mbox(struct ConfigSet *cs)
 {
-  return cs_register_variables(cs, MboxVars);
+  bool rc = cs_register_variables(cs, MboxVars);
+
+#if defined(USE_HCACHE)
+  rc |= cs_register_variables(cs, MboxVarsHcache);
+#endif
+
+  return rc;
 }
@@ -0,0 +1,357 @@
+/**
+ * @file
+ * Mbox Header Cache
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page mbox_hcache Mbox Header Cache
+ *
+ * Mbox Header Cache
+ *
+ * The Emails of an mbox/mmdf file are cached by their index in the file.
+ * Alongside them, the cache holds the offset of every message and a record
+ * describing the file (size, mtime and a checksum of its last block).
+ *
+ * When the mailbox is opened and the file is unchanged, all the Emails are
+ * restored from the cache.  If the file has grown, but the cached part still
+ * looks the same, the cached Emails are restored and only the new messages,
+ * at the end of the file, need to be parsed.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "hcache.h"
+#include "lib.h"
+#include "hcache/lib.h"
+#include "progress/lib.h"
+#include "mx.h"
+
+/// Header cache key of the #MboxHcacheIndex
+#define MBOX_HCACHE_INDEX "mbox-index"
+/// Header cache key of the array of message offsets
+#define MBOX_HCACHE_OFFSETS "mbox-offsets"
+/// Number of bytes at the end of the cached part of the file to checksum
+#define MBOX_HCACHE_TAIL 4096
+
+/**
+ * struct MboxHcacheIndex - Description of the cached part of an mbox file
+ */
+struct MboxHcacheIndex
+{
+  uint64_t size;          ///< Size of the file, when cached
+  int64_t mtime_sec;      ///< Modification time of the file, seconds
+  int64_t mtime_nsec;     ///< Modification time of the file, nanoseconds
+  uint32_t count;         ///< Number of cached Emails
+  unsigned char tail[16]; ///< MD5 checksum of the last block of the file
+};
+
+/**
+ * mbox_hcache_tail - Checksum the end of the cached part of the file
+ * @param[in]  fp     File to read
+ * @param[in]  size   End of the cached part of the file
+ * @param[out] digest MD5 checksum, 16 bytes
+ * @retval true Success
+ */
+static bool mbox_hcache_tail(FILE *fp, LOFF_T size, unsigned char *digest)
+{
+  char buf[MBOX_HCACHE_TAIL];
+  LOFF_T start = (size > MBOX_HCACHE_TAIL) ? (size - MBOX_HCACHE_TAIL) : 0;
+  size_t len = size - start;
+
+  if (!mutt_file_seek(fp, start, SEEK_SET) || (fread(buf, 1, len, fp) != len))
+    return false;
+
+  mutt_md5_bytes(buf, len, digest);
+  return true;
+}
+
+/**
+ * mbox_hcache_check_sep - Is there a message separator at an offset?
+ * @param m      Mailbox
+ * @param fp     File to read
+ * @param offset Offset of a message
+ * @retval true The separator was found
+ *
+ * mbox messages start with a "From " line.
+ * mmdf messages are preceded by a #MMDF_SEP line.
+ */
+static bool mbox_hcache_check_sep(struct Mailbox *m, FILE *fp, LOFF_T offset)
+{
+  char buf[8] = { 0 };
+
+  if (m->type == MUTT_MMDF)
+  {
+    const size_t len = sizeof(MMDF_SEP) - 1;
+    if ((offset < (LOFF_T) len) || !mutt_file_seek(fp, offset - len, SEEK_SET))
+      return false;
+    return (fread(buf, 1, len, fp) == len) && (memcmp(buf, MMDF_SEP, len) == 0);
+  }
+
+  if (!mutt_file_seek(fp, offset, SEEK_SET))
+    return false;
+  return (fread(buf, 1, 5, fp) == 5) && (memcmp(buf, "From ", 5) == 0);
+}
+
+/**
+ * mbox_hcache_close - Close the Header Cache
+ * @param ptr Header Cache
+ */
+void mbox_hcache_close(struct HeaderCache **ptr)
+{
+  hcache_close(ptr);
+}
+
+/**
+ * mbox_hcache_open - Open the Header Cache
+ * @param m Mailbox
+ * @retval ptr  Header Cache
+ * @retval NULL The cache is disabled, or couldn't be opened
+ *
+ * The cache is only kept open while the Mailbox is read or synced, so all the
+ * changes are written as one batch, when it's closed.
+ */
+struct HeaderCache *mbox_hcache_open(struct Mailbox *m)
+{
+  if (!m)
+    return NULL;
+
+  const bool c_mbox_header_cache = cs_subset_bool(NeoMutt->sub, "mbox_header_cache");
+  if (!c_mbox_header_cache)
+    return NULL;
+
+  const char *const c_header_cache = cs_subset_path(NeoMutt->sub, "header_cache");
+
+  struct HeaderCache *hc = hcache_open(c_header_cache, mailbox_path(m), NULL, true);
+  hcache_begin_batch(hc);
+  return hc;
+}
+
+/**
+ * mbox_hcache_read - Restore the cached Emails of a Mailbox
+ * @param hc       Header Cache
+ * @param m        Mailbox, must be empty
+ * @param fp       Mailbox file
+ * @param st       Current status of the Mailbox file
+ * @param progress Progress bar
+ * @retval true Emails were restored, fp is positioned after them
+ * @retval false Nothing was restored, fp is unmoved
+ *
+ * The cache is only used if the file still matches it.  Either the file is
+ * unchanged, or it has grown and the cached part is intact.  If the file has
+ * been modified without growing, it must be parsed again.
+ */
+bool mbox_hcache_read(struct HeaderCache *hc, struct Mailbox *m, FILE *fp,
+                        struct stat *st, struct Progress *progress)
+{
+  if (!hc || !m || !fp || !st || (m->msg_count != 0))
+    return false;
+
+  struct MboxHcacheIndex idx = { 0 };
+  if (!hcache_fetch_raw_obj(hc, MBOX_HCACHE_INDEX, sizeof(MBOX_HCACHE_INDEX) - 1, &idx))
+    return false;
+
+  if ((idx.count == 0) || (idx.size > (uint64_t) st->st_size))
+    return false;
+
+  const LOFF_T pos = ftello(fp);
+  if (pos < 0)
+    return false;
+
+  struct timespec mtime = { 0 };
+  mutt_file_get_stat_timespec(&mtime, st, MUTT_STAT_MTIME);
+  const bool unchanged = (idx.size == (uint64_t) st->st_size) &&
+                         (idx.mtime_sec == mtime.tv_sec) &&
+                         (idx.mtime_nsec == mtime.tv_nsec);
+
+  // The file has been modified, but hasn't grown, e.g. edited in place
+  if (!unchanged && (idx.size == (uint64_t) st->st_size))
+  {
+    mutt_debug(LL_DEBUG2, "%s has been modified\n", mailbox_path(m));
+    return false;
+  }
+
+  bool rc = false;
+  uint64_t *offsets = MUTT_MEM_MALLOC(idx.count, uint64_t);
+  if (!hcache_fetch_raw_obj_full(hc, MBOX_HCACHE_OFFSETS, sizeof(MBOX_HCACHE_OFFSETS) - 1,
+                                 offsets, idx.count * sizeof(uint64_t)))
+  {
+    goto done;
+  }
+
+  if (!unchanged)
+  {
+    unsigned char digest[16] = { 0 };
+    if (!mbox_hcache_tail(fp, idx.size, digest) || (memcmp(digest, idx.tail, sizeof(digest)) != 0))
+    {
+      mutt_debug(LL_DEBUG2, "%s has changed\n", mailbox_path(m));
+      goto done;
+    }
+
+    for (uint32_t i = 0; i < idx.count; i++)
+    {
+      if (!mbox_hcache_check_sep(m, fp, offsets[i]))
+      {
+        mutt_debug(LL_DEBUG2, "message %u of %s has moved\n", i, mailbox_path(m));
+        goto done;
+      }
+    }
+  }
+
+  char key[16] = { 0 };
+  for (uint32_t i = 0; i < idx.count; i++)
+  {
+    snprintf(key, sizeof(key), "%u", i);
+    struct HCacheEntry hce = hcache_fetch_email(hc, key, strlen(key), 0);
+    if (!hce.email)
+    {
+      mutt_debug(LL_DEBUG2, "message %u of %s isn't cached\n", i, mailbox_path(m));
+      for (int j = 0; j < m->msg_count; j++)
+        email_free(&m->emails[j]);
+      m->msg_count = 0;
+      goto done;
+    }
+
+    mx_alloc_memory(m, m->msg_count);
+    hce.email->offset = offsets[i];
+    hce.email->index = m->msg_count;
+    m->emails[m->msg_count++] = hce.email;
+    progress_update(progress, m->msg_count, -1);
+  }
+
+  mutt_debug(LL_DEBUG2, "restored %d emails of %s\n", m->msg_count, mailbox_path(m));
+  rc = true;
+
+done:
+  FREE(&offsets);
+  if (!mutt_file_seek(fp, rc ? (LOFF_T) idx.size : pos, SEEK_SET) && rc)
+  {
+    for (int i = 0; i < m->msg_count; i++)
+      email_free(&m->emails[i]);
+    m->msg_count = 0;
+    rc = false;
+  }
+  return rc;
+}
+
+/**
+ * mbox_hcache_store_index - Save the offsets and the file's details
+ * @param hc Header Cache
+ * @param m  Mailbox
+ * @param st Status of the Mailbox file
+ */
+static void mbox_hcache_store_index(struct HeaderCache *hc, struct Mailbox *m, struct stat *st)
+{
+  struct MboxAccountData *adata = m->account ? m->account->adata : NULL;
+  if (!adata || !adata->fp)
+    return;
+
+  struct MboxHcacheIndex idx = { 0 };
+  idx.size = st->st_size;
+  idx.count = m->msg_count;
+
+  struct timespec mtime = { 0 };
+  mutt_file_get_stat_timespec(&mtime, st, MUTT_STAT_MTIME);
+  idx.mtime_sec = mtime.tv_sec;
+  idx.mtime_nsec = mtime.tv_nsec;
+
+  const LOFF_T pos = ftello(adata->fp);
+  const bool ok = mbox_hcache_tail(adata->fp, idx.size, idx.tail);
+  if (pos >= 0)
+    (void) mutt_file_seek(adata->fp, pos, SEEK_SET);
+  if (!ok)
+    return;
+
+  uint64_t *offsets = MUTT_MEM_CALLOC(MAX(idx.count, 1), uint64_t);
+  for (int i = 0; i < m->msg_count; i++)
+    offsets[i] = m->emails[i]->offset;
+
+  hcache_store_raw(hc, MBOX_HCACHE_OFFSETS, sizeof(MBOX_HCACHE_OFFSETS) - 1,
+                   offsets, idx.count * sizeof(uint64_t));
+  hcache_store_raw(hc, MBOX_HCACHE_INDEX, sizeof(MBOX_HCACHE_INDEX) - 1, &idx, sizeof(idx));
+  FREE(&offsets);
+}
+
+/**
+ * mbox_hcache_store - Save the Emails of a Mailbox to the Header Cache
+ * @param hc    Header Cache
+ * @param m     Mailbox
+ * @param first Index of the first Email that isn't in the cache
+ * @param st    Status of the Mailbox file, when it was parsed
+ */
+void mbox_hcache_store(struct HeaderCache *hc, struct Mailbox *m, int first, struct stat *st)
+{
+  if (!hc || !m || !st || (first < 0))
+    return;
+
+  char key[16] = { 0 };
+  for (int i = first; i < m->msg_count; i++)
+  {
+    snprintf(key, sizeof(key), "%d", i);
+    hcache_store_email(hc, key, strlen(key), m->emails[i], 0);
+  }
+
+  mbox_hcache_store_index(hc, m, st);
+}
+
+/**
+ * mbox_hcache_sync - Bring the Header Cache up to date after a sync
+ * @param m        Mailbox
+ * @param in_place true if only the flags were updated, in place
+ *
+ * If the messages were updated in place, their offsets haven't changed, so
+ * only the changed Emails need to be saved.  Otherwise, the cache is
+ * invalidated and will be rebuilt the next time the Mailbox is opened.
+ */
+void mbox_hcache_sync(struct Mailbox *m, bool in_place)
+{
+  struct HeaderCache *hc = mbox_hcache_open(m);
+  if (!hc)
+    return;
+
+  struct stat st = { 0 };
+  if (in_place && (stat(mailbox_path(m), &st) == 0))
+  {
+    char key[16] = { 0 };
+    for (int i = 0; i < m->msg_count; i++)
+    {
+      if (!m->emails[i]->changed)
+        continue;
+
+      snprintf(key, sizeof(key), "%d", i);
+      hcache_store_email(hc, key, strlen(key), m->emails[i], 0);
+    }
+
+    mbox_hcache_store_index(hc, m, &st);
+  }
+  else
+  {
+    hcache_delete_raw(hc, MBOX_HCACHE_INDEX, sizeof(MBOX_HCACHE_INDEX) - 1);
+  }
+
+  mbox_hcache_close(&hc);
+}
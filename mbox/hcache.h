@@ -0,0 +1,52 @@
+/**
+ * @file
+ * Mbox Header Cache
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_MBOX_HCACHE_H
+#define MUTT_MBOX_HCACHE_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <sys/stat.h>
+
+struct HeaderCache;
+struct Mailbox;
+struct Progress;
+
+#ifdef USE_HCACHE
+
+void                mbox_hcache_close(struct HeaderCache **ptr);
+struct HeaderCache *mbox_hcache_open (struct Mailbox *m);
+bool                mbox_hcache_read (struct HeaderCache *hc, struct Mailbox *m, FILE *fp, struct stat *st, struct Progress *progress);
+void                mbox_hcache_store(struct HeaderCache *hc, struct Mailbox *m, int first, struct stat *st);
+void                mbox_hcache_sync (struct Mailbox *m, bool in_place);
+
+#else
+
+static inline void                mbox_hcache_close(struct HeaderCache **ptr) {}
+static inline struct HeaderCache *mbox_hcache_open (struct Mailbox *m) { return NULL; }
+static inline bool                mbox_hcache_read (struct HeaderCache *hc, struct Mailbox *m, FILE *fp, struct stat *st, struct Progress *progress) { return false; }
+static inline void                mbox_hcache_store(struct HeaderCache *hc, struct Mailbox *m, int first, struct stat *st) {}
+static inline void                mbox_hcache_sync (struct Mailbox *m, bool in_place) {}
+
+#endif
+
+#endif /* MUTT_MBOX_HCACHE_H */
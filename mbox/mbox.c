@@ -56,6 +56,7 @@
 #include "progress/lib.h"
 #include "copy.h"
 #include "globals.h"
+#include "hcache.h"
 #include "mutt_header.h"
 #include "muttlib.h"
 #include "mx.h"
@@ -198,6 +199,8 @@ static enum MxOpenReturns mmdf_parse_mailbox(struct Mailbox *m)
   struct Email *e = NULL;
   struct stat st = { 0 };
   struct Progress *progress = NULL;
+  struct HeaderCache *hc = NULL;
+  int first = 0;
   enum MxOpenReturns rc = MX_OPEN_ERROR;
 
   if (stat(mailbox_path(m), &st) == -1)
@@ -217,6 +220,13 @@ static enum MxOpenReturns mmdf_parse_mailbox(struct Mailbox *m)
     progress_set_message(progress, _("Reading %s..."), mailbox_path(m));
   }
 
+  if (m->msg_count == 0)
+  {
+    hc = mbox_hcache_open(m);
+    mbox_hcache_read(hc, m, adata->fp, &st, progress);
+    first = m->msg_count;
+  }
+
   while (true)
   {
     if (!fgets(buf, sizeof(buf) - 1, adata->fp))
@@ -331,8 +341,10 @@ static enum MxOpenReturns mmdf_parse_mailbox(struct Mailbox *m)
     goto fail;
   }
 
+  mbox_hcache_store(hc, m, first, &st);
   rc = MX_OPEN_OK;
 fail:
+  mbox_hcache_close(&hc);
   progress_free(&progress);
   return rc;
 }
@@ -365,6 +377,8 @@ static enum MxOpenReturns mbox_parse_mailbox(struct Mailbox *m)
   int count = 0, lines = 0;
   LOFF_T loc;
   struct Progress *progress = NULL;
+  struct HeaderCache *hc = NULL;
+  int first = 0;
   enum MxOpenReturns rc = MX_OPEN_ERROR;
 
   /* Save information about the folder at the time we opened it. */
@@ -387,6 +401,14 @@ static enum MxOpenReturns mbox_parse_mailbox(struct Mailbox *m)
     progress_set_message(progress, _("Reading %s..."), mailbox_path(m));
   }
 
+  /* Restore the unchanged part of the mailbox from the header cache */
+  if (m->msg_count == 0)
+  {
+    hc = mbox_hcache_open(m);
+    mbox_hcache_read(hc, m, adata->fp, &st, progress);
+    first = m->msg_count;
+  }
+
   loc = ftello(adata->fp);
   if (loc < 0)
   {
@@ -499,13 +521,20 @@ static enum MxOpenReturns mbox_parse_mailbox(struct Mailbox *m)
         mutt_addrlist_copy(&e_cur->env->from, &e_cur->env->return_path, false);
 
       lines = 0;
+      loc = ftello(adata->fp);
     }
     else
     {
       lines++;
-    }
 
-    loc = ftello(adata->fp);
+      /* Track the offset ourselves, rather than calling ftello() for every
+       * line.  If the line contains a NUL, strlen() can't be trusted. */
+      const size_t len = strlen(buf);
+      if ((len == (sizeof(buf) - 1)) || ((len > 0) && (buf[len - 1] == '\n')))
+        loc += len;
+      else
+        loc = ftello(adata->fp);
+    }
   }
 
   /* Only set the content-length of the previous message if we have read more
@@ -533,8 +562,10 @@ static enum MxOpenReturns mbox_parse_mailbox(struct Mailbox *m)
     goto fail; /* action aborted */
   }
 
+  mbox_hcache_store(hc, m, first, &st);
   rc = MX_OPEN_OK;
 fail:
+  mbox_hcache_close(&hc);
   progress_free(&progress);
   return rc;
 }
@@ -1057,6 +1088,173 @@ error:
   return MX_STATUS_ERROR;
 }
 
+/**
+ * struct MboxStatusField - A status field to be updated in place
+ */
+struct MboxStatusField
+{
+  LOFF_T offset;     ///< Offset of the field's value, after the colon
+  size_t len;        ///< Length of the field's value, excluding the newline
+  const char *value; ///< New value of the field
+};
+ARRAY_HEAD(MboxStatusFieldArray, struct MboxStatusField);
+
+/**
+ * mbox_find_status - Find the status fields of an Email
+ * @param[in]  fp      Mailbox file
+ * @param[in]  e       Email
+ * @param[out] status  Status: field
+ * @param[out] xstatus X-Status: field
+ * @retval true Success, fields that weren't found have an offset of -1
+ * @retval false The header couldn't be read, or the fields are unusual
+ */
+static bool mbox_find_status(FILE *fp, struct Email *e, struct MboxStatusField *status,
+                             struct MboxStatusField *xstatus)
+{
+  char buf[1024] = { 0 };
+  struct MboxStatusField *field = NULL;
+  bool bol = true; /* at the beginning of a line */
+  status->offset = -1;
+  xstatus->offset = -1;
+
+  if (!mutt_file_seek(fp, e->offset, SEEK_SET))
+    return false;
+
+  LOFF_T loc = e->offset;
+  while ((loc < e->body->offset) && fgets(buf, sizeof(buf), fp))
+  {
+    const size_t len = strlen(buf);
+    const bool eol = (len > 0) && (buf[len - 1] == '\n');
+
+    /* A NUL would upset our offsets */
+    if (!eol && (len != (sizeof(buf) - 1)))
+      return false;
+
+    if (bol)
+    {
+      /* Don't touch folded status fields */
+      if (field && ((buf[0] == ' ') || (buf[0] == '\t')))
+        return false;
+
+      field = NULL;
+      size_t plen = 0;
+      if ((plen = mutt_istr_startswith(buf, "Status:")))
+        field = status;
+      else if ((plen = mutt_istr_startswith(buf, "X-Status:")))
+        field = xstatus;
+
+      if (field)
+      {
+        if ((field->offset != -1) || !eol)
+          return false;
+        field->offset = loc + plen;
+        field->len = len - plen - 1;
+        if ((field->len > 0) && (buf[len - 2] == '\r'))
+          field->len--;
+      }
+    }
+
+    loc += len;
+    bol = eol;
+  }
+
+  return true;
+}
+
+/**
+ * mbox_sync_in_place - Update the flags of the changed Emails in place
+ * @param m Mailbox
+ * @retval  1 Success, the changes were written
+ * @retval  0 The mailbox needs to be rewritten, nothing was written
+ * @retval -1 Error writing the changes
+ *
+ * If the only changes are to the flags of Emails, and their status fields
+ * have room for the new values, then they are overwritten in place, rather
+ * than rewriting the mailbox.
+ */
+static int mbox_sync_in_place(struct Mailbox *m)
+{
+  const bool c_mbox_sync_in_place = cs_subset_bool(NeoMutt->sub, "mbox_sync_in_place");
+  if (!c_mbox_sync_in_place)
+    return 0;
+
+  struct MboxAccountData *adata = mbox_adata_get(m);
+  if (!adata)
+    return 0;
+
+  int rc = 0;
+  char buf[256] = { 0 };
+  struct MboxStatusFieldArray fields = ARRAY_HEAD_INITIALIZER;
+
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (e->deleted || e->attach_del)
+      goto done;
+    if (!e->changed)
+      continue;
+    if (e->env->changed)
+      goto done;
+
+    struct MboxStatusField status = { 0 };
+    struct MboxStatusField xstatus = { 0 };
+    if (!mbox_find_status(adata->fp, e, &status, &xstatus))
+      goto done;
+
+    status.value = e->read ? "RO" : (e->old ? "O" : "");
+
+    if (e->replied && e->flagged)
+      xstatus.value = "AF";
+    else if (e->replied)
+      xstatus.value = "A";
+    else
+      xstatus.value = e->flagged ? "F" : "";
+
+    struct MboxStatusField *fields_new[] = { &status, &xstatus };
+    for (size_t j = 0; j < countof(fields_new); j++)
+    {
+      struct MboxStatusField *field = fields_new[j];
+      if (field->offset == -1)
+      {
+        if (field->value[0] != '\0')
+          goto done;
+        continue;
+      }
+
+      /* The value is written with a leading space */
+      if ((field->len >= sizeof(buf)) ||
+          ((field->value[0] != '\0') && (field->len < (mutt_str_len(field->value) + 1))))
+      {
+        goto done;
+      }
+
+      ARRAY_ADD(&fields, *field);
+    }
+  }
+
+  rc = -1;
+  struct MboxStatusField *field = NULL;
+  ARRAY_FOREACH(field, &fields)
+  {
+    memset(buf, ' ', field->len);
+    if (field->value[0] != '\0')
+      memcpy(buf + 1, field->value, mutt_str_len(field->value));
+
+    if (!mutt_file_seek(adata->fp, field->offset, SEEK_SET) ||
+        (fwrite(buf, 1, field->len, adata->fp) != field->len))
+    {
+      goto done;
+    }
+  }
+
+  if (fflush(adata->fp) == 0)
+    rc = 1;
+
+done:
+  ARRAY_FREE(&fields);
+  return rc;
+}
+
 /**
  * mbox_mbox_sync - Save changes to the Mailbox - Implements MxOps::mbox_sync() - @ingroup mx_mbox_sync
  */
@@ -1120,6 +1318,28 @@ static enum MxStatus mbox_mbox_sync(struct Mailbox *m)
     goto fatal;
   }
 
+  /* Save the state of this folder, in case we can update it in place. */
+  if (stat(mailbox_path(m), &st) == -1)
+  {
+    mutt_perror("%s", mailbox_path(m));
+    goto bail;
+  }
+
+  const int rc_in_place = mbox_sync_in_place(m);
+  if (rc_in_place < 0)
+  {
+    mutt_perror("%s", mailbox_path(m));
+    goto bail;
+  }
+  else if (rc_in_place > 0)
+  {
+    mbox_unlock_mailbox(m);
+    mbox_reset_atime(m, &st);
+    mbox_hcache_sync(m, true);
+    mutt_sig_unblock();
+    return MX_STATUS_OK;
+  }
+
   /* Create a temporary file to write the new version of the mailbox in. */
   tempfile = buf_pool_get();
   buf_mktemp(tempfile);
@@ -1174,6 +1394,12 @@ static enum MxStatus mbox_mbox_sync(struct Mailbox *m)
     progress_set_message(progress, _("Writing %s..."), mailbox_path(m));
   }
 
+  /* Leave room in the status fields, so that later syncs can be done in place */
+  CopyHeaderFlags chflags = CH_FROM | CH_UPDATE | CH_UPDATE_LEN;
+  const bool c_mbox_sync_in_place = cs_subset_bool(NeoMutt->sub, "mbox_sync_in_place");
+  if (c_mbox_sync_in_place)
+    chflags |= CH_PAD_STATUS;
+
   for (i = first, j = 0; i < m->msg_count; i++)
   {
     progress_update(progress, i, i / (m->msg_count / 100 + 1));
@@ -1205,8 +1431,7 @@ static enum MxStatus mbox_mbox_sync(struct Mailbox *m)
       new_offset[i - first].hdr = ftello(fp) + offset;
 
       struct Message *msg = mx_msg_open(m, m->emails[i]);
-      const int rc2 = mutt_copy_message(fp, m->emails[i], msg, MUTT_CM_UPDATE,
-                                        CH_FROM | CH_UPDATE | CH_UPDATE_LEN, 0);
+      const int rc2 = mutt_copy_message(fp, m->emails[i], msg, MUTT_CM_UPDATE, chflags, 0);
       mx_msg_close(m, &msg);
       if (rc2 != 0)
       {
@@ -1365,6 +1590,7 @@ static enum MxStatus mbox_mbox_sync(struct Mailbox *m)
   FREE(&old_offset);
   unlink(buf_string(tempfile)); /* remove partial copy of the mailbox */
   buf_pool_release(&tempfile);
+  mbox_hcache_sync(m, false);
   mutt_sig_unblock();
 
   const bool c_check_mbox_size = cs_subset_bool(NeoMutt->sub, "check_mbox_size");
@@ -1727,6 +1953,7 @@ const struct MxOps MxMboxOps = {
   .msg_commit       = mbox_msg_commit,
   .msg_close        = mbox_msg_close,
   .msg_padding_size = mbox_msg_padding_size,
+  .msg_prefetch     = NULL,
   .msg_save_hcache  = NULL,
   .tags_edit        = NULL,
   .tags_commit      = NULL,
@@ -1757,6 +1984,7 @@ const struct MxOps MxMmdfOps = {
   .msg_commit       = mmdf_msg_commit,
   .msg_close        = mbox_msg_close,
   .msg_padding_size = mmdf_msg_padding_size,
+  .msg_prefetch     = NULL,
   .msg_save_hcache  = NULL,
   .tags_edit        = NULL,
   .tags_commit      = NULL,
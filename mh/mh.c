@@ -553,6 +553,7 @@ static void mh_delayed_parsing(struct Mailbox *m, struct MhEmailArray *mha,
 #ifdef USE_HCACHE
   const char *const c_header_cache = cs_subset_path(NeoMutt->sub, "header_cache");
   struct HeaderCache *hc = hcache_open(c_header_cache, mailbox_path(m), NULL, true);
+  hcache_begin_batch(hc);
 #endif
 
   struct MhEmail *md = NULL;
@@ -1071,6 +1072,7 @@ static enum MxStatus mh_mbox_sync(struct Mailbox *m)
 #ifdef USE_HCACHE
   const char *const c_header_cache = cs_subset_path(NeoMutt->sub, "header_cache");
   hc = hcache_open(c_header_cache, mailbox_path(m), NULL, true);
+  hcache_begin_batch(hc);
 #endif
 
   struct Progress *progress = NULL;
@@ -1155,6 +1157,17 @@ static bool mh_msg_open(struct Mailbox *m, struct Message *msg, struct Email *e)
   return true;
 }
 
+/**
+ * mh_msg_prefetch - Start reading a message in the background - Implements MxOps::msg_prefetch() - @ingroup mx_msg_prefetch
+ */
+static void mh_msg_prefetch(struct Mailbox *m, struct Email *e)
+{
+  char path[PATH_MAX] = { 0 };
+
+  snprintf(path, sizeof(path), "%s/%s", mailbox_path(m), e->path);
+  mutt_file_prefetch(path);
+}
+
 /**
  * mh_msg_open_new - Open a new message in a Mailbox - Implements MxOps::msg_open_new() - @ingroup mx_msg_open_new
  *
@@ -1253,6 +1266,7 @@ const struct MxOps MxMhOps = {
   .msg_commit       = mh_msg_commit,
   .msg_close        = mh_msg_close,
   .msg_padding_size = NULL,
+  .msg_prefetch     = mh_msg_prefetch,
   .msg_save_hcache  = mh_msg_save_hcache,
   .tags_edit        = NULL,
   .tags_commit      = NULL,
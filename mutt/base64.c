@@ -31,6 +31,7 @@
  */
 
 #include "config.h"
+#include <string.h>
 #include "base64.h"
 #include "buffer.h"
 #include "memory.h"
@@ -165,6 +166,50 @@ size_t mutt_b64_encode_urlsafe(const char *in, size_t inlen, char *out, size_t o
   return b64_encode(in, inlen, out, outlen, B64CharsUrlSafe);
 }
 
+/**
+ * mutt_b64_decode_quads - Decode complete groups of four base64 characters
+ * @param[in]  in   Input buffer of base64 characters
+ * @param[in]  len  Length of the input buffer
+ * @param[out] out  Output buffer for the raw bytes
+ * @param[in]  olen Length of the output buffer
+ * @param[out] used Number of input characters consumed
+ * @retval num Bytes written
+ *
+ * Decode as many whole groups of four characters as possible, three bytes at
+ * a time.  Decoding stops at the first group that contains padding ('='), a
+ * non-base64 character or the end of the input, or when there's no room for
+ * another three bytes.  The caller must deal with what's left over.
+ */
+size_t mutt_b64_decode_quads(const char *in, size_t len, char *out, size_t olen, size_t *used)
+{
+  const unsigned char *inu = (const unsigned char *) in;
+  const unsigned char *end = inu + (len & ~(size_t) 3);
+  size_t n = 0;
+
+  while ((inu < end) && ((olen - n) >= 3))
+  {
+    if ((inu[0] | inu[1] | inu[2] | inu[3]) & 0x80)
+      break;
+
+    const int c1 = base64val(inu[0]);
+    const int c2 = base64val(inu[1]);
+    const int c3 = base64val(inu[2]);
+    const int c4 = base64val(inu[3]);
+    if ((c1 | c2 | c3 | c4) < 0)
+      break;
+
+    const unsigned int triple = (c1 << 18) | (c2 << 12) | (c3 << 6) | c4;
+    out[n++] = (triple >> 16) & 0xff;
+    out[n++] = (triple >> 8) & 0xff;
+    out[n++] = triple & 0xff;
+    inu += 4;
+  }
+
+  if (used)
+    *used = inu - (const unsigned char *) in;
+  return n;
+}
+
 /**
  * mutt_b64_decode - Convert NUL-terminated base64 string to raw bytes
  * @param in   Input  buffer for the NUL-terminated base64-encoded string
@@ -182,7 +227,11 @@ int mutt_b64_decode(const char *in, char *out, size_t olen)
   if (!in || !*in || !out)
     return -1;
 
-  int len = 0;
+  /* Decode the bulk of the string in one go, then finish off any padding */
+  size_t used = 0;
+  int len = mutt_b64_decode_quads(in, strlen(in), out, olen, &used);
+  in += used;
+  out += len;
 
   for (; *in; in += 4)
   {
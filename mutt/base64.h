@@ -32,6 +32,7 @@ extern const int Index64[];
 #define base64val(ch) Index64[(unsigned int) (ch)]
 
 int    mutt_b64_decode(const char *in, char *out, size_t olen);
+size_t mutt_b64_decode_quads(const char *in, size_t len, char *out, size_t olen, size_t *used);
 size_t mutt_b64_encode(const char *in, size_t inlen, char *out, size_t outlen);
 
 size_t mutt_b64_encode_urlsafe(const char *in, size_t inlen, char *out, size_t outlen);
@@ -300,15 +300,28 @@ bool buf_is_empty(const struct Buffer *buf)
  * buf_new - Allocate a new Buffer
  * @param str String to initialise the buffer with, can be NULL
  * @retval ptr Pointer to new buffer
+ *
+ * If a string is given, the Buffer is allocated to fit it exactly.
+ * Most such Buffers, e.g. the parts of an Address, are never changed and
+ * there may be hundreds of thousands of them.  The Buffer will grow as
+ * normal, if needed.
  */
 struct Buffer *buf_new(const char *str)
 {
   struct Buffer *buf = MUTT_MEM_CALLOC(1, struct Buffer);
 
   if (str)
-    buf_addstr(buf, str);
+  {
+    const size_t len = mutt_str_len(str);
+    buf->dsize = len + 1;
+    buf->data = MUTT_MEM_MALLOC(buf->dsize, char);
+    memcpy(buf->data, str, buf->dsize);
+    buf->dptr = buf->data + len;
+  }
   else
+  {
     buf_alloc(buf, 1);
+  }
   return buf;
 }
 
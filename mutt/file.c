@@ -974,6 +974,28 @@ void mutt_file_touch_atime(int fd)
 #endif
 }
 
+/**
+ * mutt_file_prefetch - Ask the kernel to start reading a file
+ * @param path Filename
+ *
+ * The file is read in the background, so that a later read doesn't wait.
+ * Silently ignored if posix_fadvise() isn't supported.
+ */
+void mutt_file_prefetch(const char *path)
+{
+#ifdef HAVE_POSIX_FADVISE
+  if (!path)
+    return;
+
+  int fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return;
+
+  posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+  close(fd);
+#endif
+}
+
 /**
  * mutt_file_touch - Make sure a file exists
  * @param path Filename
@@ -30,12 +30,33 @@
 
 #include "config.h"
 #include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
 #include "hash.h"
 #include "ctype2.h"
 #include "memory.h"
 #include "string2.h"
 
-#define SOME_PRIME 149711
+/// Number of HashElems to allocate at once
+#define HASH_BLOCK_SIZE 64
+
+/**
+ * hash_mix - Mix the bits of a hash
+ * @param hash Hash to mix
+ * @retval num Mixed hash
+ *
+ * Every bit of the input affects the low bits of the output, so they can be
+ * used as a bucket number.  This is the finaliser of MurmurHash3.
+ */
+static inline uint64_t hash_mix(uint64_t hash)
+{
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
 
 /**
  * gen_hash_string - Generate a hash from a string - Implements ::hash_gen_hash_t - @ingroup hash_gen_hash_api
@@ -44,16 +65,15 @@
  */
 static size_t gen_hash_string(union HashKey key, size_t num_elems)
 {
-  size_t hash = 0;
+  uint64_t hash = 0;
   const unsigned char *s = (const unsigned char *) key.strkey;
   if (!s)
     return 0;
 
   while (*s != '\0')
     hash += ((hash << 7) + *s++);
-  hash = (hash * SOME_PRIME) % num_elems;
 
-  return hash;
+  return hash_mix(hash) & (num_elems - 1);
 }
 
 /**
@@ -71,16 +91,15 @@ static int cmp_key_string(union HashKey a, union HashKey b)
  */
 static size_t gen_hash_case_string(union HashKey key, size_t num_elems)
 {
-  size_t hash = 0;
+  uint64_t hash = 0;
   const unsigned char *s = (const unsigned char *) key.strkey;
   if (!s)
     return 0;
 
   while (*s != '\0')
     hash += ((hash << 7) + mutt_tolower(*s++));
-  hash = (hash * SOME_PRIME) % num_elems;
 
-  return hash;
+  return hash_mix(hash) & (num_elems - 1);
 }
 
 /**
@@ -96,7 +115,7 @@ static int cmp_key_case_string(union HashKey a, union HashKey b)
  */
 static size_t gen_hash_int(union HashKey key, size_t num_elems)
 {
-  return (key.intkey % num_elems);
+  return hash_mix(key.intkey) & (num_elems - 1);
 }
 
 /**
@@ -116,19 +135,102 @@ static int cmp_key_int(union HashKey a, union HashKey b)
  * @param num_elems Number of elements it should contain
  * @retval ptr New Hash Table
  *
- * The Hash Table can contain more elements than num_elems, but they will be
- * chained together.
+ * The number of buckets is rounded up to a power of two.
+ * The Hash Table will grow if it contains more than num_elems elements.
  */
 static struct HashTable *hash_new(size_t num_elems)
 {
   struct HashTable *table = MUTT_MEM_CALLOC(1, struct HashTable);
-  if (num_elems == 0)
-    num_elems = 2;
-  table->num_elems = num_elems;
-  table->table = MUTT_MEM_CALLOC(num_elems, struct HashElem *);
+  size_t size = 2;
+  while (size < num_elems)
+    size <<= 1;
+  table->num_elems = size;
+  table->table = MUTT_MEM_CALLOC(size, struct HashElem *);
+  ARRAY_INIT(&table->blocks);
   return table;
 }
 
+/**
+ * hash_elem_new - Allocate a HashElem
+ * @param table Hash Table that will own the HashElem
+ * @retval ptr New HashElem
+ *
+ * HashElems are allocated in blocks, which are only freed with the Hash Table.
+ */
+static struct HashElem *hash_elem_new(struct HashTable *table)
+{
+  if (!table->spare)
+  {
+    struct HashElem *block = MUTT_MEM_CALLOC(HASH_BLOCK_SIZE, struct HashElem);
+    ARRAY_ADD(&table->blocks, block);
+    for (size_t i = 0; i < HASH_BLOCK_SIZE; i++)
+    {
+      block[i].next = table->spare;
+      table->spare = &block[i];
+    }
+  }
+
+  struct HashElem *he = table->spare;
+  table->spare = he->next;
+  he->next = NULL;
+  return he;
+}
+
+/**
+ * hash_elem_free - Release a HashElem
+ * @param table Hash Table that owns the HashElem
+ * @param he    HashElem to release
+ */
+static void hash_elem_free(struct HashTable *table, struct HashElem *he)
+{
+  memset(he, 0, sizeof(*he));
+  he->next = table->spare;
+  table->spare = he;
+}
+
+/**
+ * hash_grow - Double the number of buckets in a Hash Table
+ * @param table Hash Table to resize
+ *
+ * The HashElems don't move, so pointers to them stay valid.
+ * The elements of one old bucket are split between buckets `i` and
+ * `i + num_elems`, keeping their order, so sorted chains stay sorted.
+ */
+static void hash_grow(struct HashTable *table)
+{
+  const size_t old_size = table->num_elems;
+  const size_t new_size = old_size * 2;
+  struct HashElem **new_table = MUTT_MEM_CALLOC(new_size, struct HashElem *);
+
+  for (size_t i = 0; i < old_size; i++)
+  {
+    struct HashElem **tail_lo = &new_table[i];
+    struct HashElem **tail_hi = &new_table[i + old_size];
+
+    struct HashElem *he = table->table[i];
+    while (he)
+    {
+      struct HashElem *next = he->next;
+      he->next = NULL;
+      if (table->gen_hash(he->key, new_size) == i)
+      {
+        *tail_lo = he;
+        tail_lo = &he->next;
+      }
+      else
+      {
+        *tail_hi = he;
+        tail_hi = &he->next;
+      }
+      he = next;
+    }
+  }
+
+  FREE(&table->table);
+  table->table = new_table;
+  table->num_elems = new_size;
+}
+
 /**
  * union_hash_insert - Insert into a hash table using a union as a key
  * @param table Hash Table to update
@@ -143,7 +245,7 @@ static struct HashElem *union_hash_insert(struct HashTable *table,
   if (!table)
     return NULL; // LCOV_EXCL_LINE
 
-  struct HashElem *he = MUTT_MEM_CALLOC(1, struct HashElem);
+  struct HashElem *he = hash_elem_new(table);
   size_t hash = table->gen_hash(key, table->num_elems);
   he->key = key;
   he->data = data;
@@ -163,7 +265,7 @@ static struct HashElem *union_hash_insert(struct HashTable *table,
       const int rc = table->cmp_key(tmp->key, key);
       if (rc == 0)
       {
-        FREE(&he);
+        hash_elem_free(table, he);
         return NULL;
       }
       if (rc > 0)
@@ -175,6 +277,11 @@ static struct HashElem *union_hash_insert(struct HashTable *table,
       table->table[hash] = he;
     he->next = tmp;
   }
+
+  table->count++;
+  if (table->count > table->num_elems)
+    hash_grow(table);
+
   return he;
 }
 
@@ -239,7 +346,8 @@ static void union_hash_delete(struct HashTable *table, union HashKey key, const
         table->hdata_free(he->type, he->data, table->hdata);
       if (table->strdup_keys)
         FREE(&he->key.strkey);
-      FREE(&he);
+      hash_elem_free(table, he);
+      table->count--;
 
       he = *he_last;
     }
@@ -473,9 +581,16 @@ void mutt_hash_free(struct HashTable **ptr)
         table->hdata_free(tmp->type, tmp->data, table->hdata);
       if (table->strdup_keys)
         FREE(&tmp->key.strkey);
-      FREE(&tmp);
     }
   }
+
+  struct HashElem **bp = NULL;
+  ARRAY_FOREACH(bp, &table->blocks)
+  {
+    FREE(bp);
+  }
+  ARRAY_FREE(&table->blocks);
+
   FREE(&table->table);
   FREE(ptr);
 }
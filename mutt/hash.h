@@ -72,6 +72,8 @@ typedef void (*hash_hdata_free_t)(int type, void *obj, intptr_t data);
  *
  * Turn a Key (a string or an integer) into a hash id.
  * The hash id will be a number between 0 and (num_elems-1).
+ *
+ * @pre num_elems is a power of two
  */
 typedef size_t (*hash_gen_hash_t)(union HashKey key, size_t num_elems);
 
@@ -93,14 +95,18 @@ typedef int (*hash_cmp_key_t)(union HashKey a, union HashKey b);
 /**
  * struct HashTable - A Hash Table
  *
- * @note The number of actual elements in the HashTable isn't recorded.
+ * The number of buckets is a power of two.  It doubles whenever the Hash Table
+ * holds more elements than buckets.
  */
 struct HashTable
 {
   size_t num_elems;             ///< Number of buckets in the Hash Table
+  size_t count;                 ///< Number of elements in the Hash Table
   bool strdup_keys : 1;         ///< if set, the key->strkey is strdup()'d
   bool allow_dups  : 1;         ///< if set, duplicate keys are allowed
   struct HashElem **table;      ///< Array of Hash keys
+  struct HashElemArray blocks;  ///< Blocks of memory for the HashElems
+  struct HashElem *spare;       ///< Unused HashElems, linked by next
   hash_gen_hash_t gen_hash;     ///< Function to generate hash id from the key
   hash_cmp_key_t cmp_key;       ///< Function to compare two Hash keys
   intptr_t hdata;               ///< Data to pass to the hdata_free() function
@@ -117,6 +117,7 @@ static bool label_message(struct Mailbox *m, struct Email *e, char *new_label)
 
   e->changed = true;
   e->env->changed |= MUTT_ENV_CHANGED_XLABEL;
+  email_changed(e);
   return true;
 }
 
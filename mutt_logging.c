@@ -88,8 +88,8 @@ void mutt_clear_error(void)
 int log_disp_curses(time_t stamp, const char *file, int line, const char *function,
                     enum LogLevel level, const char *format, ...)
 {
-  const short c_debug_level = cs_subset_number(NeoMutt->sub, "debug_level");
-  if (level > c_debug_level)
+  static struct CachedConfig cc_debug_level = CACHED_CONFIG("debug_level");
+  if (level > cc_number(&cc_debug_level))
     return 0;
 
   char buf[LOG_LINE_MAX_LEN] = { 0 };
@@ -400,6 +400,8 @@ void mutt_draw_tree(struct ThreadsContext *tctx)
 
   struct MuttThread *tree = tctx->tree;
 
+  email_changed_all();
+
   /* Do the visibility calculations and free the old thread chars.
    * From now on we can simply ignore invisible subtrees */
   calculate_visibility(tree, &max_depth);
@@ -767,6 +769,74 @@ static int compare_threads(const void *a, const void *b, void *sdata)
   }
 }
 
+/**
+ * sort_siblings - Sort an array of sibling threads
+ * @param array Siblings, last sibling first
+ * @param num   Number of siblings
+ * @param init  If true, the siblings haven't been sorted before
+ * @param tctx  Threading context
+ *
+ * The siblings are sorted with compare_threads().
+ *
+ * Siblings keep their sorted order until a thread is inserted among them, or
+ * its sort keys change.  Those threads are marked with `sort_moved`.  If only
+ * a few have moved, e.g. when new mail arrives, then only they are sorted and
+ * then merged with the rest.
+ */
+static void sort_siblings(struct MuttThread **array, int num, bool init,
+                          struct ThreadsContext *tctx)
+{
+  int moved = 0;
+  if (!init)
+  {
+    for (int i = 0; i < num; i++)
+    {
+      if (array[i]->sort_moved)
+        moved++;
+    }
+  }
+
+  if (init || (moved > (num / 2)))
+  {
+    mutt_qsort_r((void *) array, num, sizeof(struct MuttThread *), compare_threads, tctx);
+  }
+  else if (moved > 0)
+  {
+    /* The array is backwards, so the unmoved threads are already in ascending
+     * order.  Keep them at the front and sort the moved ones separately. */
+    struct MuttThread **moved_array = MUTT_MEM_MALLOC(moved, struct MuttThread *);
+    int clean = 0;
+    int j = 0;
+    for (int i = 0; i < num; i++)
+    {
+      if (array[i]->sort_moved)
+        moved_array[j++] = array[i];
+      else
+        array[clean++] = array[i];
+    }
+
+    mutt_qsort_r((void *) moved_array, moved, sizeof(struct MuttThread *),
+                 compare_threads, tctx);
+
+    /* Merge from the end, so nothing is overwritten before it's used */
+    int out = num;
+    int ci = clean - 1;
+    int mi = moved - 1;
+    while (mi >= 0)
+    {
+      if ((ci >= 0) && (compare_threads(&array[ci], &moved_array[mi], tctx) > 0))
+        array[--out] = array[ci--];
+      else
+        array[--out] = moved_array[mi--];
+    }
+
+    FREE(&moved_array);
+  }
+
+  for (int i = 0; i < num; i++)
+    array[i]->sort_moved = false;
+}
+
 /**
  * mutt_sort_subthreads - Sort the children of a thread
  * @param tctx Threading context
@@ -815,6 +885,7 @@ static void mutt_sort_subthreads(struct ThreadsContext *tctx, bool init)
     {
       thread->sort_thread_key = NULL;
       thread->sort_aux_key = NULL;
+      thread->sort_moved = true;
 
       if (thread->parent)
         thread->parent->sort_children = true;
@@ -859,7 +930,7 @@ static void mutt_sort_subthreads(struct ThreadsContext *tctx, bool init)
           array[i] = thread;
         }
 
-        mutt_qsort_r((void *) array, i, sizeof(struct MuttThread *), compare_threads, tctx);
+        sort_siblings(array, i, init, tctx);
 
         /* attach them back together.  make thread the last sibling. */
         thread = array[0];
@@ -951,6 +1022,7 @@ static void mutt_sort_subthreads(struct ThreadsContext *tctx, bool init)
           if ((oldsort_aux_key != thread->sort_aux_key) ||
               (oldsort_thread_key != thread->sort_thread_key))
           {
+            thread->sort_moved = true;
             if (thread->parent)
               thread->parent->sort_children = true;
             else
@@ -1455,6 +1527,9 @@ int mutt_traverse_thread(struct Email *e_cur, MuttThreadFlags flag)
     return e_cur->vnum;
   }
 
+  if (flag & (MUTT_THREAD_COLLAPSE | MUTT_THREAD_UNCOLLAPSE))
+    email_changed_all();
+
   final = e_cur->vnum;
   thread = e_cur->thread;
   while (thread->parent)
@@ -1302,7 +1302,11 @@ int mx_tags_commit(struct Mailbox *m, struct Email *e, const char *tags)
     return -1;
 
   if (m->mx_ops->tags_commit)
-    return m->mx_ops->tags_commit(m, e, tags);
+  {
+    const int rc = m->mx_ops->tags_commit(m, e, tags);
+    email_changed(e);
+    return rc;
+  }
 
   mutt_message(_("Folder doesn't support tagging, aborting"));
   return -1;
@@ -1515,6 +1519,21 @@ int mx_msg_padding_size(struct Mailbox *m)
   return m->mx_ops->msg_padding_size(m);
 }
 
+/**
+ * mx_msg_prefetch - Start reading a message in the background - Wrapper for MxOps::msg_prefetch()
+ * @param m Mailbox
+ * @param e Email
+ *
+ * Backends that can't do anything useful here don't implement it.
+ */
+void mx_msg_prefetch(struct Mailbox *m, struct Email *e)
+{
+  if (!m || !e || !m->mx_ops || !m->mx_ops->msg_prefetch)
+    return;
+
+  m->mx_ops->msg_prefetch(m, e);
+}
+
 /**
  * mx_ac_find - Find the Account owning a Mailbox
  * @param m Mailbox
@@ -1547,6 +1547,7 @@ static enum MxStatus check_mailbox(struct Mailbox *m)
       first = mdata->last_message - c_nntp_context + 1;
     messages = MUTT_MEM_CALLOC(mdata->last_loaded - first + 1, unsigned char);
     hc = nntp_hcache_open(mdata);
+    hcache_begin_batch(hc);
     nntp_hcache_update(mdata, hc);
 #endif
 
@@ -1664,6 +1665,7 @@ static enum MxStatus check_mailbox(struct Mailbox *m)
     if (!hc)
     {
       hc = nntp_hcache_open(mdata);
+      hcache_begin_batch(hc);
       nntp_hcache_update(mdata, hc);
     }
 #endif
@@ -2574,6 +2576,7 @@ static enum MxStatus nntp_mbox_sync(struct Mailbox *m)
 #ifdef USE_HCACHE
   mdata->last_cached = 0;
   struct HeaderCache *hc = nntp_hcache_open(mdata);
+  hcache_begin_batch(hc);
 #endif
 
   for (int i = 0; i < m->msg_count; i++)
@@ -2823,6 +2826,7 @@ const struct MxOps MxNntpOps = {
   .msg_commit       = NULL,
   .msg_close        = nntp_msg_close,
   .msg_padding_size = NULL,
+  .msg_prefetch     = NULL,
   .msg_save_hcache  = NULL,
   .tags_edit        = NULL,
   .tags_commit      = NULL,
@@ -512,7 +512,7 @@ static int update_email_tags(struct Email *e, notmuch_message_t *msg)
   buf_pool_release(&old_tags);
 
   /* new version */
-  driver_tags_replace(&e->tags, buf_string(new_tags));
+  email_tags_replace(e, buf_string(new_tags));
   buf_reset(new_tags);
 
   driver_tags_get_transformed(&e->tags, new_tags);
@@ -2515,6 +2515,7 @@ const struct MxOps MxNotmuchOps = {
   .msg_commit       = nm_msg_commit,
   .msg_close        = nm_msg_close,
   .msg_padding_size = NULL,
+  .msg_prefetch     = NULL,
   .msg_save_hcache  = NULL,
   .tags_edit        = nm_tags_edit,
   .tags_commit      = nm_tags_commit,
@@ -92,9 +92,7 @@ static bool eat_regex(struct Pattern *pat, PatternCompFlags flags,
   else
   {
     pat->p.regex = MUTT_MEM_CALLOC(1, regex_t);
-#ifdef USE_DEBUG_GRAPHVIZ
     pat->raw_pattern = buf_strdup(token);
-#endif
     uint16_t case_flags = mutt_mb_is_lower(token->data) ? REG_ICASE : 0;
     int rc2 = REG_COMP(pat->p.regex, token->data, REG_NEWLINE | REG_NOSUB | case_flags);
     if (rc2 != 0)
@@ -105,6 +103,10 @@ static bool eat_regex(struct Pattern *pat, PatternCompFlags flags,
       FREE(&pat->p.regex);
       goto out;
     }
+
+    /* A regex without any special characters just looks for that text */
+    if (!strpbrk(token->data, "\\.[]()*+?{}|^$"))
+      pat->literal = buf_strdup(token);
   }
 
   rc = true;
@@ -802,9 +804,9 @@ void mutt_pattern_free(struct PatternList **pat)
       FREE(&np->p.regex);
     }
 
-#ifdef USE_DEBUG_GRAPHVIZ
+    FREE(&np->literal);
     FREE(&np->raw_pattern);
-#endif
+    pattern_rule_release(np);
     mutt_pattern_free(&np->child);
     FREE(&np);
 
@@ -1006,7 +1008,7 @@ struct PatternList *mutt_pattern_comp(struct MailboxView *mv, const char *s,
           is_alias = false;
           /* compile the sub-expression */
           buf = mutt_strn_dup(ps->dptr + 1, p - (ps->dptr + 1));
-          leaf->child = mutt_pattern_comp(mv, buf, flags, err);
+          leaf->child = mutt_pattern_comp(mv, buf, flags & ~MUTT_PC_RULE, err);
           if (!leaf->child)
           {
             FREE(&buf);
@@ -1098,7 +1100,7 @@ struct PatternList *mutt_pattern_comp(struct MailboxView *mv, const char *s,
         }
         /* compile the sub-expression */
         buf = mutt_strn_dup(ps->dptr + 1, p - (ps->dptr + 1));
-        struct PatternList *sub = mutt_pattern_comp(mv, buf, flags, err);
+        struct PatternList *sub = mutt_pattern_comp(mv, buf, flags & ~MUTT_PC_RULE, err);
         FREE(&buf);
         if (!sub)
           goto cleanup;
@@ -1142,6 +1144,9 @@ struct PatternList *mutt_pattern_comp(struct MailboxView *mv, const char *s,
     root->op = pat_or ? MUTT_PAT_OR : MUTT_PAT_AND;
   }
 
+  if (flags & MUTT_PC_RULE)
+    pattern_rule_prepare(curlist);
+
   return curlist;
 
 cleanup:
@@ -69,10 +69,30 @@ static struct ConfigDef PatternVars[] = {
   // clang-format on
 };
 
+#if defined(USE_HCACHE)
+/**
+ * PatternVarsHcache - Config definitions for the pattern library's search index
+ */
+static struct ConfigDef PatternVarsHcache[] = {
+  // clang-format off
+  { "search_index", DT_BOOL, false, 0, NULL,
+    "Remember the text of searched messages in the header cache"
+  },
+  { NULL },
+  // clang-format on
+};
+#endif
+
 /**
  * config_init_pattern - Register pattern config variables - Implements ::module_init_config_t - @ingroup cfg_module_api
  */
 bool config_init_pattern(struct ConfigSet *cs)
 {
-  return cs_register_variables(cs, PatternVars);
+  bool rc = cs_register_variables(cs, PatternVars);
+
+#if defined(USE_HCACHE)
+  rc |= cs_register_variables(cs, PatternVarsHcache);
+#endif
+
+  return rc;
 }
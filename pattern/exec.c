@@ -55,6 +55,7 @@
 #include "handler.h"
 #include "maillist.h"
 #include "mx.h"
+#include "search_index.h"
 #ifndef USE_FMEMOPEN
 #include <sys/stat.h>
 #endif
@@ -105,13 +106,18 @@ static void print_crypt_pattern_op_error(int op)
 
 /**
  * msg_search - Search an email
- * @param pat   Pattern to find
+ * @param pat Pattern to find
+ * @param m   Mailbox
  * @param e   Email
  * @param msg Message
  * @retval true Pattern found
  * @retval false Error or pattern not found
+ *
+ * If the message isn't in the search index, all of it is read, so that it can
+ * be added.
  */
-static bool msg_search(struct Pattern *pat, struct Email *e, struct Message *msg)
+static bool msg_search(struct Pattern *pat, struct Mailbox *m, struct Email *e,
+                       struct Message *msg)
 {
   ASSERT(msg);
 
@@ -128,8 +134,8 @@ static bool msg_search(struct Pattern *pat, struct Email *e, struct Message *msg
 
   const bool needs_head = (pat->op == MUTT_PAT_HEADER) || (pat->op == MUTT_PAT_WHOLE_MSG);
   const bool needs_body = (pat->op == MUTT_PAT_BODY) || (pat->op == MUTT_PAT_WHOLE_MSG);
-  const bool c_thorough_search = cs_subset_bool(NeoMutt->sub, "thorough_search");
-  if (c_thorough_search)
+  static struct CachedConfig cc_thorough_search = CACHED_CONFIG("thorough_search");
+  if (cc_bool(&cc_thorough_search))
   {
     /* decode the header / body */
     struct State state = { 0 };
@@ -266,23 +272,28 @@ static bool msg_search(struct Pattern *pat, struct Email *e, struct Message *msg
   }
   else
   {
+    struct SearchSig *sig = search_sig_new(m, e, pat);
     char buf[1024] = { 0 };
     while (len > 0)
     {
       if (!fgets(buf, sizeof(buf), fp))
       {
+        search_sig_free(&sig); /* incomplete */
         break; /* don't loop forever */
       }
       len -= mutt_str_len(buf);
-      if (patmatch(pat, buf))
+      search_sig_add_line(sig, buf);
+      if (!match && patmatch(pat, buf))
       {
         match = true;
-        break;
+        if (!sig)
+          break;
       }
     }
+    search_sig_store(&sig);
   }
 
-  if (c_thorough_search)
+  if (cc_bool(&cc_thorough_search))
     mutt_file_fclose(&fp);
 
 #ifdef USE_FMEMOPEN
@@ -680,39 +691,6 @@ static bool match_update_dynamic_date(struct Pattern *pat)
   return rc;
 }
 
-/**
- * set_pattern_cache_value - Sets a value in the PatternCache cache entry
- * @param cache_entry Cache entry to update
- * @param value       Value to set
- *
- * Normalizes the "true" value to 2.
- */
-static void set_pattern_cache_value(int *cache_entry, int value)
-{
-  *cache_entry = (value != 0) ? 2 : 1;
-}
-
-/**
- * get_pattern_cache_value - Get pattern cache value
- * @param cache_entry Cache entry to get
- * @retval 1 The cache value is set and has a true value
- * @retval 0 otherwise (even if unset!)
- */
-static bool get_pattern_cache_value(int cache_entry)
-{
-  return cache_entry == 2;
-}
-
-/**
- * is_pattern_cache_set - Is a given Pattern cached?
- * @param cache_entry Cache entry to check
- * @retval true Pattern is cached
- */
-static int is_pattern_cache_set(int cache_entry)
-{
-  return cache_entry != 0;
-}
-
 /**
  * msg_search_sendmode - Search in send-mode
  * @param e   Email to search
@@ -796,7 +774,7 @@ static int msg_search_sendmode(struct Email *e, struct Pattern *pat)
  * @retval true The pattern needs a full message
  * @retval false The pattern does not need a full message
  */
-static bool pattern_needs_msg(const struct Mailbox *m, const struct Pattern *pat)
+bool pattern_needs_msg(const struct Mailbox *m, const struct Pattern *pat)
 {
   if (!m)
   {
@@ -829,7 +807,7 @@ static bool pattern_needs_msg(const struct Mailbox *m, const struct Pattern *pat
 }
 
 /**
- * pattern_exec - Match a pattern against an email header
+ * pattern_exec_op - Match a pattern against an email header
  * @param pat   Pattern to match
  * @param flags Flags, e.g. #MUTT_MATCH_FULL_ADDRESS
  * @param m     Mailbox
@@ -838,14 +816,10 @@ static bool pattern_needs_msg(const struct Mailbox *m, const struct Pattern *pat
  * @param cache Cache for common Patterns
  * @retval true Success, pattern matched
  * @retval false Pattern did not match
- *
- * flags: MUTT_MATCH_FULL_ADDRESS: match both personal and machine address
- * cache: For repeated matches against the same Header, passing in non-NULL will
- *        store some of the cacheable pattern matches in this structure.
  */
-static bool pattern_exec(struct Pattern *pat, PatternExecFlags flags,
-                         struct Mailbox *m, struct Email *e,
-                         struct Message *msg, struct PatternCache *cache)
+static bool pattern_exec_op(struct Pattern *pat, PatternExecFlags flags,
+                            struct Mailbox *m, struct Email *e,
+                            struct Message *msg, struct PatternCache *cache)
 {
   switch (pat->op)
   {
@@ -910,7 +884,7 @@ static bool pattern_exec(struct Pattern *pat, PatternExecFlags flags,
       /* IMAP search sets e->matched at search compile time */
       if ((m->type == MUTT_IMAP) && pat->string_match)
         return e->matched;
-      return pat->pat_not ^ msg_search(pat, e, msg);
+      return pat->pat_not ^ msg_search(pat, m, e, msg);
     case MUTT_PAT_SERVERSEARCH:
       if (!m)
         return false;
@@ -977,94 +951,22 @@ static bool pattern_exec(struct Pattern *pat, PatternExecFlags flags,
       return pat->pat_not ^ match_addrlist(pat, (flags & MUTT_MATCH_FULL_ADDRESS), 3,
                                            &e->env->to, &e->env->cc, &e->env->bcc);
     case MUTT_PAT_LIST: /* known list, subscribed or not */
-    {
       if (!e->env)
         return false;
-
-      bool result;
-      if (cache)
-      {
-        int *cache_entry = pat->all_addr ? &cache->list_all : &cache->list_one;
-        if (!is_pattern_cache_set(*cache_entry))
-        {
-          set_pattern_cache_value(cache_entry,
-                                  mutt_is_list_recipient(pat->all_addr, e->env));
-        }
-        result = get_pattern_cache_value(*cache_entry);
-      }
-      else
-      {
-        result = mutt_is_list_recipient(pat->all_addr, e->env);
-      }
-      return pat->pat_not ^ result;
-    }
+      return pat->pat_not ^ mutt_is_list_recipient(pat->all_addr, e->env);
     case MUTT_PAT_SUBSCRIBED_LIST:
-    {
       if (!e->env)
         return false;
-
-      bool result;
-      if (cache)
-      {
-        int *cache_entry = pat->all_addr ? &cache->sub_all : &cache->sub_one;
-        if (!is_pattern_cache_set(*cache_entry))
-        {
-          set_pattern_cache_value(cache_entry,
-                                  mutt_is_subscribed_list_recipient(pat->all_addr, e->env));
-        }
-        result = get_pattern_cache_value(*cache_entry);
-      }
-      else
-      {
-        result = mutt_is_subscribed_list_recipient(pat->all_addr, e->env);
-      }
-      return pat->pat_not ^ result;
-    }
+      return pat->pat_not ^ mutt_is_subscribed_list_recipient(pat->all_addr, e->env);
     case MUTT_PAT_PERSONAL_RECIP:
-    {
       if (!e->env)
         return false;
-
-      bool result;
-      if (cache)
-      {
-        int *cache_entry = pat->all_addr ? &cache->pers_recip_all : &cache->pers_recip_one;
-        if (!is_pattern_cache_set(*cache_entry))
-        {
-          set_pattern_cache_value(cache_entry,
-                                  match_user(pat->all_addr, 3, &e->env->to,
-                                             &e->env->cc, &e->env->bcc));
-        }
-        result = get_pattern_cache_value(*cache_entry);
-      }
-      else
-      {
-        result = match_user(pat->all_addr, 3, &e->env->to, &e->env->cc, &e->env->bcc);
-      }
-      return pat->pat_not ^ result;
-    }
+      return pat->pat_not ^
+             match_user(pat->all_addr, 3, &e->env->to, &e->env->cc, &e->env->bcc);
     case MUTT_PAT_PERSONAL_FROM:
-    {
       if (!e->env)
         return false;
-
-      bool result;
-      if (cache)
-      {
-        int *cache_entry = pat->all_addr ? &cache->pers_from_all : &cache->pers_from_one;
-        if (!is_pattern_cache_set(*cache_entry))
-        {
-          set_pattern_cache_value(cache_entry,
-                                  match_user(pat->all_addr, 1, &e->env->from));
-        }
-        result = get_pattern_cache_value(*cache_entry);
-      }
-      else
-      {
-        result = match_user(pat->all_addr, 1, &e->env->from);
-      }
-      return pat->pat_not ^ result;
-    }
+      return pat->pat_not ^ match_user(pat->all_addr, 1, &e->env->from);
     case MUTT_PAT_COLLAPSED:
       return pat->pat_not ^ (e->collapsed && e->num_hidden > 1);
     case MUTT_PAT_CRYPT_SIGN:
@@ -1132,6 +1034,96 @@ static bool pattern_exec(struct Pattern *pat, PatternExecFlags flags,
   return false;
 }
 
+/**
+ * pattern_exec - Match a pattern against an email header
+ * @param pat   Pattern to match
+ * @param flags Flags, e.g. #MUTT_MATCH_FULL_ADDRESS
+ * @param m     Mailbox
+ * @param e     Email
+ * @param msg   MEssage
+ * @param cache Cache for common Patterns
+ * @retval true Success, pattern matched
+ * @retval false Pattern did not match
+ *
+ * flags: MUTT_MATCH_FULL_ADDRESS: match both personal and machine address
+ * cache: For repeated matches against the same Header, passing in non-NULL will
+ *        share the results of rule Patterns, see #MUTT_PC_RULE
+ */
+static bool pattern_exec(struct Pattern *pat, PatternExecFlags flags,
+                         struct Mailbox *m, struct Email *e,
+                         struct Message *msg, struct PatternCache *cache)
+{
+  if (!cache || !pat->pred)
+    return pattern_exec_op(pat, flags, m, e, msg, cache);
+
+  bool result = false;
+  if (pattern_rule_get(pat, cache, &result))
+    return result;
+
+  result = pattern_exec_op(pat, flags, m, e, msg, cache);
+  pattern_rule_set(pat, cache, result);
+  return result;
+}
+
+/**
+ * pattern_exec_headers - Match a pattern without reading the message
+ * @param pat   Pattern to match
+ * @param flags Flags, e.g. #MUTT_MATCH_FULL_ADDRESS
+ * @param m     Mailbox
+ * @param e     Email
+ * @retval  1 Pattern matched
+ * @retval  0 Pattern did not match
+ * @retval -1 The message needs to be read to decide
+ *
+ * Only the cheap header predicates are evaluated.  If they decide the result,
+ * e.g. `~f jim ~b hello` for a message that isn't from jim, then the message
+ * doesn't need to be read.
+ */
+int pattern_exec_headers(struct Pattern *pat, PatternExecFlags flags,
+                         struct Mailbox *m, struct Email *e)
+{
+  switch (pat->op)
+  {
+    case MUTT_PAT_AND:
+    case MUTT_PAT_OR:
+    {
+      /* AND is decided by a false child, OR by a true one */
+      const int decider = (pat->op == MUTT_PAT_OR) ? 1 : 0;
+      int rc = !decider;
+      struct Pattern *p = NULL;
+      SLIST_FOREACH(p, pat->child, entries)
+      {
+        const int child = pattern_exec_headers(p, flags, m, e);
+        if (child == decider)
+        {
+          rc = decider;
+          break;
+        }
+        if (child < 0)
+          rc = -1;
+      }
+      if (rc < 0)
+        return -1;
+      return pat->pat_not ^ rc;
+    }
+
+    case MUTT_PAT_THREAD:
+    case MUTT_PAT_PARENT:
+    case MUTT_PAT_CHILDREN:
+      /* Don't read the other messages of the thread twice */
+      if (pattern_needs_msg(m, SLIST_FIRST(pat->child)))
+        return -1;
+      break;
+
+    default:
+      if (pattern_needs_msg(m, pat))
+        return -1;
+      break;
+  }
+
+  return pattern_exec_op(pat, flags, m, e, NULL, NULL);
+}
+
 /**
  * mutt_pattern_exec - Match a pattern against an email header
  * @param pat   Pattern to match
@@ -1150,6 +1142,15 @@ bool mutt_pattern_exec(struct Pattern *pat, PatternExecFlags flags,
                        struct Mailbox *m, struct Email *e, struct PatternCache *cache)
 {
   const bool needs_msg = pattern_needs_msg(m, pat);
+  if (needs_msg)
+  {
+    const int rc = pattern_exec_headers(pat, flags, m, e);
+    if (rc >= 0)
+      return rc;
+    if (search_index_rejects(m, e, pat))
+      return false;
+  }
+
   struct Message *msg = needs_msg ? mx_msg_open(m, e) : NULL;
   if (needs_msg && !msg)
   {
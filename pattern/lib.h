@@ -39,6 +39,7 @@
  * | pattern/message.c      | @subpage pattern_message      |
  * | pattern/pattern.c      | @subpage pattern_pattern      |
  * | pattern/pattern_data.c | @subpage pattern_pattern_data |
+ * | pattern/rules.c        | @subpage pattern_rules        |
  * | pattern/search_state.c | @subpage pattern_search_state |
  */
 
@@ -59,6 +60,7 @@ struct Envelope;
 struct Mailbox;
 struct MailboxView;
 struct Menu;
+struct RulePredicate;
 
 #define MUTT_ALIAS_SIMPLESEARCH "~f %s | ~t %s | ~c %s"
 
@@ -69,6 +71,7 @@ typedef uint8_t PatternCompFlags;           ///< Flags for mutt_pattern_comp(),
 #define MUTT_PC_FULL_MSG          (1 << 0)  ///< Enable body and header matching
 #define MUTT_PC_PATTERN_DYNAMIC   (1 << 1)  ///< Enable runtime date range evaluation
 #define MUTT_PC_SEND_MODE_SEARCH  (1 << 2)  ///< Allow send-mode body searching
+#define MUTT_PC_RULE              (1 << 3)  ///< Pattern is a rule, e.g. color, score, hook
 
 /**
  * struct Pattern - A simple (non-regex) pattern
@@ -94,9 +97,9 @@ struct Pattern
     char *str;                     ///< String, if string_match is set
     struct ListHead multi_cases;   ///< Multiple strings for ~I pattern
   } p;
-#ifdef USE_DEBUG_GRAPHVIZ
-  const char *raw_pattern;         ///< Raw pattern for generating graphs
-#endif
+  char *literal;                   ///< Plain text that the regex matches, if it's that simple
+  const char *raw_pattern;         ///< Raw regex, for sharing rules and generating graphs
+  struct RulePredicate *pred;      ///< Result shared with identical rules, see #MUTT_PC_RULE
   SLIST_ENTRY(Pattern) entries;    ///< Linked list
 };
 SLIST_HEAD(PatternList, Pattern);
@@ -109,20 +112,15 @@ typedef uint8_t PatternExecFlags;         ///< Flags for mutt_pattern_exec(), e.
  * struct PatternCache - Cache commonly-used patterns
  *
  * This is used when a message is repeatedly pattern matched against.
- * e.g. for color, scoring, hooks.  It caches a few of the potentially slow
- * operations.
- * Each entry has a value of 0 = unset, 1 = false, 2 = true
+ * e.g. for color, scoring, hooks.  The results of the Patterns compiled with
+ * #MUTT_PC_RULE are shared, so each distinct test is only run once.
+ *
+ * Use a zeroed PatternCache for each Email.  Zero it again to forget the
+ * results.
  */
 struct PatternCache
 {
-  int list_all;       ///< ^~l
-  int list_one;       ///<  ~l
-  int sub_all;        ///< ^~u
-  int sub_one;        ///<  ~u
-  int pers_recip_all; ///< ^~p
-  int pers_recip_one; ///<  ~p
-  int pers_from_all;  ///< ^~P
-  int pers_from_one;  ///<  ~P
+  unsigned int generation; ///< Tags the shared results, 0 = unset
 };
 
 /**
@@ -52,8 +52,11 @@
 #include "mview.h"
 #include "mx.h"
 #include "protos.h"
+#include "search_index.h"
 #include "search_state.h"
 
+#define PATTERN_PREFETCH 32 ///< Number of messages to read ahead when searching bodies
+
 /**
  * RangeRegexes - Set of Regexes for various range types
  *
@@ -297,6 +300,38 @@ bail:
   return rc;
 }
 
+/**
+ * prefetch_emails - Start reading the messages a pattern is about to search
+ * @param m         Mailbox
+ * @param pat       Pattern that will be searched for
+ * @param virt      If true, index by virtual number, otherwise by real number
+ * @param cur       Message that's about to be searched
+ * @param count     Number of messages
+ * @param prefetched Number of messages that have already been prefetched
+ * @retval num New count of prefetched messages
+ *
+ * Keep the next #PATTERN_PREFETCH messages in flight, so that the backend can
+ * read them while we search the earlier ones.  Messages whose headers decide
+ * the match, or that the search index has ruled out, won't be read, so they're
+ * skipped.
+ */
+static int prefetch_emails(struct Mailbox *m, struct Pattern *pat,
+                           bool virt, int cur, int count, int prefetched)
+{
+  const int end = MIN(cur + PATTERN_PREFETCH, count);
+
+  for (; prefetched < end; prefetched++)
+  {
+    struct Email *e = virt ? mutt_get_virt_email(m, prefetched) : m->emails[prefetched];
+    if (!e || (pattern_exec_headers(pat, MUTT_MATCH_FULL_ADDRESS, m, e) >= 0))
+      continue;
+    if (!search_index_rejects(m, e, pat))
+      mx_msg_prefetch(m, e);
+  }
+
+  return prefetched;
+}
+
 /**
  * mutt_pattern_func - Perform some Pattern matching
  * @param mv     Mailbox View
@@ -350,6 +385,11 @@ int mutt_pattern_func(struct MailboxView *mv, int op, char *prompt)
   if ((m->type == MUTT_IMAP) && (!imap_search(m, pat)))
     goto bail;
 
+  /* Searching the message bodies is dominated by reading the files */
+  const bool prefetch = !match_all && pattern_needs_msg(m, SLIST_FIRST(pat));
+  if (prefetch)
+    search_index_open(m);
+
   progress = progress_new(MUTT_PROGRESS_READ, (op == MUTT_LIMIT) ? m->msg_count : m->vcount);
   progress_set_message(progress, _("Executing command on matching messages..."));
 
@@ -359,6 +399,7 @@ int mutt_pattern_func(struct MailboxView *mv, int op, char *prompt)
     mv->vsize = 0;
     mv->collapsed = false;
     int padding = mx_msg_padding_size(m);
+    int prefetched = 0;
 
     for (int i = 0; i < m->msg_count; i++)
     {
@@ -366,6 +407,9 @@ int mutt_pattern_func(struct MailboxView *mv, int op, char *prompt)
       if (!e)
         break;
 
+      if (prefetch)
+        prefetched = prefetch_emails(m, SLIST_FIRST(pat), false, i, m->msg_count, prefetched);
+
       if (SigInt)
       {
         interrupted = true;
@@ -394,8 +438,13 @@ int mutt_pattern_func(struct MailboxView *mv, int op, char *prompt)
   }
   else
   {
+    int prefetched = 0;
+
     for (int i = 0; i < m->vcount; i++)
     {
+      if (prefetch)
+        prefetched = prefetch_emails(m, SLIST_FIRST(pat), true, i, m->vcount, prefetched);
+
       struct Email *e = mutt_get_virt_email(m, i);
       if (!e)
         continue;
@@ -426,6 +475,7 @@ int mutt_pattern_func(struct MailboxView *mv, int op, char *prompt)
       }
     }
   }
+  search_index_close();
   progress_free(&progress);
 
   mutt_clear_error();
@@ -540,6 +590,9 @@ int mutt_search_command(struct MailboxView *mv, struct Menu *menu, int cur,
   progress = progress_new(MUTT_PROGRESS_READ, m->vcount);
   progress_set_message(progress, _("Searching..."));
 
+  if (pattern_needs_msg(m, SLIST_FIRST(state->pattern)))
+    search_index_open(m);
+
   const bool c_wrap_search = cs_subset_bool(NeoMutt->sub, "wrap_search");
   for (int i = cur + incr, j = 0; j != m->vcount; j++)
   {
@@ -616,6 +669,7 @@ int mutt_search_command(struct MailboxView *mv, struct Menu *menu, int cur,
 
   mutt_error(_("Not found"));
 done:
+  search_index_close();
   progress_free(&progress);
   return rc;
 }
@@ -147,5 +147,12 @@ const struct PatternFlags *lookup_op(int op);
 const struct PatternFlags *lookup_tag(char tag);
 bool eval_date_minmax(struct Pattern *pat, const char *s, struct Buffer *err);
 bool eat_message_range(struct Pattern *pat, PatternCompFlags flags, struct Buffer *s, struct Buffer *err, struct MailboxView *mv);
+int  pattern_exec_headers(struct Pattern *pat, PatternExecFlags flags, struct Mailbox *m, struct Email *e);
+bool pattern_needs_msg(const struct Mailbox *m, const struct Pattern *pat);
+
+bool pattern_rule_get    (const struct Pattern *pat, struct PatternCache *cache, bool *result);
+void pattern_rule_prepare(struct PatternList *pl);
+void pattern_rule_release(struct Pattern *pat);
+void pattern_rule_set    (const struct Pattern *pat, struct PatternCache *cache, bool result);
 
 #endif /* MUTT_PATTERN_PRIVATE_H */
@@ -0,0 +1,329 @@
+/**
+ * @file
+ * Shared predicates for rule Patterns
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page pattern_rules Shared predicates for rule Patterns
+ *
+ * Colour, score and hook rules are matched against every Email, one rule after
+ * another.  Large configs repeat the same tests in many rules,
+ * e.g. `~f boss@example.com` or `~l`.
+ *
+ * When a Pattern is compiled with #MUTT_PC_RULE:
+ * - The operands of each AND/OR are sorted so that cheap tests run first
+ * - Each expensive test is linked to a RulePredicate, shared by all the
+ *   identical tests in all the rules
+ *
+ * The RulePredicate stores the last result, tagged with the generation of the
+ * PatternCache that calculated it.  The caller uses one PatternCache per Email,
+ * so each distinct test is run at most once per Email.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include "private.h"
+#include "mutt/lib.h"
+#include "lib.h"
+
+/**
+ * struct RulePredicate - A test shared by several rule Patterns
+ */
+struct RulePredicate
+{
+  char *key;               ///< Canonical form of the test, used for sharing
+  int refs;                ///< Number of Patterns using the test
+  unsigned int generation; ///< PatternCache generation of the result
+  bool result;             ///< Result of the test
+};
+
+/// Shared predicates: key -> RulePredicate
+static struct HashTable *RulePredicates = NULL;
+/// Last generation handed out to a PatternCache
+static unsigned int RuleGeneration = 0;
+
+/**
+ * pattern_cost - Estimate how expensive a Pattern is to evaluate
+ * @param pat Pattern
+ * @retval num Relative cost, 0 (cheap) to 4 (needs the message)
+ */
+static int pattern_cost(const struct Pattern *pat)
+{
+  switch (pat->op)
+  {
+    case MUTT_PAT_AND:
+    case MUTT_PAT_OR:
+    {
+      int cost = 0;
+      const struct Pattern *np = NULL;
+      SLIST_FOREACH(np, pat->child, entries)
+      {
+        cost = MAX(cost, pattern_cost(np));
+      }
+      return cost;
+    }
+
+    case MUTT_PAT_BODY:
+    case MUTT_PAT_HEADER:
+    case MUTT_PAT_WHOLE_MSG:
+    case MUTT_PAT_MIMEATTACH:
+    case MUTT_PAT_MIMETYPE:
+      return 4;
+
+    case MUTT_PAT_THREAD:
+    case MUTT_PAT_PARENT:
+    case MUTT_PAT_CHILDREN:
+      return 3;
+
+    case MUTT_PAT_SENDER:
+    case MUTT_PAT_FROM:
+    case MUTT_PAT_TO:
+    case MUTT_PAT_CC:
+    case MUTT_PAT_BCC:
+    case MUTT_PAT_ADDRESS:
+    case MUTT_PAT_RECIPIENT:
+    case MUTT_PAT_LIST:
+    case MUTT_PAT_SUBSCRIBED_LIST:
+    case MUTT_PAT_PERSONAL_RECIP:
+    case MUTT_PAT_PERSONAL_FROM:
+      return 2;
+
+    case MUTT_PAT_SUBJECT:
+    case MUTT_PAT_ID:
+    case MUTT_PAT_REFERENCE:
+    case MUTT_PAT_XLABEL:
+    case MUTT_PAT_DRIVER_TAGS:
+    case MUTT_PAT_HORMEL:
+    case MUTT_PAT_NEWSGROUPS:
+      return 1;
+
+    default:
+      return 0;
+  }
+}
+
+/**
+ * pattern_sort - Sort a list of Patterns, cheapest first
+ * @param pl List of Patterns
+ *
+ * The sort is stable, so Patterns of equal cost keep their order.
+ */
+static void pattern_sort(struct PatternList *pl)
+{
+  struct PatternList sorted = SLIST_HEAD_INITIALIZER(sorted);
+
+  struct Pattern *np = NULL;
+  while ((np = SLIST_FIRST(pl)))
+  {
+    SLIST_REMOVE_HEAD(pl, entries);
+    const int cost = pattern_cost(np);
+
+    struct Pattern *prev = NULL;
+    struct Pattern *cur = NULL;
+    SLIST_FOREACH(cur, &sorted, entries)
+    {
+      if (pattern_cost(cur) > cost)
+        break;
+      prev = cur;
+    }
+
+    if (prev)
+      SLIST_INSERT_AFTER(prev, np, entries);
+    else
+      SLIST_INSERT_HEAD(&sorted, np, entries);
+  }
+
+  SLIST_FIRST(pl) = SLIST_FIRST(&sorted);
+}
+
+/**
+ * pattern_key - Create the canonical form of a test
+ * @param pat Pattern
+ * @param buf Buffer for the result
+ * @retval true  The test can be shared
+ * @retval false The test is too cheap, or can't be shared
+ */
+static bool pattern_key(const struct Pattern *pat, struct Buffer *buf)
+{
+  if ((pattern_cost(pat) == 0) || pat->child || pat->is_multi || pat->dynamic)
+    return false;
+
+  const char *arg = "";
+  if (pat->string_match)
+    arg = pat->p.str;
+  else if (pat->group_match)
+    arg = pat->p.group ? pat->p.group->name : "";
+  else if (pat->raw_pattern)
+    arg = pat->raw_pattern;
+
+  buf_printf(buf, "%d:%d%d%d%d%d%d%d:%ld:%ld:%s", pat->op, pat->pat_not,
+             pat->all_addr, pat->string_match, pat->group_match, pat->ign_case,
+             pat->is_alias, pat->sendmode, pat->min, pat->max, NONULL(arg));
+  return true;
+}
+
+/**
+ * pattern_share - Link a Pattern to a shared RulePredicate
+ * @param pat Pattern
+ */
+static void pattern_share(struct Pattern *pat)
+{
+  if (pat->pred)
+    return;
+
+  struct Buffer *key = buf_pool_get();
+  if (!pattern_key(pat, key))
+    goto done;
+
+  if (!RulePredicates)
+  {
+    RulePredicates = mutt_hash_new(64, MUTT_HASH_NO_FLAGS);
+  }
+
+  struct RulePredicate *rp = mutt_hash_find(RulePredicates, buf_string(key));
+  if (!rp)
+  {
+    rp = MUTT_MEM_CALLOC(1, struct RulePredicate);
+    rp->key = buf_strdup(key);
+    mutt_hash_insert(RulePredicates, rp->key, rp);
+  }
+
+  rp->refs++;
+  pat->pred = rp;
+
+done:
+  buf_pool_release(&key);
+}
+
+/**
+ * pattern_rule_prepare - Prepare a Pattern to be used as a rule
+ * @param pl List of Patterns
+ *
+ * Sort the operands of AND and OR, cheapest first, and share the expensive
+ * tests with the other rules.
+ */
+void pattern_rule_prepare(struct PatternList *pl)
+{
+  if (!pl)
+    return;
+
+  struct Pattern *np = NULL;
+  SLIST_FOREACH(np, pl, entries)
+  {
+    if (np->child)
+    {
+      if ((np->op == MUTT_PAT_AND) || (np->op == MUTT_PAT_OR))
+        pattern_sort(np->child);
+      pattern_rule_prepare(np->child);
+    }
+    else
+    {
+      pattern_share(np);
+    }
+  }
+}
+
+/**
+ * pattern_rule_release - Release a Pattern's shared RulePredicate
+ * @param pat Pattern
+ */
+void pattern_rule_release(struct Pattern *pat)
+{
+  struct RulePredicate *rp = pat->pred;
+  if (!rp)
+    return;
+
+  pat->pred = NULL;
+  if (--rp->refs > 0)
+    return;
+
+  mutt_hash_delete(RulePredicates, rp->key, rp);
+  FREE(&rp->key);
+  FREE(&rp);
+
+  if (RulePredicates->count == 0)
+    mutt_hash_free(&RulePredicates);
+}
+
+/**
+ * cache_generation - Get the generation of a PatternCache
+ * @param cache Pattern cache
+ * @retval num Generation
+ */
+static unsigned int cache_generation(struct PatternCache *cache)
+{
+  if (cache->generation != 0)
+    return cache->generation;
+
+  if (++RuleGeneration == 0)
+  {
+    // Wrapped, so forget all the old results
+    if (RulePredicates)
+    {
+      struct HashWalkState state = { 0 };
+      struct HashElem *he = NULL;
+      while ((he = mutt_hash_walk(RulePredicates, &state)))
+      {
+        struct RulePredicate *rp = he->data;
+        rp->generation = 0;
+      }
+    }
+    RuleGeneration = 1;
+  }
+
+  cache->generation = RuleGeneration;
+  return cache->generation;
+}
+
+/**
+ * pattern_rule_get - Get the cached result of a shared test
+ * @param[in]  pat    Pattern
+ * @param[in]  cache  Pattern cache
+ * @param[out] result Cached result
+ * @retval true The result was cached
+ *
+ * @note Tests that aren't shared with another rule are never cached
+ */
+bool pattern_rule_get(const struct Pattern *pat, struct PatternCache *cache, bool *result)
+{
+  const struct RulePredicate *rp = pat->pred;
+  if ((rp->refs < 2) || (rp->generation != cache_generation(cache)))
+    return false;
+
+  *result = rp->result;
+  return true;
+}
+
+/**
+ * pattern_rule_set - Cache the result of a shared test
+ * @param pat    Pattern
+ * @param cache  Pattern cache
+ * @param result Result
+ */
+void pattern_rule_set(const struct Pattern *pat, struct PatternCache *cache, bool result)
+{
+  struct RulePredicate *rp = pat->pred;
+  if (rp->refs < 2)
+    return;
+
+  rp->generation = cache_generation(cache);
+  rp->result = result;
+}
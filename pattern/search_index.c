@@ -0,0 +1,745 @@
+/**
+ * @file
+ * Index of the text in each message, to speed up body searches
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page pattern_search_index Index of the text in each message
+ *
+ * Searching the bodies of messages, `~b` and `~B`, means reading every message
+ * in the mailbox.  To avoid that, NeoMutt can remember a "signature" of each
+ * message it has searched, in the header cache.
+ *
+ * The signature is a Bloom filter of the case-folded trigrams of the text that
+ * was searched.  If any trigram of a search string is missing from the filter,
+ * the message can't match and doesn't need to be opened.  False positives just
+ * mean that the message is read, as before.
+ *
+ * In a UTF-8 locale, trigrams are made of characters, otherwise only the ASCII
+ * characters are indexed.
+ *
+ * Signatures are created lazily, whenever a search reads a whole message.
+ * Building them when the headers are cached would mean reading the body of
+ * every message as the mailbox is opened, which the header cache exists to
+ * avoid.  They are checked against the size and identity of the message, so a
+ * changed message will be searched (and indexed) again.
+ *
+ * With $thorough_search, the searched text depends on how the message is
+ * decoded.  Signatures are also checked against a hash of the settings that
+ * affect that, e.g. $charset, `alternative_order` and the mailcap files.
+ *
+ * Only local mailboxes are indexed.  Encrypted and signed messages are never
+ * indexed.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <wchar.h>
+#include <wctype.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "search_index.h"
+#include "hcache/lib.h"
+#include "ncrypt/lib.h"
+#include "globals.h"
+#include "lib.h"
+#include "muttlib.h"
+
+/// Version of the signature format, change this if the layout changes
+#define SEARCH_SIG_VERSION 2
+
+/// Size (in bits) of the bitmap used while reading a message
+#define SEARCH_SIG_MAX_BITS (1 << 18)
+/// Smallest signature that will be stored
+#define SEARCH_SIG_MIN_BITS 64
+
+/// Starting value for str_hash()
+#define STR_HASH_INIT 2166136261U
+
+/**
+ * struct SearchSigHeader - Header stored in front of a signature
+ *
+ * The size and identity of the message are stored, so that a signature
+ * belonging to a different message, or a changed message, isn't trusted.
+ * Likewise, a signature made with different settings isn't trusted.
+ */
+struct SearchSigHeader
+{
+  uint32_t version;    ///< Format of the signature, #SEARCH_SIG_VERSION
+  uint32_t nbits;      ///< Number of bits in the signature, a power of two
+  int64_t hdr_len;     ///< Length of the message's header
+  int64_t body_len;    ///< Length of the message's body
+  int64_t date_sent;   ///< Date the message was sent
+  uint32_t msgid_hash; ///< Hash of the Message-Id
+  uint32_t settings;   ///< Hash of the settings, see search_settings_hash()
+};
+
+/**
+ * struct SearchSig - Signature being built while reading a message
+ */
+struct SearchSig
+{
+  struct SearchSigHeader hdr; ///< Identity of the message
+  char key[256];              ///< Header cache key
+  size_t keylen;              ///< Length of the key
+  size_t count;               ///< Number of bits set
+  unsigned char *bits;        ///< Bitmap of #SEARCH_SIG_MAX_BITS bits
+};
+
+/// Header cache of the indexed Mailbox
+static struct HeaderCache *SearchIndexHc = NULL;
+/// Mailbox that's currently indexed
+static struct Mailbox *SearchIndexMailbox = NULL;
+/// Hash of the settings the index was opened with
+static uint32_t SearchIndexSettings = 0;
+
+/// Config that changes the decoded ($thorough_search) text of a message
+static const char *const SearchIndexConfig[] = {
+  // clang-format off
+  "assumed_charset",
+  "charset",
+  "honor_disposition",
+  "implicit_auto_view",
+  "include_encrypted",
+  "include_only_first",
+  "mailcap_path",
+  "mailcap_sanitize",
+  "preferred_languages",
+  "reflow_space_quotes",
+  "reflow_text",
+  "reflow_wrap",
+  "show_multipart_alternative",
+  "text_flowed",
+  "weed",
+  NULL,
+  // clang-format on
+};
+
+/**
+ * trigram_hash - Hash a trigram
+ * @param a First character
+ * @param b Second character
+ * @param c Third character
+ * @retval num Hash
+ */
+static uint32_t trigram_hash(wchar_t a, wchar_t b, wchar_t c)
+{
+  uint32_t h = (uint32_t) a;
+  h = (h * 0x9e3779b1) ^ (uint32_t) b;
+  h = (h * 0x9e3779b1) ^ (uint32_t) c;
+
+  /* MurmurHash3 finaliser */
+  h ^= h >> 16;
+  h *= 0x85ebca6b;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35;
+  h ^= h >> 16;
+  return h;
+}
+
+/**
+ * ascii_lower - Lower-case an ASCII character
+ * @param ch Character
+ * @retval num Lower-case character
+ *
+ * Unlike tolower(), this doesn't depend on the locale.
+ */
+static unsigned char ascii_lower(unsigned char ch)
+{
+  return ((ch >= 'A') && (ch <= 'Z')) ? (ch + ('a' - 'A')) : ch;
+}
+
+/**
+ * fold_char - Fold the case of a character
+ * @param wc Character
+ * @retval num Folded character
+ *
+ * Characters that a case-insensitive match may treat as the same letter must
+ * fold to the same value, e.g. 'k' and KELVIN SIGN, or 'i' and dotless 'ı'.
+ * So, a character whose lower or upper case is ASCII folds to that letter.
+ */
+static wchar_t fold_char(wchar_t wc)
+{
+  if (wc < 0x80)
+    return ascii_lower(wc);
+
+  const wchar_t lower = towlower(wc);
+  if (lower < 0x80)
+    return ascii_lower(lower);
+
+  const wchar_t upper = towupper(wc);
+  if (upper < 0x80)
+    return ascii_lower(upper);
+
+  return towlower(upper);
+}
+
+/**
+ * next_char - Read the next character of some text, folding its case
+ * @param[in]  str Text
+ * @param[in]  len Length of the text
+ * @param[in]  mbs Conversion state
+ * @param[out] wc  Folded character, or 0 if it can't be indexed
+ * @retval num Number of bytes read
+ */
+static size_t next_char(const char *str, size_t len, mbstate_t *mbs, wchar_t *wc)
+{
+  const unsigned char ch = *str;
+  if (ch < 0x80)
+  {
+    *wc = ascii_lower(ch);
+    return 1;
+  }
+
+  *wc = 0;
+  if (!CharsetIsUtf8)
+    return 1;
+
+  wchar_t w = 0;
+  size_t k = mbrtowc(&w, str, len, mbs);
+  if ((k == ICONV_ILLEGAL_SEQ) || (k == ICONV_BUF_TOO_SMALL) || (k == 0))
+  {
+    memset(mbs, 0, sizeof(*mbs));
+    return 1;
+  }
+
+  *wc = fold_char(w);
+  return k;
+}
+
+/**
+ * str_hash - Add a string to a hash (FNV-1a)
+ * @param h   Hash so far
+ * @param str String to hash
+ * @retval num Hash
+ */
+static uint32_t str_hash(uint32_t h, const char *str)
+{
+  for (; str && *str; str++)
+  {
+    h ^= (unsigned char) *str;
+    h *= 16777619U;
+  }
+  return h;
+}
+
+/**
+ * sig_header_init - Describe an Email
+ * @param hdr Header to fill
+ * @param e   Email
+ */
+static void sig_header_init(struct SearchSigHeader *hdr, const struct Email *e)
+{
+  memset(hdr, 0, sizeof(*hdr));
+  hdr->version = SEARCH_SIG_VERSION;
+  hdr->hdr_len = e->body ? (e->body->offset - e->offset) : 0;
+  hdr->body_len = e->body ? e->body->length : 0;
+  hdr->date_sent = e->date_sent;
+  hdr->msgid_hash = str_hash(STR_HASH_INIT, e->env ? e->env->message_id : NULL);
+  hdr->settings = SearchIndexSettings;
+}
+
+/**
+ * search_settings_hash - Hash the settings that affect the searched text
+ * @retval num Hash
+ *
+ * The raw text of a message only depends on the locale, which decides how it's
+ * folded.  The decoded text also depends on the config, the MIME lists and the
+ * mailcap files, which choose and convert the parts.
+ */
+static uint32_t search_settings_hash(void)
+{
+  uint32_t h = str_hash(STR_HASH_INIT, CharsetIsUtf8 ? "utf-8" : "ascii");
+
+  const bool c_thorough_search = cs_subset_bool(NeoMutt->sub, "thorough_search");
+  if (!c_thorough_search)
+    return h;
+
+  struct Buffer *buf = buf_pool_get();
+  for (size_t i = 0; SearchIndexConfig[i]; i++)
+  {
+    buf_reset(buf);
+    cs_subset_str_string_get(NeoMutt->sub, SearchIndexConfig[i], buf);
+    h = str_hash(h, SearchIndexConfig[i]);
+    h = str_hash(h, "=");
+    h = str_hash(h, buf_string(buf));
+    h = str_hash(h, "\n");
+  }
+
+  struct ListHead *lists[] = { &AlternativeOrderList, &AutoViewList, &MimeLookupList };
+  for (size_t i = 0; i < countof(lists); i++)
+  {
+    struct ListNode *np = NULL;
+    STAILQ_FOREACH(np, lists[i], entries)
+    {
+      h = str_hash(h, np->data);
+      h = str_hash(h, ";");
+    }
+    h = str_hash(h, "\n");
+  }
+
+  /* The mailcap files decide how auto_view parts are converted */
+  const struct Slist *c_mailcap_path = cs_subset_slist(NeoMutt->sub, "mailcap_path");
+  if (c_mailcap_path)
+  {
+    struct ListNode *np = NULL;
+    STAILQ_FOREACH(np, &c_mailcap_path->head, entries)
+    {
+      buf_strcpy(buf, np->data);
+      buf_expand_path(buf);
+
+      struct stat st = { 0 };
+      if (stat(buf_string(buf), &st) != 0)
+        continue;
+
+      buf_printf(buf, "%lld/%lld", (long long) st.st_size, (long long) st.st_mtime);
+      h = str_hash(h, buf_string(buf));
+      h = str_hash(h, ";");
+    }
+  }
+
+  buf_pool_release(&buf);
+  return h;
+}
+
+/**
+ * sig_key - Generate the header cache key for an Email's signature
+ * @param m      Mailbox
+ * @param e      Email
+ * @param op     Pattern operator, #MUTT_PAT_BODY or #MUTT_PAT_WHOLE_MSG
+ * @param buf    Buffer for the key
+ * @param buflen Length of the buffer
+ * @retval num Length of the key
+ * @retval 0   Error
+ *
+ * Searches of the decoded and raw text ($thorough_search) are kept apart.
+ */
+static size_t sig_key(const struct Mailbox *m, const struct Email *e, short op,
+                      char *buf, size_t buflen)
+{
+  const bool c_thorough_search = cs_subset_bool(NeoMutt->sub, "thorough_search");
+  const char kind = (op == MUTT_PAT_BODY) ? 'b' : 'B';
+  const char mode = c_thorough_search ? 't' : 'r';
+  int len = 0;
+
+  switch (m->type)
+  {
+    case MUTT_MAILDIR:
+    {
+      /* Maildir filenames change with the flags, so just use the unique part */
+      if (!e->path)
+        return 0;
+      const char *name = strrchr(e->path, '/');
+      name = name ? name + 1 : e->path;
+      len = snprintf(buf, buflen, "search/%c%c/%.*s", kind, mode,
+                     (int) strcspn(name, ":"), name);
+      break;
+    }
+    case MUTT_MH:
+      if (!e->path)
+        return 0;
+      len = snprintf(buf, buflen, "search/%c%c/%s", kind, mode, e->path);
+      break;
+    case MUTT_MBOX:
+    case MUTT_MMDF:
+      len = snprintf(buf, buflen, "search/%c%c/%lld", kind, mode, (long long) e->offset);
+      break;
+    default:
+      return 0;
+  }
+
+  if ((len < 0) || ((size_t) len >= buflen))
+    return 0;
+  return len;
+}
+
+/**
+ * sig_fetch - Fetch an Email's signature from the header cache
+ * @param[in]  m   Mailbox
+ * @param[in]  e   Email
+ * @param[in]  op  Pattern operator, #MUTT_PAT_BODY or #MUTT_PAT_WHOLE_MSG
+ * @param[out] hdr Header of the signature
+ * @retval ptr  Signature data (header, then bits), caller must free
+ * @retval NULL Not found, or doesn't belong to this Email
+ */
+static unsigned char *sig_fetch(struct Mailbox *m, struct Email *e, short op,
+                                struct SearchSigHeader *hdr)
+{
+  char key[256] = { 0 };
+  size_t keylen = sig_key(m, e, op, key, sizeof(key));
+  if (keylen == 0)
+    return NULL;
+
+  size_t dlen = 0;
+  unsigned char *data = hcache_fetch_raw_data(SearchIndexHc, key, keylen, &dlen);
+  if (!data)
+    return NULL;
+
+  struct SearchSigHeader want = { 0 };
+  sig_header_init(&want, e);
+
+  if (dlen < sizeof(*hdr))
+    goto bad;
+
+  memcpy(hdr, data, sizeof(*hdr));
+  want.nbits = hdr->nbits;
+  if ((memcmp(hdr, &want, sizeof(want)) != 0) || (hdr->nbits < SEARCH_SIG_MIN_BITS) ||
+      (hdr->nbits > SEARCH_SIG_MAX_BITS) || ((hdr->nbits & (hdr->nbits - 1)) != 0) ||
+      (dlen != (sizeof(*hdr) + (hdr->nbits / 8))))
+  {
+    goto bad;
+  }
+
+  return data;
+
+bad:
+  FREE(&data);
+  return NULL;
+}
+
+/**
+ * sig_rejects - Does a signature rule out a piece of text?
+ * @param hdr  Header of the signature
+ * @param bits Bits of the signature
+ * @param pat  Pattern to test
+ * @retval true The text can't be in the message
+ */
+static bool sig_rejects(const struct SearchSigHeader *hdr,
+                        const unsigned char *bits, const struct Pattern *pat)
+{
+  const char *lit = pat->string_match ? pat->p.str : pat->literal;
+  if (!lit)
+    return false;
+
+  /* Outside UTF-8, non-ASCII characters aren't indexed, but a case-insensitive
+   * regex may match these letters against them, e.g. 'i' against 'İ' */
+  const bool icase_regex = !CharsetIsUtf8 && !pat->string_match && mutt_mb_is_lower(lit);
+
+  const size_t len = mutt_str_len(lit);
+  mbstate_t mbs = { 0 };
+  wchar_t t[3] = { 0 };
+  int have = 0;
+  for (size_t i = 0; i < len;)
+  {
+    wchar_t wc = 0;
+    i += next_char(lit + i, len - i, &mbs, &wc);
+    if ((wc == 0) || (icase_regex && (wc < 0x80) && strchr("iks", wc)))
+    {
+      have = 0;
+      continue;
+    }
+
+    t[0] = t[1];
+    t[1] = t[2];
+    t[2] = wc;
+    if (have < 2)
+    {
+      have++;
+      continue;
+    }
+
+    uint32_t bit = trigram_hash(t[0], t[1], t[2]) & (hdr->nbits - 1);
+    if (!(bits[bit / 8] & (1 << (bit % 8))))
+      return true;
+  }
+
+  return false;
+}
+
+/**
+ * struct SigCache - Signatures of one Email, fetched on demand
+ */
+struct SigCache
+{
+  bool fetched[2];                ///< Has the signature been looked up?
+  unsigned char *data[2];         ///< Signature data, or NULL
+  struct SearchSigHeader hdr[2];  ///< Headers of the signatures
+};
+
+/**
+ * pattern_rejects - Can the signatures rule out a Pattern?
+ * @param m  Mailbox
+ * @param e  Email
+ * @param pat Pattern to test
+ * @param sc  Signatures of the Email
+ * @retval true The Pattern can't match the Email
+ */
+static bool pattern_rejects(struct Mailbox *m, struct Email *e,
+                            const struct Pattern *pat, struct SigCache *sc)
+{
+  if (pat->pat_not)
+    return false;
+
+  switch (pat->op)
+  {
+    case MUTT_PAT_AND:
+    {
+      struct Pattern *p = NULL;
+      SLIST_FOREACH(p, pat->child, entries)
+      {
+        if (pattern_rejects(m, e, p, sc))
+          return true;
+      }
+      return false;
+    }
+
+    case MUTT_PAT_OR:
+    {
+      struct Pattern *p = NULL;
+      SLIST_FOREACH(p, pat->child, entries)
+      {
+        if (!pattern_rejects(m, e, p, sc))
+          return false;
+      }
+      return true;
+    }
+
+    case MUTT_PAT_BODY:
+    case MUTT_PAT_WHOLE_MSG:
+    {
+      if (pat->sendmode || pat->is_multi || pat->group_match)
+        return false;
+
+      const int idx = (pat->op == MUTT_PAT_BODY) ? 0 : 1;
+      if (!sc->fetched[idx])
+      {
+        sc->data[idx] = sig_fetch(m, e, pat->op, &sc->hdr[idx]);
+        sc->fetched[idx] = true;
+      }
+      if (!sc->data[idx])
+        return false;
+
+      return sig_rejects(&sc->hdr[idx], sc->data[idx] + sizeof(struct SearchSigHeader), pat);
+    }
+
+    default:
+      return false;
+  }
+}
+
+/**
+ * search_index_rejects - Can the index rule out a Pattern?
+ * @param m   Mailbox
+ * @param e   Email
+ * @param pat Pattern to test
+ * @retval true The Pattern can't match the Email
+ *
+ * If this returns true, there's no need to read the message.
+ */
+bool search_index_rejects(struct Mailbox *m, struct Email *e, const struct Pattern *pat)
+{
+  if (!SearchIndexHc || (m != SearchIndexMailbox) || !e || !pat)
+    return false;
+
+  struct SigCache sc = { 0 };
+  const bool rc = pattern_rejects(m, e, pat, &sc);
+  FREE(&sc.data[0]);
+  FREE(&sc.data[1]);
+  return rc;
+}
+
+/**
+ * search_sig_new - Start indexing an Email
+ * @param m   Mailbox
+ * @param e   Email
+ * @param pat Pattern that's being searched for
+ * @retval ptr  New signature
+ * @retval NULL The Email doesn't need indexing
+ */
+struct SearchSig *search_sig_new(struct Mailbox *m, struct Email *e,
+                                 const struct Pattern *pat)
+{
+  if (!SearchIndexHc || (m != SearchIndexMailbox) || !e || !pat)
+    return NULL;
+  if ((pat->op != MUTT_PAT_BODY) && (pat->op != MUTT_PAT_WHOLE_MSG))
+    return NULL;
+
+  /* Don't leak the text of encrypted messages into the cache.
+   * The text of signed messages includes the result of the verification. */
+  if ((WithCrypto != 0) && (e->security & (SEC_ENCRYPT | SEC_SIGN)))
+    return NULL;
+
+  struct SearchSigHeader hdr = { 0 };
+  unsigned char *data = sig_fetch(m, e, pat->op, &hdr);
+  if (data)
+  {
+    FREE(&data);
+    return NULL;
+  }
+
+  struct SearchSig *sig = MUTT_MEM_CALLOC(1, struct SearchSig);
+  sig->keylen = sig_key(m, e, pat->op, sig->key, sizeof(sig->key));
+  if (sig->keylen == 0)
+  {
+    FREE(&sig);
+    return NULL;
+  }
+
+  sig_header_init(&sig->hdr, e);
+  sig->bits = MUTT_MEM_CALLOC(SEARCH_SIG_MAX_BITS / 8, unsigned char);
+  return sig;
+}
+
+/**
+ * search_sig_add_line - Add some text to a signature
+ * @param sig  Signature
+ * @param line Text that was searched
+ */
+void search_sig_add_line(struct SearchSig *sig, const char *line)
+{
+  if (!sig || !line)
+    return;
+
+  const size_t len = mutt_str_len(line);
+  mbstate_t mbs = { 0 };
+  wchar_t a = 0;
+  wchar_t b = 0;
+  int have = 0;
+  for (size_t i = 0; i < len;)
+  {
+    wchar_t c = 0;
+    i += next_char(line + i, len - i, &mbs, &c);
+    if (c == 0)
+    {
+      have = 0;
+      continue;
+    }
+
+    if (have == 2)
+    {
+      uint32_t bit = trigram_hash(a, b, c) & (SEARCH_SIG_MAX_BITS - 1);
+      unsigned char mask = (1 << (bit % 8));
+      if (!(sig->bits[bit / 8] & mask))
+      {
+        sig->bits[bit / 8] |= mask;
+        sig->count++;
+      }
+    }
+    else
+    {
+      have++;
+    }
+    a = b;
+    b = c;
+  }
+}
+
+/**
+ * search_sig_free - Free a signature
+ * @param ptr Signature to free
+ */
+void search_sig_free(struct SearchSig **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct SearchSig *sig = *ptr;
+  FREE(&sig->bits);
+  FREE(ptr);
+}
+
+/**
+ * search_sig_store - Save a signature to the header cache
+ * @param ptr Signature to save, will be freed
+ *
+ * The bitmap is folded to about four bits per trigram, to save space.
+ */
+void search_sig_store(struct SearchSig **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct SearchSig *sig = *ptr;
+  if (!SearchIndexHc)
+    goto done;
+
+  uint32_t nbits = SEARCH_SIG_MIN_BITS;
+  while ((nbits < SEARCH_SIG_MAX_BITS) && (nbits < (sig->count * 4)))
+    nbits *= 2;
+
+  const size_t nbytes = nbits / 8;
+  const size_t dlen = sizeof(sig->hdr) + nbytes;
+  unsigned char *data = MUTT_MEM_CALLOC(dlen, unsigned char);
+
+  sig->hdr.nbits = nbits;
+  memcpy(data, &sig->hdr, sizeof(sig->hdr));
+
+  unsigned char *bits = data + sizeof(sig->hdr);
+  for (size_t i = 0; i < (SEARCH_SIG_MAX_BITS / 8); i++)
+    bits[i & (nbytes - 1)] |= sig->bits[i];
+
+  hcache_store_raw(SearchIndexHc, sig->key, sig->keylen, data, dlen);
+  FREE(&data);
+
+done:
+  search_sig_free(ptr);
+}
+
+/**
+ * search_index_open - Open the index for a Mailbox
+ * @param m Mailbox
+ *
+ * The index is only used if $search_index and $header_cache are set, and the
+ * Mailbox is local.
+ *
+ * The index is kept in the Mailbox's header cache.  If the backend has it open,
+ * hcache_open() shares the backend's handle.
+ */
+void search_index_open(struct Mailbox *m)
+{
+  search_index_close();
+
+  if (!m)
+    return;
+
+  const bool c_search_index = cs_subset_bool(NeoMutt->sub, "search_index");
+  const char *const c_header_cache = cs_subset_path(NeoMutt->sub, "header_cache");
+  if (!c_search_index || !c_header_cache)
+    return;
+
+  if ((m->type != MUTT_MAILDIR) && (m->type != MUTT_MH) &&
+      (m->type != MUTT_MBOX) && (m->type != MUTT_MMDF))
+  {
+    return;
+  }
+
+  SearchIndexHc = hcache_open(c_header_cache, mailbox_path(m), NULL, true);
+  if (SearchIndexHc)
+  {
+    SearchIndexMailbox = m;
+    SearchIndexSettings = search_settings_hash();
+  }
+}
+
+/**
+ * search_index_close - Close the index
+ */
+void search_index_close(void)
+{
+  hcache_close(&SearchIndexHc);
+  SearchIndexMailbox = NULL;
+  SearchIndexSettings = 0;
+}
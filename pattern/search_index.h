@@ -0,0 +1,57 @@
+/**
+ * @file
+ * Index of the text in each message, to speed up body searches
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_PATTERN_SEARCH_INDEX_H
+#define MUTT_PATTERN_SEARCH_INDEX_H
+
+#include <stdbool.h>
+
+struct Email;
+struct Mailbox;
+struct Pattern;
+struct SearchSig;
+
+#ifdef USE_HCACHE
+
+void              search_index_close  (void);
+void              search_index_open   (struct Mailbox *m);
+bool              search_index_rejects(struct Mailbox *m, struct Email *e, const struct Pattern *pat);
+
+void              search_sig_add_line (struct SearchSig *sig, const char *line);
+void              search_sig_free     (struct SearchSig **ptr);
+struct SearchSig *search_sig_new      (struct Mailbox *m, struct Email *e, const struct Pattern *pat);
+void              search_sig_store    (struct SearchSig **ptr);
+
+#else
+
+static inline void              search_index_close  (void) {}
+static inline void              search_index_open   (struct Mailbox *m) {}
+static inline bool              search_index_rejects(struct Mailbox *m, struct Email *e, const struct Pattern *pat) { return false; }
+
+static inline void              search_sig_add_line (struct SearchSig *sig, const char *line) {}
+static inline void              search_sig_free     (struct SearchSig **ptr) {}
+static inline struct SearchSig *search_sig_new      (struct Mailbox *m, struct Email *e, const struct Pattern *pat) { return NULL; }
+static inline void              search_sig_store    (struct SearchSig **ptr) {}
+
+#endif
+
+#endif /* MUTT_PATTERN_SEARCH_INDEX_H */
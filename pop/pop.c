@@ -330,6 +330,7 @@ static int pop_fetch_headers(struct Mailbox *m)
 
 #ifdef USE_HCACHE
   struct HeaderCache *hc = pop_hcache_open(adata, mailbox_path(m));
+  hcache_begin_batch(hc);
 #endif
 
   adata->check_time = mutt_date_now();
@@ -881,6 +882,7 @@ static enum MxStatus pop_mbox_sync(struct Mailbox *m)
 
 #ifdef USE_HCACHE
     hc = pop_hcache_open(adata, mailbox_path(m));
+    hcache_begin_batch(hc);
 #endif
 
     struct Progress *progress = NULL;
@@ -1193,6 +1195,7 @@ const struct MxOps MxPopOps = {
   .msg_commit       = NULL,
   .msg_close        = pop_msg_close,
   .msg_padding_size = NULL,
+  .msg_prefetch     = NULL,
   .msg_save_hcache  = pop_msg_save_hcache,
   .tags_edit        = NULL,
   .tags_commit      = NULL,
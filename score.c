@@ -135,7 +135,7 @@ enum CommandResult parse_score(const struct Command *cmd, struct Buffer *line,
   else
   {
     struct MailboxView *mv_cur = get_current_mailbox_view();
-    struct PatternList *pat = mutt_pattern_comp(mv_cur, pattern, MUTT_PC_NO_FLAGS, err);
+    struct PatternList *pat = mutt_pattern_comp(mv_cur, pattern, MUTT_PC_RULE, err);
     if (!pat)
     {
       goto done;
@@ -182,6 +182,7 @@ void mutt_score_message(struct Mailbox *m, struct Email *e, bool upd_mbox)
 {
   struct Score *tmp = NULL;
   struct PatternCache cache = { 0 };
+  const int old_score = e->score;
 
   e->score = 0; /* in case of re-scoring */
   for (tmp = ScoreList; tmp; tmp = tmp->next)
@@ -198,10 +199,15 @@ void mutt_score_message(struct Mailbox *m, struct Email *e, bool upd_mbox)
   }
   if (e->score < 0)
     e->score = 0;
+  if (e->score != old_score)
+    email_changed(e);
 
-  const short c_score_threshold_delete = cs_subset_number(NeoMutt->sub, "score_threshold_delete");
-  const short c_score_threshold_flag = cs_subset_number(NeoMutt->sub, "score_threshold_flag");
-  const short c_score_threshold_read = cs_subset_number(NeoMutt->sub, "score_threshold_read");
+  static struct CachedConfig cc_score_threshold_delete = CACHED_CONFIG("score_threshold_delete");
+  static struct CachedConfig cc_score_threshold_flag = CACHED_CONFIG("score_threshold_flag");
+  static struct CachedConfig cc_score_threshold_read = CACHED_CONFIG("score_threshold_read");
+  const short c_score_threshold_delete = cc_number(&cc_score_threshold_delete);
+  const short c_score_threshold_flag = cc_number(&cc_score_threshold_flag);
+  const short c_score_threshold_read = cc_number(&cc_score_threshold_read);
 
   if (e->score <= c_score_threshold_delete)
     mutt_set_flag(m, e, MUTT_DELETE, true, upd_mbox);
@@ -508,6 +508,38 @@ out:
   return rc;
 }
 
+/**
+ * mutt_write_status - Write the Status: and X-Status: fields of an Email
+ * @param fp  File to write to
+ * @param e   Email
+ * @param pad If true, always write both fields, padded to two characters
+ *
+ * Padded fields are the same length, whatever the flags, so that they can be
+ * updated in place.
+ */
+void mutt_write_status(FILE *fp, const struct Email *e, bool pad)
+{
+  if (!fp || !e)
+    return;
+
+  if (e->old || e->read || pad)
+  {
+    const char *status = e->read ? "RO" : (e->old ? "O" : "");
+    fprintf(fp, "Status: %-*s\n", pad ? 2 : 0, status);
+  }
+
+  if (e->flagged || e->replied || pad)
+  {
+    char xstatus[3] = { 0 };
+    int len = 0;
+    if (e->replied)
+      xstatus[len++] = 'A';
+    if (e->flagged)
+      xstatus[len++] = 'F';
+    fprintf(fp, "X-Status: %-*s\n", pad ? 2 : 0, xstatus);
+  }
+}
+
 /**
  * mutt_write_references - Add the message references to a list
  * @param r    String List of references
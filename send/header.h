@@ -29,6 +29,7 @@
 
 struct Body;
 struct ConfigSubset;
+struct Email;
 struct Envelope;
 struct ListHead;
 
@@ -48,5 +49,6 @@ int  mutt_rfc822_write_header(FILE *fp, struct Envelope *env, struct Body *b, en
 int  mutt_write_mime_header  (struct Body *b, FILE *fp, struct ConfigSubset *sub);
 int  mutt_write_one_header   (FILE *fp, const char *tag, const char *value, const char *pfx, int wraplen, CopyHeaderFlags chflags, struct ConfigSubset *sub);
 void mutt_write_references   (const struct ListHead *r, FILE *fp, size_t trim);
+void mutt_write_status       (FILE *fp, const struct Email *e, bool pad);
 
 #endif /* MUTT_SEND_HEADER_H */
@@ -75,6 +75,8 @@
 #define SMTP_AUTH_UNAVAIL 1
 #define SMTP_AUTH_FAIL -1
 
+#define SMTP_WBUF_SIZE (64 * 1024) ///< Flush the write buffer beyond this size
+
 // clang-format off
 /**
  * typedef SmtpCapFlags - SMTP server capabilities
@@ -86,7 +88,9 @@ typedef uint8_t SmtpCapFlags;          ///< Flags, e.g. #SMTP_CAP_STARTTLS
 #define SMTP_CAP_DSN          (1 << 2) ///< Server supports Delivery Status Notification
 #define SMTP_CAP_EIGHTBITMIME (1 << 3) ///< Server supports 8-bit MIME content
 #define SMTP_CAP_SMTPUTF8     (1 << 4) ///< Server accepts UTF-8 strings
-#define SMTP_CAP_ALL         ((1 << 5) - 1)
+#define SMTP_CAP_PIPELINING   (1 << 5) ///< Server supports command pipelining (RFC2920)
+#define SMTP_CAP_CHUNKING     (1 << 6) ///< Server supports the BDAT command (RFC3030)
+#define SMTP_CAP_ALL         ((1 << 7) - 1)
 // clang-format on
 
 /**
@@ -99,6 +103,9 @@ struct SmtpAccountData
   struct Connection *conn;   ///< Server Connection
   struct ConfigSubset *sub;  ///< Config scope
   const char *fqdn;          ///< Fully-qualified domain name
+  struct Buffer *wbuf;       ///< Buffered output, sent by smtp_flush()
+  int wbuf_dbg;              ///< Log level of the buffered output, e.g. #MUTT_SOCK_LOG_CMD
+  int pending;               ///< Responses owed to pipelined commands
 };
 
 /**
@@ -131,17 +138,85 @@ static bool valid_smtp_code(char *buf, int *n)
   return (mutt_str_atoi(buf, n) - buf) <= 3;
 }
 
+/**
+ * smtp_flush - Send the buffered output to the SMTP server
+ * @param adata SMTP Account data
+ * @retval  0 Success
+ * @retval #SMTP_ERR_WRITE Write error
+ */
+static int smtp_flush(struct SmtpAccountData *adata)
+{
+  if (!adata->wbuf || buf_is_empty(adata->wbuf))
+    return 0;
+
+  const int rc = mutt_socket_write_d(adata->conn, buf_string(adata->wbuf),
+                                     buf_len(adata->wbuf), adata->wbuf_dbg);
+  buf_reset(adata->wbuf);
+  return (rc < 0) ? SMTP_ERR_WRITE : 0;
+}
+
+/**
+ * smtp_write - Queue data for the SMTP server
+ * @param adata SMTP Account data
+ * @param str   Data to send
+ * @param len   Length of data
+ * @param dbg   Debug level for logging, e.g. #MUTT_SOCK_LOG_CMD
+ * @retval  0 Success
+ * @retval #SMTP_ERR_WRITE Write error
+ *
+ * The data is collected in the write buffer, which is sent once it's full, or
+ * before the next response is read.  Large blocks bypass the buffer.
+ *
+ * The data is logged when it's sent.  Commands and message data are logged at
+ * different levels, so they're never sent together.
+ */
+static int smtp_write(struct SmtpAccountData *adata, const char *str, size_t len, int dbg)
+{
+  if ((dbg != adata->wbuf_dbg) && (smtp_flush(adata) != 0))
+    return SMTP_ERR_WRITE;
+
+  if (!adata->wbuf || (len >= SMTP_WBUF_SIZE))
+  {
+    if (smtp_flush(adata) != 0)
+      return SMTP_ERR_WRITE;
+    return (mutt_socket_write_d(adata->conn, str, len, dbg) < 0) ? SMTP_ERR_WRITE : 0;
+  }
+
+  adata->wbuf_dbg = dbg;
+  buf_addstr_n(adata->wbuf, str, len);
+  if (buf_len(adata->wbuf) >= SMTP_WBUF_SIZE)
+    return smtp_flush(adata);
+  return 0;
+}
+
+/**
+ * smtp_command - Queue a command for the SMTP server
+ * @param adata SMTP Account data
+ * @param cmd   Command, including the trailing CRLF
+ * @retval  0 Success
+ * @retval #SMTP_ERR_WRITE Write error
+ */
+static int smtp_command(struct SmtpAccountData *adata, const char *cmd)
+{
+  return smtp_write(adata, cmd, mutt_str_len(cmd), MUTT_SOCK_LOG_CMD);
+}
+
 /**
  * smtp_get_resp - Read a command response from the SMTP server
  * @param adata SMTP Account data
  * @retval  0 Success (2xx code) or continue (354 code)
  * @retval -1 Write error, or any other response code
+ *
+ * Any buffered output is sent first.
  */
 static int smtp_get_resp(struct SmtpAccountData *adata)
 {
   int n;
   char buf[1024] = { 0 };
 
+  if (smtp_flush(adata) != 0)
+    return SMTP_ERR_WRITE;
+
   do
   {
     n = mutt_socket_readln(buf, sizeof(buf), adata->conn);
@@ -175,6 +250,14 @@ static int smtp_get_resp(struct SmtpAccountData *adata)
     {
       adata->capabilities |= SMTP_CAP_SMTPUTF8;
     }
+    else if (mutt_istr_startswith(s, "PIPELINING"))
+    {
+      adata->capabilities |= SMTP_CAP_PIPELINING;
+    }
+    else if (mutt_istr_startswith(s, "CHUNKING"))
+    {
+      adata->capabilities |= SMTP_CAP_CHUNKING;
+    }
 
     if (!valid_smtp_code(buf, &n))
       return SMTP_ERR_CODE;
@@ -188,6 +271,48 @@ static int smtp_get_resp(struct SmtpAccountData *adata)
   return -1;
 }
 
+/**
+ * smtp_await_resp - Get the response to a command, now or later
+ * @param adata SMTP Account data
+ * @retval  0 Success, or response deferred
+ * @retval <0 Error, e.g. #SMTP_ERR_READ
+ *
+ * If the server supports pipelining, the response is collected later by
+ * smtp_pending_resp().
+ */
+static int smtp_await_resp(struct SmtpAccountData *adata)
+{
+  if (adata->capabilities & SMTP_CAP_PIPELINING)
+  {
+    adata->pending++;
+    return 0;
+  }
+
+  return smtp_get_resp(adata);
+}
+
+/**
+ * smtp_pending_resp - Read the responses to all the pipelined commands
+ * @param adata SMTP Account data
+ * @retval  0 Success
+ * @retval <0 Error, e.g. #SMTP_ERR_READ
+ */
+static int smtp_pending_resp(struct SmtpAccountData *adata)
+{
+  while (adata->pending > 0)
+  {
+    adata->pending--;
+    int rc = smtp_get_resp(adata);
+    if (rc != 0)
+    {
+      adata->pending = 0;
+      return rc;
+    }
+  }
+
+  return 0;
+}
+
 /**
  * smtp_rcpt_to - Set the recipient to an Address
  * @param adata SMTP Account data
@@ -220,9 +345,9 @@ static int smtp_rcpt_to(struct SmtpAccountData *adata, const struct AddressList
     {
       snprintf(buf, sizeof(buf), "RCPT TO:<%s>\r\n", buf_string(a->mailbox));
     }
-    if (mutt_socket_send(adata->conn, buf) == -1)
+    if (smtp_command(adata, buf) != 0)
       return SMTP_ERR_WRITE;
-    int rc = smtp_get_resp(adata);
+    int rc = smtp_await_resp(adata);
     if (rc != 0)
       return rc;
   }
@@ -230,6 +355,150 @@ static int smtp_rcpt_to(struct SmtpAccountData *adata, const struct AddressList
   return 0;
 }
 
+/**
+ * smtp_encode_body - Convert message text to the SMTP wire format
+ * @param[in]     src      Text to convert
+ * @param[in]     len      Length of the text
+ * @param[out]    dest     Buffer for the converted text
+ * @param[in,out] last     Last character converted, '\n' at the start
+ * @param[in]     dotstuff If true, double any leading dots (for DATA)
+ *
+ * Bare line feeds are turned into CRLF.  The state in @a last lets the text be
+ * converted in blocks.
+ */
+static void smtp_encode_body(const char *src, size_t len, struct Buffer *dest,
+                             char *last, bool dotstuff)
+{
+  char prev = *last;
+  size_t start = 0;
+
+  for (size_t i = 0; i < len; i++)
+  {
+    const char c = src[i];
+    if ((c == '\n') && (prev != '\r'))
+    {
+      buf_addstr_n(dest, src + start, i - start);
+      buf_addch(dest, '\r');
+      start = i;
+    }
+    else if (dotstuff && (c == '.') && (prev == '\n'))
+    {
+      buf_addstr_n(dest, src + start, i - start);
+      buf_addch(dest, '.');
+      start = i;
+    }
+    prev = c;
+  }
+
+  buf_addstr_n(dest, src + start, len - start);
+  *last = prev;
+}
+
+/**
+ * smtp_send_data - Send the message using the DATA command
+ * @param adata    SMTP Account data
+ * @param fp       Message to send
+ * @param progress Progress bar
+ * @retval  0 Success
+ * @retval <0 Error, e.g. #SMTP_ERR_WRITE
+ */
+static int smtp_send_data(struct SmtpAccountData *adata, FILE *fp, struct Progress *progress)
+{
+  if (smtp_command(adata, "DATA\r\n") != 0)
+    return SMTP_ERR_WRITE;
+  int rc = smtp_get_resp(adata);
+  if (rc != 0)
+    return rc;
+
+  char *block = MUTT_MEM_MALLOC(SMTP_WBUF_SIZE, char);
+  struct Buffer *data = buf_pool_get();
+  char last = '\n';
+  size_t len;
+
+  rc = SMTP_ERR_WRITE;
+  while ((len = fread(block, 1, SMTP_WBUF_SIZE, fp)) > 0)
+  {
+    buf_reset(data);
+    smtp_encode_body(block, len, data, &last, true);
+    if (smtp_write(adata, buf_string(data), buf_len(data), MUTT_SOCK_LOG_FULL) != 0)
+      goto done;
+    progress_update(progress, MAX(0, ftell(fp)), -1);
+  }
+
+  /* terminate the message body */
+  if ((last != '\n') && (smtp_write(adata, "\r\n", 2, MUTT_SOCK_LOG_FULL) != 0))
+    goto done;
+  if (smtp_command(adata, ".\r\n") != 0)
+    goto done;
+
+  rc = smtp_get_resp(adata);
+
+done:
+  buf_pool_release(&data);
+  FREE(&block);
+  return rc;
+}
+
+/**
+ * smtp_send_bdat - Send the message using the BDAT command
+ * @param adata    SMTP Account data
+ * @param fp       Message to send
+ * @param progress Progress bar
+ * @retval  0 Success
+ * @retval <0 Error, e.g. #SMTP_ERR_WRITE
+ *
+ * The message is sent in chunks, without dot-stuffing.  If the server supports
+ * pipelining, the responses are read after the last chunk.
+ */
+static int smtp_send_bdat(struct SmtpAccountData *adata, FILE *fp, struct Progress *progress)
+{
+  char *block = MUTT_MEM_MALLOC(SMTP_WBUF_SIZE, char);
+  struct Buffer *chunk = buf_pool_get();
+  char cmd[64] = { 0 };
+  char last = '\n';
+  size_t len;
+  int rc = SMTP_ERR_WRITE;
+
+  while ((len = fread(block, 1, SMTP_WBUF_SIZE, fp)) > 0)
+  {
+    smtp_encode_body(block, len, chunk, &last, false);
+    if (buf_len(chunk) < SMTP_WBUF_SIZE)
+      continue;
+
+    snprintf(cmd, sizeof(cmd), "BDAT %zu\r\n", buf_len(chunk));
+    if ((smtp_command(adata, cmd) != 0) ||
+        (smtp_write(adata, buf_string(chunk), buf_len(chunk), MUTT_SOCK_LOG_FULL) != 0))
+    {
+      goto done;
+    }
+    buf_reset(chunk);
+    rc = smtp_await_resp(adata);
+    if (rc != 0)
+      goto done;
+    rc = SMTP_ERR_WRITE;
+    progress_update(progress, MAX(0, ftell(fp)), -1);
+  }
+
+  if (last != '\n')
+    buf_addstr(chunk, "\r\n");
+
+  snprintf(cmd, sizeof(cmd), "BDAT %zu LAST\r\n", buf_len(chunk));
+  if ((smtp_command(adata, cmd) != 0) ||
+      (smtp_write(adata, buf_string(chunk), buf_len(chunk), MUTT_SOCK_LOG_FULL) != 0))
+  {
+    goto done;
+  }
+
+  rc = smtp_pending_resp(adata);
+  if (rc == 0)
+    rc = smtp_get_resp(adata);
+
+done:
+  buf_pool_release(&chunk);
+  FREE(&block);
+  return rc;
+}
+
 /**
  * smtp_data - Send data to an SMTP server
  * @param adata   SMTP Account data
@@ -239,12 +508,6 @@ static int smtp_rcpt_to(struct SmtpAccountData *adata, const struct AddressList
  */
 static int smtp_data(struct SmtpAccountData *adata, const char *msgfile)
 {
-  char buf[1024] = { 0 };
-  struct Progress *progress = NULL;
-  int rc = SMTP_ERR_WRITE;
-  int term = 0;
-  size_t buflen = 0;
-
   FILE *fp = mutt_file_fopen(msgfile, "r");
   if (!fp)
   {
@@ -258,59 +521,24 @@ static int smtp_data(struct SmtpAccountData *adata, const char *msgfile)
     return -1;
   }
   unlink(msgfile);
-  progress = progress_new(MUTT_PROGRESS_NET, size);
-  progress_set_message(progress, _("Sending message..."));
 
-  snprintf(buf, sizeof(buf), "DATA\r\n");
-  if (mutt_socket_send(adata->conn, buf) == -1)
-  {
-    mutt_file_fclose(&fp);
-    goto done;
-  }
-  rc = smtp_get_resp(adata);
+  /* Don't upload the message until the recipients have been accepted */
+  int rc = smtp_pending_resp(adata);
   if (rc != 0)
   {
     mutt_file_fclose(&fp);
-    goto done;
-  }
-
-  rc = SMTP_ERR_WRITE;
-  while (fgets(buf, sizeof(buf) - 1, fp))
-  {
-    buflen = mutt_str_len(buf);
-    term = buflen && buf[buflen - 1] == '\n';
-    if (term && ((buflen == 1) || (buf[buflen - 2] != '\r')))
-      snprintf(buf + buflen - 1, sizeof(buf) - buflen + 1, "\r\n");
-    if (buf[0] == '.')
-    {
-      if (mutt_socket_send_d(adata->conn, ".", MUTT_SOCK_LOG_FULL) == -1)
-      {
-        mutt_file_fclose(&fp);
-        goto done;
-      }
-    }
-    if (mutt_socket_send_d(adata->conn, buf, MUTT_SOCK_LOG_FULL) == -1)
-    {
-      mutt_file_fclose(&fp);
-      goto done;
-    }
-    progress_update(progress, MAX(0, ftell(fp)), -1);
-  }
-  if (!term && buflen &&
-      (mutt_socket_send_d(adata->conn, "\r\n", MUTT_SOCK_LOG_FULL) == -1))
-  {
-    mutt_file_fclose(&fp);
-    goto done;
+    return rc;
   }
-  mutt_file_fclose(&fp);
 
-  /* terminate the message body */
-  if (mutt_socket_send(adata->conn, ".\r\n") == -1)
-    goto done;
+  struct Progress *progress = progress_new(MUTT_PROGRESS_NET, size);
+  progress_set_message(progress, _("Sending message..."));
 
-  rc = smtp_get_resp(adata);
+  if (adata->capabilities & SMTP_CAP_CHUNKING)
+    rc = smtp_send_bdat(adata, fp, progress);
+  else
+    rc = smtp_send_data(adata, fp, progress);
 
-done:
+  mutt_file_fclose(&fp);
   progress_free(&progress);
   return rc;
 }
@@ -1139,6 +1367,7 @@ int mutt_smtp_send(const struct AddressList *from, const struct AddressList *to,
   const char *const c_dsn_return = cs_subset_string(adata.sub, "dsn_return");
 
   struct Buffer *buf = buf_pool_get();
+  adata.wbuf = buf_pool_get();
   do
   {
     /* send our greeting */
@@ -1162,12 +1391,12 @@ int mutt_smtp_send(const struct AddressList *from, const struct AddressList *to,
       buf_addstr(buf, " SMTPUTF8");
     }
     buf_addstr(buf, "\r\n");
-    if (mutt_socket_send(adata.conn, buf_string(buf)) == -1)
+    if (smtp_command(&adata, buf_string(buf)) != 0)
     {
       rc = SMTP_ERR_WRITE;
       break;
     }
-    rc = smtp_get_resp(&adata);
+    rc = smtp_await_resp(&adata);
     if (rc != 0)
       break;
 
@@ -1191,6 +1420,7 @@ int mutt_smtp_send(const struct AddressList *from, const struct AddressList *to,
   mutt_socket_close(adata.conn);
   FREE(&adata.conn);
   FREE(&adata.auth_mechs);
+  buf_pool_release(&adata.wbuf);
 
   if (rc == SMTP_ERR_READ)
     mutt_error(_("SMTP session failed: read error"));
@@ -250,6 +250,25 @@ static int store_bdb_delete_record(StoreHandle *store, const char *key, size_t k
   return sdata->db->del(sdata->db, NULL, &dkey, 0);
 }
 
+/**
+ * store_bdb_begin - Start a batch of changes - Implements StoreOps::begin() - @ingroup store_begin
+ *
+ * The database is opened without transaction support, so changes are written
+ * immediately.
+ */
+static int store_bdb_begin(StoreHandle *store)
+{
+  return store ? 0 : -1;
+}
+
+/**
+ * store_bdb_commit - Write a batch of changes - Implements StoreOps::commit() - @ingroup store_commit
+ */
+static int store_bdb_commit(StoreHandle *store)
+{
+  return store ? 0 : -1;
+}
+
 /**
  * store_bdb_close - Close a Store connection - Implements StoreOps::close() - @ingroup store_close
  */
@@ -131,6 +131,24 @@ static int store_gdbm_delete_record(StoreHandle *store, const char *key, size_t
   return gdbm_delete(db, dkey);
 }
 
+/**
+ * store_gdbm_begin - Start a batch of changes - Implements StoreOps::begin() - @ingroup store_begin
+ *
+ * GDBM doesn't have transactions, so changes are written immediately.
+ */
+static int store_gdbm_begin(StoreHandle *store)
+{
+  return store ? 0 : -1;
+}
+
+/**
+ * store_gdbm_commit - Write a batch of changes - Implements StoreOps::commit() - @ingroup store_commit
+ */
+static int store_gdbm_commit(StoreHandle *store)
+{
+  return store ? 0 : -1;
+}
+
 /**
  * store_gdbm_close - Close a Store connection - Implements StoreOps::close() - @ingroup store_close
  */
@@ -128,6 +128,43 @@ static int store_kyotocabinet_delete_record(StoreHandle *store, const char *key,
   return 0;
 }
 
+/**
+ * store_kyotocabinet_begin - Start a batch of changes - Implements StoreOps::begin() - @ingroup store_begin
+ */
+static int store_kyotocabinet_begin(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  KCDB *db = store;
+  /* The header cache can be rebuilt, so don't sync to disk */
+  if (!kcdbbegintran(db, false))
+  {
+    int ecode = kcdbecode(db);
+    return ecode ? ecode : -1;
+  }
+  return 0;
+}
+
+/**
+ * store_kyotocabinet_commit - Write a batch of changes - Implements StoreOps::commit() - @ingroup store_commit
+ */
+static int store_kyotocabinet_commit(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  KCDB *db = store;
+  if (!kcdbendtran(db, true))
+  {
+    int ecode = kcdbecode(db);
+    return ecode ? ecode : -1;
+  }
+  return 0;
+}
+
 /**
  * store_kyotocabinet_close - Close a Store connection - Implements StoreOps::close() - @ingroup store_close
  */
@@ -137,6 +137,32 @@ struct StoreOps
    */
   int (*delete_record)(StoreHandle *store, const char *key, size_t klen);
 
+  /**
+   * @defgroup store_begin begin()
+   * @ingroup store_api
+   *
+   * begin - Start a batch of changes
+   * @param[in] store Store retrieved via open()
+   * @retval 0   Success
+   * @retval num Error, a backend-specific error code
+   *
+   * Until commit() is called, the backend may hold back the changes made by
+   * store() and delete_record(), and write them in one go.
+   * fetch() will still see the changes.
+   */
+  int (*begin)(StoreHandle *store);
+
+  /**
+   * @defgroup store_commit commit()
+   * @ingroup store_api
+   *
+   * commit - Write a batch of changes
+   * @param[in] store Store retrieved via open()
+   * @retval 0   Success
+   * @retval num Error, a backend-specific error code
+   */
+  int (*commit)(StoreHandle *store);
+
   /**
    * @defgroup store_close close()
    * @ingroup store_api
@@ -168,6 +194,8 @@ bool                   store_is_valid_backend(const char *str);
     .free           = store_##_name##_free,                                    \
     .store          = store_##_name##_store,                                   \
     .delete_record  = store_##_name##_delete_record,                           \
+    .begin          = store_##_name##_begin,                                   \
+    .commit         = store_##_name##_commit,                                  \
     .close          = store_##_name##_close,                                   \
     .version        = store_##_name##_version,                                 \
   };
@@ -323,6 +323,50 @@ static int store_lmdb_delete_record(StoreHandle *store, const char *key, size_t
   return rc;
 }
 
+/**
+ * store_lmdb_begin - Start a batch of changes - Implements StoreOps::begin() - @ingroup store_begin
+ *
+ * Start the write transaction now, so that the whole batch, including any
+ * fetches, uses one transaction.
+ */
+static int store_lmdb_begin(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  struct LmdbStoreData *sdata = store;
+
+  int rc = lmdb_get_write_txn(sdata);
+  if (rc != MDB_SUCCESS)
+    mutt_debug(LL_DEBUG2, "lmdb_get_write_txn: %s\n", mdb_strerror(rc));
+
+  return rc;
+}
+
+/**
+ * store_lmdb_commit - Write a batch of changes - Implements StoreOps::commit() - @ingroup store_commit
+ */
+static int store_lmdb_commit(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  struct LmdbStoreData *sdata = store;
+
+  if (!sdata->txn || (sdata->txn_mode != TXN_WRITE))
+    return MDB_SUCCESS;
+
+  int rc = mdb_txn_commit(sdata->txn);
+  if (rc != MDB_SUCCESS)
+    mutt_debug(LL_DEBUG2, "mdb_txn_commit: %s\n", mdb_strerror(rc));
+
+  sdata->txn_mode = TXN_UNINITIALIZED;
+  sdata->txn = NULL;
+  return rc;
+}
+
 /**
  * store_lmdb_close - Close a Store connection - Implements StoreOps::close() - @ingroup store_close
  */
@@ -107,6 +107,34 @@ static int store_qdbm_delete_record(StoreHandle *store, const char *key, size_t
   return success ? 0 : dpecode ? dpecode : -1;
 }
 
+/**
+ * store_qdbm_begin - Start a batch of changes - Implements StoreOps::begin() - @ingroup store_begin
+ */
+static int store_qdbm_begin(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  VILLA *db = store;
+  bool success = vltranbegin(db);
+  return success ? 0 : dpecode ? dpecode : -1;
+}
+
+/**
+ * store_qdbm_commit - Write a batch of changes - Implements StoreOps::commit() - @ingroup store_commit
+ */
+static int store_qdbm_commit(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  VILLA *db = store;
+  bool success = vltrancommit(db);
+  return success ? 0 : dpecode ? dpecode : -1;
+}
+
 /**
  * store_qdbm_close - Close a Store connection - Implements StoreOps::close() - @ingroup store_close
  */
@@ -44,6 +44,7 @@ struct RocksDbStoreData
   rocksdb_options_t *options;            ///< Database options
   rocksdb_readoptions_t *read_options;   ///< Read options
   rocksdb_writeoptions_t *write_options; ///< Write options
+  rocksdb_writebatch_t *batch;           ///< Changes waiting to be written
   char *err;                             ///< Error message
 };
 
@@ -71,6 +72,30 @@ static struct RocksDbStoreData *rocksdb_sdata_new(void)
   return MUTT_MEM_CALLOC(1, struct RocksDbStoreData);
 }
 
+/**
+ * rocksdb_write_batch - Write any pending changes
+ * @param sdata RocksDB store
+ * @retval  0 Success
+ * @retval -1 Error
+ */
+static int rocksdb_write_batch(struct RocksDbStoreData *sdata)
+{
+  if (!sdata->batch || (rocksdb_writebatch_count(sdata->batch) == 0))
+    return 0;
+
+  rocksdb_write(sdata->db, sdata->write_options, sdata->batch, &sdata->err);
+  rocksdb_writebatch_clear(sdata->batch);
+  if (sdata->err)
+  {
+    mutt_debug(LL_DEBUG2, "rocksdb_write: %s\n", sdata->err);
+    rocksdb_free(sdata->err);
+    sdata->err = NULL;
+    return -1;
+  }
+
+  return 0;
+}
+
 /**
  * store_rocksdb_open - Open a connection to a Store - Implements StoreOps::open() - @ingroup store_open
  */
@@ -129,6 +154,9 @@ static void *store_rocksdb_fetch(StoreHandle *store, const char *key, size_t kle
   // Decloak an opaque pointer
   struct RocksDbStoreData *sdata = store;
 
+  /* Make sure the batch's changes are visible */
+  rocksdb_write_batch(sdata);
+
   void *rv = rocksdb_get(sdata->db, sdata->read_options, key, klen, vlen, &sdata->err);
   if (sdata->err)
   {
@@ -160,6 +188,12 @@ static int store_rocksdb_store(StoreHandle *store, const char *key, size_t klen,
   // Decloak an opaque pointer
   struct RocksDbStoreData *sdata = store;
 
+  if (sdata->batch)
+  {
+    rocksdb_writebatch_put(sdata->batch, key, klen, value, vlen);
+    return 0;
+  }
+
   rocksdb_put(sdata->db, sdata->write_options, key, klen, value, vlen, &sdata->err);
   if (sdata->err)
   {
@@ -182,6 +216,12 @@ static int store_rocksdb_delete_record(StoreHandle *store, const char *key, size
   // Decloak an opaque pointer
   struct RocksDbStoreData *sdata = store;
 
+  if (sdata->batch)
+  {
+    rocksdb_writebatch_delete(sdata->batch, key, klen);
+    return 0;
+  }
+
   rocksdb_delete(sdata->db, sdata->write_options, key, klen, &sdata->err);
   if (sdata->err)
   {
@@ -193,6 +233,46 @@ static int store_rocksdb_delete_record(StoreHandle *store, const char *key, size
   return 0;
 }
 
+/**
+ * store_rocksdb_begin - Start a batch of changes - Implements StoreOps::begin() - @ingroup store_begin
+ *
+ * Changes are collected in a WriteBatch, which is written as one operation.
+ */
+static int store_rocksdb_begin(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  struct RocksDbStoreData *sdata = store;
+
+  if (!sdata->batch)
+    sdata->batch = rocksdb_writebatch_create();
+
+  return 0;
+}
+
+/**
+ * store_rocksdb_commit - Write a batch of changes - Implements StoreOps::commit() - @ingroup store_commit
+ */
+static int store_rocksdb_commit(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  struct RocksDbStoreData *sdata = store;
+
+  int rc = rocksdb_write_batch(sdata);
+  if (sdata->batch)
+  {
+    rocksdb_writebatch_destroy(sdata->batch);
+    sdata->batch = NULL;
+  }
+
+  return rc;
+}
+
 /**
  * store_rocksdb_close - Close a Store connection - Implements StoreOps::close() - @ingroup store_close
  */
@@ -204,7 +284,8 @@ static void store_rocksdb_close(StoreHandle **ptr)
   // Decloak an opaque pointer
   struct RocksDbStoreData *sdata = *ptr;
 
-  /* close database and free resources */
+  /* write any pending changes, close database and free resources */
+  store_rocksdb_commit(sdata);
   rocksdb_close(sdata->db);
   rocksdb_options_destroy(sdata->options);
   rocksdb_readoptions_destroy(sdata->read_options);
@@ -128,6 +128,34 @@ static int store_tdb_delete_record(StoreHandle *store, const char *key, size_t k
   return tdb_delete(db, dkey);
 }
 
+/**
+ * store_tdb_begin - Start a batch of changes - Implements StoreOps::begin() - @ingroup store_begin
+ *
+ * The changes are kept in memory until the transaction is committed.
+ */
+static int store_tdb_begin(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  TDB_CONTEXT *db = store;
+  return tdb_transaction_start(db);
+}
+
+/**
+ * store_tdb_commit - Write a batch of changes - Implements StoreOps::commit() - @ingroup store_commit
+ */
+static int store_tdb_commit(StoreHandle *store)
+{
+  if (!store)
+    return -1;
+
+  // Decloak an opaque pointer
+  TDB_CONTEXT *db = store;
+  return tdb_transaction_commit(db);
+}
+
 /**
  * store_tdb_close - Close a Store connection - Implements StoreOps::close() - @ingroup store_close
  */
@@ -0,0 +1,161 @@
+/**
+ * @file
+ * Test code for the Alias name lookups
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stddef.h>
+#include "mutt/lib.h"
+#include "alias/alias.h"
+#include "alias/index.h"
+#include "test_common.h"
+
+/**
+ * add_alias - Create an Alias and add it to the list and the index
+ * @param name Name of the Alias
+ * @retval ptr New Alias
+ */
+static struct Alias *add_alias(const char *name)
+{
+  struct Alias *alias = alias_new();
+  alias->name = mutt_str_dup(name);
+  TAILQ_INSERT_TAIL(&Aliases, alias, entries);
+  alias_index_add(alias);
+  return alias;
+}
+
+/**
+ * remove_alias - Remove an Alias from the list and the index, and free it
+ * @param ptr Alias to remove
+ */
+static void remove_alias(struct Alias **ptr)
+{
+  TAILQ_REMOVE(&Aliases, *ptr, entries);
+  alias_index_delete(*ptr);
+  alias_free(ptr);
+}
+
+void test_alias_index(void)
+{
+  // void          alias_index_init    (void);
+  // void          alias_index_add     (struct Alias *alias);
+  // void          alias_index_delete  (struct Alias *alias);
+  // struct Alias *alias_index_find    (const char *name);
+  // struct Alias **alias_index_prefix (const char *prefix, size_t *count);
+  // void          alias_index_shutdown(void);
+
+  alias_index_init();
+
+  {
+    size_t count = 42;
+    alias_index_add(NULL);
+    alias_index_delete(NULL);
+    TEST_CHECK(alias_index_find(NULL) == NULL);
+    TEST_CHECK(alias_index_find("jim") == NULL);
+    TEST_CHECK(alias_index_prefix(NULL, &count) == NULL);
+    TEST_CHECK(count == 0);
+    TEST_CHECK(alias_index_prefix("jim", &count) == NULL);
+  }
+
+  struct Alias *jim = add_alias("jim");
+  struct Alias *jim_upper = add_alias("JIM");
+  struct Alias *jimmy = add_alias("jimmy");
+  struct Alias *bob = add_alias("bob");
+
+  {
+    TEST_CASE("Lookup, ignoring case");
+    TEST_CHECK(alias_index_find("jim") == jim);
+    TEST_CHECK(alias_index_find("Jim") == jim);
+    TEST_CHECK(alias_index_find("JIMMY") == jimmy);
+    TEST_CHECK(alias_index_find("bob") == bob);
+    TEST_CHECK(alias_index_find("jimm") == NULL);
+    TEST_CHECK(alias_index_find("") == NULL);
+  }
+
+  {
+    TEST_CASE("Prefix, matching case");
+    size_t count = 0;
+    struct Alias **matches = alias_index_prefix("jim", &count);
+    if (TEST_CHECK(matches != NULL) && TEST_CHECK_NUM_EQ(count, 2))
+    {
+      TEST_CHECK(matches[0] == jim);
+      TEST_CHECK(matches[1] == jimmy);
+    }
+
+    matches = alias_index_prefix("J", &count);
+    if (TEST_CHECK(matches != NULL) && TEST_CHECK_NUM_EQ(count, 1))
+      TEST_CHECK(matches[0] == jim_upper);
+
+    matches = alias_index_prefix("", &count);
+    TEST_CHECK(matches != NULL);
+    TEST_CHECK_NUM_EQ(count, 4);
+
+    TEST_CHECK(alias_index_prefix("k", &count) == NULL);
+    TEST_CHECK(count == 0);
+  }
+
+  {
+    TEST_CASE("Duplicate names");
+    // Removing the first "jim" uncovers the second
+    remove_alias(&jim);
+    TEST_CHECK(alias_index_find("jim") == jim_upper);
+    TEST_CHECK(alias_index_find("jimmy") == jimmy);
+
+    size_t count = 0;
+    struct Alias **matches = alias_index_prefix("jim", &count);
+    if (TEST_CHECK(matches != NULL) && TEST_CHECK_NUM_EQ(count, 1))
+      TEST_CHECK(matches[0] == jimmy);
+
+    remove_alias(&jim_upper);
+    TEST_CHECK(alias_index_find("jim") == NULL);
+  }
+
+  {
+    TEST_CASE("Add and remove");
+    struct Alias *jim2 = add_alias("Jim");
+    struct Alias *jim3 = add_alias("jim");
+    TEST_CHECK(alias_index_find("JIM") == jim2);
+
+    // Removing the second doesn't affect the first
+    remove_alias(&jim3);
+    TEST_CHECK(alias_index_find("jim") == jim2);
+
+    // An Alias that was never added
+    struct Alias *stray = alias_new();
+    stray->name = mutt_str_dup("jim");
+    alias_index_delete(stray);
+    alias_free(&stray);
+    TEST_CHECK(alias_index_find("jim") == jim2);
+
+    remove_alias(&jim2);
+    TEST_CHECK(alias_index_find("jim") == NULL);
+
+    remove_alias(&bob);
+    TEST_CHECK(alias_index_find("bob") == NULL);
+    TEST_CHECK(alias_index_find("jimmy") == jimmy);
+  }
+
+  alias_index_shutdown();
+  TEST_CHECK(alias_index_find("jimmy") == NULL);
+
+  aliaslist_clear(&Aliases);
+}
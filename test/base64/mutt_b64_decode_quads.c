@@ -0,0 +1,97 @@
+/**
+ * @file
+ * Test code for mutt_b64_decode_quads()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <string.h>
+#include "mutt/lib.h"
+#include "test_common.h"
+
+void test_mutt_b64_decode_quads(void)
+{
+  // size_t mutt_b64_decode_quads(const char *in, size_t len, char *out, size_t olen, size_t *used);
+
+  {
+    char out[16] = { 0 };
+    size_t used = 42;
+    TEST_CHECK(mutt_b64_decode_quads("", 0, out, sizeof(out), &used) == 0);
+    TEST_CHECK(used == 0);
+  }
+
+  {
+    // Whole groups are decoded
+    static const char in[] = "SGVsbG8gV29ybGQh";
+    char out[16] = { 0 };
+    size_t used = 0;
+    size_t len = mutt_b64_decode_quads(in, sizeof(in) - 1, out, sizeof(out), &used);
+    TEST_CHECK_NUM_EQ(len, 12);
+    TEST_CHECK_NUM_EQ(used, 16);
+    TEST_CHECK_STR_EQ(out, "Hello World!");
+  }
+
+  {
+    // Padding, and anything after it, is left for the caller
+    static const char in[] = "SGVsbG8=AAAA";
+    char out[16] = { 0 };
+    size_t used = 0;
+    size_t len = mutt_b64_decode_quads(in, sizeof(in) - 1, out, sizeof(out), &used);
+    TEST_CHECK_NUM_EQ(len, 3);
+    TEST_CHECK_NUM_EQ(used, 4);
+    TEST_CHECK_STR_EQ(out, "Hel");
+  }
+
+  {
+    // An incomplete group isn't decoded
+    static const char in[] = "SGVsbG";
+    char out[16] = { 0 };
+    size_t used = 0;
+    size_t len = mutt_b64_decode_quads(in, sizeof(in) - 1, out, sizeof(out), &used);
+    TEST_CHECK_NUM_EQ(len, 3);
+    TEST_CHECK_NUM_EQ(used, 4);
+  }
+
+  {
+    // Invalid characters stop the decoding
+    static const char in[] = "SGVs\nbG8h";
+    char out[16] = { 0 };
+    size_t used = 0;
+    size_t len = mutt_b64_decode_quads(in, sizeof(in) - 1, out, sizeof(out), &used);
+    TEST_CHECK_NUM_EQ(len, 3);
+    TEST_CHECK_NUM_EQ(used, 4);
+
+    static const char in8[] = "SGVs\xc3\xa9" "bG8";
+    len = mutt_b64_decode_quads(in8, sizeof(in8) - 1, out, sizeof(out), &used);
+    TEST_CHECK_NUM_EQ(len, 3);
+    TEST_CHECK_NUM_EQ(used, 4);
+  }
+
+  {
+    // Stop when there's no room for another three bytes
+    static const char in[] = "SGVsbG8gV29ybGQh";
+    char out[16] = { 0 };
+    size_t used = 0;
+    size_t len = mutt_b64_decode_quads(in, sizeof(in) - 1, out, 8, &used);
+    TEST_CHECK_NUM_EQ(len, 6);
+    TEST_CHECK_NUM_EQ(used, 8);
+  }
+}
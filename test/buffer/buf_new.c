@@ -45,4 +45,24 @@ void test_buf_new(void)
     TEST_CHECK_STR_EQ(buf_string(buf), "apple");
     buf_free(&buf);
   }
+
+  {
+    // The Buffer fits the string exactly, but can still grow
+    struct Buffer *buf = buf_new("apple");
+    TEST_CHECK_NUM_EQ(buf->dsize, 6);
+    TEST_CHECK_NUM_EQ(buf_len(buf), 5);
+    buf_addstr(buf, " banana");
+    TEST_CHECK_STR_EQ(buf_string(buf), "apple banana");
+    buf_add_printf(buf, " %s", "cherry");
+    TEST_CHECK_STR_EQ(buf_string(buf), "apple banana cherry");
+    buf_free(&buf);
+  }
+
+  {
+    struct Buffer *buf = buf_new("");
+    TEST_CHECK_STR_EQ(buf_string(buf), "");
+    buf_addch(buf, 'a');
+    TEST_CHECK_STR_EQ(buf_string(buf), "a");
+    buf_free(&buf);
+  }
 }
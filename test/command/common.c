@@ -297,13 +297,6 @@ struct Body *mutt_remove_multipart(struct Body *b)
   return NULL;
 }
 
-int mutt_rfc822_write_header(FILE *fp, struct Envelope *env, struct Body *b,
-                             enum MuttWriteHeaderMode mode, bool privacy,
-                             bool hide_protected_subject, struct ConfigSubset *sub)
-{
-  return 0;
-}
-
 void mutt_update_encoding(struct Body *b, struct ConfigSubset *sub)
 {
 }
@@ -313,18 +306,6 @@ int mutt_write_mime_body(struct Body *b, FILE *fp, struct ConfigSubset *sub)
   return 0;
 }
 
-int mutt_write_mime_header(struct Body *b, FILE *fp, struct ConfigSubset *sub)
-{
-  return 0;
-}
-
-int mutt_write_one_header(FILE *fp, const char *tag, const char *value,
-                          const char *pfx, int wraplen, CopyHeaderFlags chflags,
-                          struct ConfigSubset *sub)
-{
-  return 0;
-}
-
 void sbar_set_title(struct MuttWindow *win, const char *title)
 {
 }
@@ -39,6 +39,7 @@ static const struct CommandTest Tests[] = {
   { MUTT_CMD_SUCCESS, "'^john.*@example\\.com'" },
   { MUTT_CMD_SUCCESS, "'^smith.*@example\\.com' '^js@.*\\.example\\.com'" },
   { MUTT_CMD_SUCCESS, "-group self '^john.*@example\\.com'" },
+  { MUTT_CMD_SUCCESS, "'^me@example\\.org$' 'work@(office|home)\\.example\\.net'" },
   { MUTT_CMD_ERROR,   NULL },
 };
 // clang-format on
@@ -61,6 +62,38 @@ void test_parse_alternates(void)
     TEST_CHECK_NUM_EQ(rc, Tests[i].rc);
   }
 
+  // bool mutt_alternates_match(const char *addr)
+  {
+    TEST_CHECK(mutt_alternates_match("john.doe@example.com"));
+    TEST_CHECK(mutt_alternates_match("JS@mail.example.com"));
+    TEST_CHECK(mutt_alternates_match("me@example.org"));
+    TEST_CHECK(mutt_alternates_match("ME@Example.ORG"));
+    TEST_CHECK(mutt_alternates_match("bob.work@home.example.net"));
+    TEST_CHECK(!mutt_alternates_match("me@example.org.uk"));
+    TEST_CHECK(!mutt_alternates_match("me@exampleXorg"));
+    TEST_CHECK(!mutt_alternates_match("bob@example.com"));
+    TEST_CHECK(!mutt_alternates_match(NULL));
+  }
+
+  // A failing command must still invalidate the matcher
+  {
+    static const struct Command UnAlternates = { "unalternates", CMD_UNALTERNATES, NULL, CMD_NO_DATA };
+
+    TEST_CHECK(!mutt_alternates_match("partial@example.com"));
+    buf_strcpy(line, "'^partial@example\\.com$' '['");
+    buf_seek(line, 0);
+    rc = parse_alternates(&Alternates, line, err);
+    TEST_CHECK_NUM_EQ(rc, MUTT_CMD_ERROR);
+    TEST_CHECK(mutt_alternates_match("partial@example.com"));
+
+    TEST_CHECK(mutt_alternates_match("me@example.org"));
+    buf_strcpy(line, "'^me@example\\.org$' '['");
+    buf_seek(line, 0);
+    rc = parse_unalternates(&UnAlternates, line, err);
+    TEST_CHECK_NUM_EQ(rc, MUTT_CMD_ERROR);
+    TEST_CHECK(!mutt_alternates_match("me@example.org"));
+  }
+
   buf_pool_release(&err);
   buf_pool_release(&line);
 }
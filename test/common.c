@@ -299,7 +299,12 @@ int mutt_traverse_thread(struct Email *e, MuttThreadFlags flag)
 
 enum UseThreads mutt_thread_style(void)
 {
-  return UT_THREADS;
+  // Unless a test has set $sort, assume threads
+  if (!cs_subset_lookup(NeoMutt->sub, "sort"))
+    return UT_THREADS;
+
+  const enum EmailSortType c_sort = cs_subset_sort(NeoMutt->sub, "sort");
+  return ((c_sort & SORT_MASK) == EMAIL_SORT_THREADS) ? UT_THREADS : UT_FLAT;
 }
 
 #ifdef USE_DEBUG_BACKTRACE
@@ -435,6 +440,10 @@ bool mutt_mailbox_notify(struct Mailbox *m_cur)
   return true;
 }
 
+void mutt_make_label_hash(struct Mailbox *m)
+{
+}
+
 int mutt_messages_in_thread(struct Mailbox *m, struct Email *e, enum MessageInThread mit)
 {
   return 0;
@@ -24,6 +24,7 @@
 #include "config.h"
 #include "acutest.h"
 #include <stddef.h>
+#include <string.h>
 #include "mutt/lib.h"
 #include "compress/lib.h"
 #include "common.h" // IWYU pragma: keep
@@ -59,6 +60,10 @@ void test_compress_zstd(void)
     struct ZstdComprData *ptr = NULL;
     zstd_cdata_free(NULL);
     zstd_cdata_free(&ptr);
+
+    size_t dlen = 0;
+    TEST_CHECK(compr_ops->train(NULL, NULL, NULL, 0, &dlen) == NULL);
+    TEST_CHECK(!compr_ops->load_dict(NULL, NULL, 0));
   }
 
   {
@@ -90,5 +95,60 @@ void test_compress_zstd(void)
     compr_ops->close(&compr_handle);
   }
 
+  {
+    // Dictionary
+    struct Buffer *samples = buf_pool_get();
+    size_t sizes[500] = { 0 };
+    for (size_t i = 0; i < countof(sizes); i++)
+    {
+      size_t len = buf_len(samples);
+      buf_add_printf(samples, "From: user%zu@example.com\nTo: list%zu@example.org\n"
+                     "Subject: Re: topic %zu about things\nMessage-ID: <%zu.%zu@example.com>\n",
+                     i % 37, i % 5, i * 7, i, i * 13);
+      sizes[i] = buf_len(samples) - len;
+    }
+
+    ComprHandle *trained = compr_ops->open(MIN_COMP_LEVEL);
+    size_t dlen = 0;
+    void *dict = compr_ops->train(trained, buf_string(samples), sizes, countof(sizes), &dlen);
+    TEST_CHECK(dict != NULL);
+    TEST_CHECK(dlen != 0);
+
+    // Garbage isn't a dictionary
+    TEST_CHECK(!compr_ops->load_dict(trained, buf_string(samples), 64));
+
+    ComprHandle *loaded = compr_ops->open(MIN_COMP_LEVEL);
+    TEST_CHECK(compr_ops->load_dict(loaded, dict, dlen));
+
+    ComprHandle *plain = compr_ops->open(MIN_COMP_LEVEL);
+
+    const char *data = buf_string(samples);
+    size_t clen = 0;
+    char *cdata = compr_ops->compress(trained, data, sizes[0], &clen);
+    TEST_CHECK(cdata != NULL);
+    char *copy = mutt_strn_dup(cdata, clen);
+
+    // Decompress using the same dictionary
+    char *ddata = compr_ops->decompress(loaded, copy, clen);
+    TEST_CHECK((ddata != NULL) && (memcmp(ddata, data, sizes[0]) == 0));
+
+    // A dictionary is needed
+    TEST_CHECK(compr_ops->decompress(plain, copy, clen) == NULL);
+    FREE(&copy);
+
+    // Data compressed without a dictionary can still be read
+    cdata = compr_ops->compress(plain, data, sizes[0], &clen);
+    TEST_CHECK(cdata != NULL);
+    copy = mutt_strn_dup(cdata, clen);
+    ddata = compr_ops->decompress(loaded, copy, clen);
+    TEST_CHECK((ddata != NULL) && (memcmp(ddata, data, sizes[0]) == 0));
+    FREE(&copy);
+
+    compr_ops->close(&trained);
+    compr_ops->close(&loaded);
+    compr_ops->close(&plain);
+    buf_pool_release(&samples);
+  }
+
   compress_data_tests(compr_ops, MIN_COMP_LEVEL, MAX_COMP_LEVEL);
 }
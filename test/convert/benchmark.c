@@ -0,0 +1,483 @@
+/**
+ * @file
+ * Benchmark for mutt_convert_file_to()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Convert synthetic files, using both mutt_convert_file_to() and a reference
+ * copy of the original block-by-block conversion, which had no pre-scan.
+ *
+ * By default, this only checks that the two agree.
+ * To measure them, set the environment variable `NEOMUTT_BENCHMARK`
+ * to the number of passes, e.g.
+ *
+ *   NEOMUTT_BENCHMARK=10 test/neomutt-test test_convert_benchmark
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <errno.h>
+#include <iconv.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "email/lib.h"
+#include "convert/lib.h"
+#include "convert_common.h"
+#include "test_common.h"
+
+/**
+ * convert_file_to_reference - Change the encoding of a file, without a pre-scan
+ * @param[in]  fp         File to convert
+ * @param[in]  fromcode   Original encoding
+ * @param[in]  tocodes    List of target encodings
+ * @param[out] tocode     Chosen encoding
+ * @param[out] info       Encoding information
+ * @retval -1 Error, no conversion was possible
+ * @retval >0 Success, number of bytes converted
+ *
+ * This is mutt_convert_file_to() as it was, before the pre-scan.
+ * Every block is converted to UTF-8, then into each of the tocodes.
+ */
+static size_t convert_file_to_reference(FILE *fp, const char *fromcode,
+                                        struct Slist const *const tocodes,
+                                        int *tocode, struct Content *info)
+{
+  char bufi[256] = { 0 };
+  char bufu[512] = { 0 };
+  char bufo[4 * sizeof(bufi)] = { 0 };
+  size_t rc;
+
+  const iconv_t cd1 = mutt_ch_iconv_open("utf-8", fromcode, MUTT_ICONV_NO_FLAGS);
+  if (!iconv_t_valid(cd1))
+    return -1;
+
+  int ncodes = tocodes->count;
+  iconv_t *cd = MUTT_MEM_CALLOC(ncodes, iconv_t);
+  size_t *score = MUTT_MEM_CALLOC(ncodes, size_t);
+  struct ContentState *states = MUTT_MEM_CALLOC(ncodes, struct ContentState);
+  struct Content *infos = MUTT_MEM_CALLOC(ncodes, struct Content);
+
+  struct ListNode *np = NULL;
+  int ni = 0;
+  STAILQ_FOREACH(np, &tocodes->head, entries)
+  {
+    if (!mutt_istr_equal(np->data, "utf-8"))
+    {
+      cd[ni] = mutt_ch_iconv_open(np->data, "utf-8", MUTT_ICONV_NO_FLAGS);
+    }
+    else
+    {
+      /* Special case for conversion to UTF-8 */
+      cd[ni] = ICONV_T_INVALID;
+      score[ni] = ICONV_ILLEGAL_SEQ;
+    }
+    ni += 1;
+  }
+
+  rewind(fp);
+  size_t ibl = 0;
+  while (true)
+  {
+    /* Try to fill input buffer */
+    size_t n = fread(bufi + ibl, 1, sizeof(bufi) - ibl, fp);
+    ibl += n;
+
+    /* Convert to UTF-8 */
+    const char *ib = bufi;
+    char *ob = bufu;
+    size_t obl = sizeof(bufu);
+    n = iconv(cd1, (ICONV_CONST char **) ((ibl != 0) ? &ib : 0), &ibl, &ob, &obl);
+    if ((n == ICONV_ILLEGAL_SEQ) && (((errno != EINVAL) && (errno != E2BIG)) || (ib == bufi)))
+    {
+      rc = ICONV_ILLEGAL_SEQ;
+      break;
+    }
+    const size_t ubl1 = ob - bufu;
+
+    /* Convert from UTF-8 */
+    for (int i = 0; i < ncodes; i++)
+    {
+      if (iconv_t_valid(cd[i]) && (score[i] != ICONV_ILLEGAL_SEQ))
+      {
+        const char *ub = bufu;
+        size_t ubl = ubl1;
+        ob = bufo;
+        obl = sizeof(bufo);
+        n = iconv(cd[i], (ICONV_CONST char **) ((ibl || ubl) ? &ub : 0), &ubl, &ob, &obl);
+        if (n == ICONV_ILLEGAL_SEQ)
+        {
+          score[i] = ICONV_ILLEGAL_SEQ;
+        }
+        else
+        {
+          score[i] += n;
+          mutt_update_content_info(&infos[i], &states[i], bufo, ob - bufo);
+        }
+      }
+      else if (!iconv_t_valid(cd[i]) && (score[i] == ICONV_ILLEGAL_SEQ))
+      {
+        /* Special case for conversion to UTF-8 */
+        mutt_update_content_info(&infos[i], &states[i], bufu, ubl1);
+      }
+    }
+
+    if (ibl)
+    {
+      /* Save unused input */
+      memmove(bufi, ib, ibl);
+    }
+    else if (!ubl1 && (ib < bufi + sizeof(bufi)))
+    {
+      rc = 0;
+      break;
+    }
+  }
+
+  if (rc == 0)
+  {
+    /* Find best score */
+    rc = ICONV_ILLEGAL_SEQ;
+    for (int i = 0; i < ncodes; i++)
+    {
+      if (!iconv_t_valid(cd[i]) && (score[i] == ICONV_ILLEGAL_SEQ))
+      {
+        /* Special case for conversion to UTF-8 */
+        *tocode = i;
+        rc = 0;
+        break;
+      }
+      else if (!iconv_t_valid(cd[i]) || (score[i] == ICONV_ILLEGAL_SEQ))
+      {
+        continue;
+      }
+      else if ((rc == ICONV_ILLEGAL_SEQ) || (score[i] < rc))
+      {
+        *tocode = i;
+        rc = score[i];
+        if (rc == 0)
+          break;
+      }
+    }
+    if (rc != ICONV_ILLEGAL_SEQ)
+    {
+      memcpy(info, &infos[*tocode], sizeof(struct Content));
+      mutt_update_content_info(info, &states[*tocode], 0, 0); /* EOF */
+    }
+  }
+
+  FREE(&cd);
+  FREE(&infos);
+  FREE(&score);
+  FREE(&states);
+
+  return rc;
+}
+
+/**
+ * enum BenchText - Type of synthetic text
+ */
+enum BenchText
+{
+  BT_ASCII,   ///< Plain ASCII
+  BT_LATIN,   ///< UTF-8, mostly ASCII, with some accented letters
+  BT_CJK,     ///< UTF-8, mostly Chinese, Japanese, Korean
+  BT_8BIT,    ///< ISO-8859-1
+  BT_INVALID, ///< UTF-8, with broken sequences
+};
+
+/**
+ * struct BenchFile - A synthetic file to convert
+ */
+struct BenchFile
+{
+  const char *name;     ///< Short description
+  enum BenchText text;  ///< Type of text
+  const char *fromcode; ///< Charset of the text
+};
+
+static const struct BenchFile Files[] = {
+  // clang-format off
+  { "ASCII",         BT_ASCII,   "us-ascii"   },
+  { "ASCII",         BT_ASCII,   "utf-8"      },
+  { "UTF-8 (Latin)", BT_LATIN,   "utf-8"      },
+  { "UTF-8 (CJK)",   BT_CJK,     "utf-8"      },
+  { "ISO-8859-1",    BT_8BIT,    "iso-8859-1" },
+  { "ISO-8859-1",    BT_8BIT,    "utf-8"      },
+  { "Invalid UTF-8", BT_INVALID, "utf-8"      },
+  { NULL, 0, NULL },
+  // clang-format on
+};
+
+static const char *SendCharsets[] = {
+  "us-ascii:iso-8859-1:utf-8",
+  "utf-8",
+  "us-ascii",
+  "iso-8859-1:us-ascii",
+  "iso-8859-2:utf-8",
+  "euc-jp:iso-8859-15:utf-8",
+};
+
+static const char *Words[] = {
+  "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "mailbox",
+  "From", "header", "attachment", "charset", "message", ".", "\t", "",
+};
+
+static const char *Latin[] = {
+  "café", "naïve", "Zürich", "façade", "smørrebrød", "señor", "Łódź", "€10",
+};
+
+static const char *Cjk[] = {
+  "日本語", "中文", "한국어", "メール", "電子郵件", "テスト", "添付",
+};
+
+/**
+ * bench_random - Get a pseudo-random number
+ * @param seed Random state
+ * @retval num Random number
+ *
+ * The same seed always generates the same files.
+ */
+static uint32_t bench_random(uint32_t *seed)
+{
+  *seed = (*seed * 1103515245) + 12345;
+  return (*seed >> 16) & 0x7fff;
+}
+
+/**
+ * bench_text - Create some synthetic text
+ * @param text Type of text
+ * @param size Size of the text
+ * @param seed Random state
+ * @retval ptr Text, which must be freed
+ */
+static char *bench_text(enum BenchText text, size_t size, uint32_t *seed)
+{
+  char *buf = MUTT_MEM_MALLOC(size + 1, char);
+  size_t len = 0;
+  size_t col = 0;
+
+  while (len < size)
+  {
+    const char *word = Words[bench_random(seed) % countof(Words)];
+    char tmp[16] = { 0 };
+    const int r = bench_random(seed) % 8;
+
+    if ((text == BT_LATIN) && (r == 0))
+    {
+      word = Latin[bench_random(seed) % countof(Latin)];
+    }
+    else if ((text == BT_CJK) && (r != 0))
+    {
+      word = Cjk[bench_random(seed) % countof(Cjk)];
+    }
+    else if ((text == BT_8BIT) && (r == 0))
+    {
+      tmp[0] = 0xa0 + (bench_random(seed) % 0x60);
+      tmp[1] = 'x';
+      word = tmp;
+    }
+    else if ((text == BT_INVALID) && (r == 0) && ((bench_random(seed) % 64) == 0))
+    {
+      // A lead byte without its continuation
+      tmp[0] = 0xc3;
+      word = tmp;
+    }
+
+    size_t wl = mutt_str_len(word);
+    if ((len + wl + 2) > size)
+      break;
+
+    memcpy(buf + len, word, wl);
+    len += wl;
+    col += wl;
+
+    if (col > 60 + (bench_random(seed) % 30))
+    {
+      if ((bench_random(seed) % 5) == 0)
+        buf[len++] = '\r';
+      buf[len++] = '\n';
+      col = 0;
+    }
+    else
+    {
+      buf[len++] = ' ';
+      col++;
+    }
+  }
+
+  // Pad to the exact size
+  while (len < size)
+  {
+    buf[len] = (len == (size - 1)) ? '\n' : 'z';
+    len++;
+  }
+
+  return buf;
+}
+
+/**
+ * now_ns - Get a monotonic time in nanoseconds
+ * @retval num Time
+ */
+static uint64_t now_ns(void)
+{
+  struct timespec ts = { 0 };
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/**
+ * content_equal - Compare two Contents
+ * @param a First Content
+ * @param b Second Content
+ * @retval true They match
+ */
+static bool content_equal(const struct Content *a, const struct Content *b)
+{
+  return (a->hibin == b->hibin) && (a->lobin == b->lobin) &&
+         (a->nulbin == b->nulbin) && (a->crlf == b->crlf) &&
+         (a->ascii == b->ascii) && (a->linemax == b->linemax) &&
+         (a->space == b->space) && (a->binary == b->binary) &&
+         (a->from == b->from) && (a->dot == b->dot) && (a->cr == b->cr);
+}
+
+/**
+ * bench_compare - Check that both conversions agree
+ * @param bf      File to test
+ * @param data    Text of the file
+ * @param size    Size of the text
+ * @param tocodes Charsets to try
+ * @retval true They agree
+ */
+static bool bench_compare(const struct BenchFile *bf, char *data, size_t size,
+                          const struct Slist *tocodes)
+{
+  FILE *fp = test_make_file_with_contents(data, size);
+  if (!TEST_CHECK(fp != NULL))
+    return false;
+
+  int tocode_ref = -1;
+  int tocode_new = -1;
+  struct Content info_ref = initial_info;
+  struct Content info_new = initial_info;
+
+  size_t rc_ref = convert_file_to_reference(fp, bf->fromcode, tocodes, &tocode_ref, &info_ref);
+  size_t rc_new = mutt_convert_file_to(fp, bf->fromcode, tocodes, &tocode_new, &info_new);
+  fclose(fp);
+
+  bool ok = TEST_CHECK_NUM_EQ(rc_new, rc_ref);
+  if (ok && (rc_ref != ICONV_ILLEGAL_SEQ))
+  {
+    ok = TEST_CHECK_NUM_EQ(tocode_new, tocode_ref);
+    ok = ok && TEST_CHECK(content_equal(&info_new, &info_ref));
+  }
+
+  return ok;
+}
+
+/**
+ * bench_time - Time both conversions of a file
+ * @param bf      File to test
+ * @param data    Text of the file
+ * @param size    Size of the text
+ * @param tocodes Charsets to try
+ * @param passes  Number of times to convert the file
+ */
+static void bench_time(const struct BenchFile *bf, char *data, size_t size,
+                       const struct Slist *tocodes, int passes)
+{
+  FILE *fp = test_make_file_with_contents(data, size);
+  if (!TEST_CHECK(fp != NULL))
+    return;
+
+  int tocode = 0;
+  struct Content info = initial_info;
+
+  uint64_t start = now_ns();
+  for (int p = 0; p < passes; p++)
+    convert_file_to_reference(fp, bf->fromcode, tocodes, &tocode, &info);
+  const double ms_ref = (double) (now_ns() - start) / (1000000.0 * passes);
+
+  start = now_ns();
+  for (int p = 0; p < passes; p++)
+    mutt_convert_file_to(fp, bf->fromcode, tocodes, &tocode, &info);
+  const double ms_new = (double) (now_ns() - start) / (1000000.0 * passes);
+
+  fclose(fp);
+
+  printf("\n  %-14s from %-10s  reference %7.1f ms  pre-scan %7.1f ms  %5.2fx",
+         bf->name, bf->fromcode, ms_ref, ms_new, ms_ref / ms_new);
+}
+
+void test_convert_benchmark(void)
+{
+  const int passes = atoi(NONULL(mutt_str_getenv("NEOMUTT_BENCHMARK")));
+
+  // Sizes either side of the reference's 256-byte and the 16 KiB blocks
+  static const size_t sizes[] = { 0, 1, 255, 257, 4000, 16383, 16385, 40000 };
+  uint32_t seed = 1;
+
+  for (const struct BenchFile *bf = Files; bf->name; bf++)
+  {
+    for (int c = 0; c < countof(SendCharsets); c++)
+    {
+      struct Slist *tocodes = slist_parse(SendCharsets[c], D_SLIST_SEP_COLON);
+
+      for (int s = 0; s < countof(sizes); s++)
+      {
+        char *data = bench_text(bf->text, sizes[s], &seed);
+        bool ok = bench_compare(bf, data, sizes[s], tocodes);
+        FREE(&data);
+        if (!ok)
+        {
+          TEST_MSG("%s from %s, to %s, %zu bytes", bf->name, bf->fromcode,
+                   SendCharsets[c], sizes[s]);
+          break;
+        }
+      }
+
+      slist_free(&tocodes);
+    }
+  }
+
+  if (passes <= 0)
+    return;
+
+  // Measure a large file, with a typical $send_charset
+  const size_t size = 4 * 1024 * 1024;
+  struct Slist *tocodes = slist_parse(SendCharsets[0], D_SLIST_SEP_COLON);
+  printf("\n  $send_charset \"%s\", %zu KiB", SendCharsets[0], size / 1024);
+
+  for (const struct BenchFile *bf = Files; bf->name; bf++)
+  {
+    char *data = bench_text(bf->text, size, &seed);
+    bench_time(bf, data, size, tocodes, passes);
+    FREE(&data);
+  }
+  printf("\n");
+
+  slist_free(&tocodes);
+}
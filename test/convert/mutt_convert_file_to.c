@@ -181,4 +181,82 @@ void test_mutt_convert_file_to(void)
     slist_free(&tocodes);
     fclose(fp);
   }
+  {
+    /* Valid UTF-8 that fits in ISO-8859-1 */
+    char data[] = "caf\xc3\xa9\nna\xc3\xafve\n";
+    FILE *fp = test_make_file_with_contents(data, sizeof(data) - 1);
+
+    struct Slist *tocodes = slist_parse("us-ascii:iso-8859-1:utf-8", D_SLIST_SEP_COLON);
+    int tocode = 0;
+    struct Content info = initial_info;
+
+    size_t rc = mutt_convert_file_to(fp, "utf-8", tocodes, &tocode, &info);
+    TEST_CHECK_NUM_EQ(rc, 0);
+    TEST_CHECK_NUM_EQ(tocode, 1);
+    TEST_CHECK_NUM_EQ(info.hibin, 2);
+    TEST_CHECK_NUM_EQ(info.ascii, 7);
+
+    slist_free(&tocodes);
+    fclose(fp);
+  }
+
+  {
+    /* Valid UTF-8 that only fits in UTF-8 */
+    char data[] = "\xe6\x97\xa5\xe6\x9c\xac\n";
+    FILE *fp = test_make_file_with_contents(data, sizeof(data) - 1);
+
+    struct Slist *tocodes = slist_parse("us-ascii:iso-8859-1:utf-8", D_SLIST_SEP_COLON);
+    int tocode = 0;
+    struct Content info = initial_info;
+
+    size_t rc = mutt_convert_file_to(fp, "utf-8", tocodes, &tocode, &info);
+    TEST_CHECK_NUM_EQ(rc, 0);
+    TEST_CHECK_NUM_EQ(tocode, 2);
+    TEST_CHECK_NUM_EQ(info.hibin, 6);
+    TEST_CHECK_NUM_EQ(info.crlf, 1);
+
+    slist_free(&tocodes);
+    fclose(fp);
+  }
+
+  {
+    /* Invalid UTF-8: a surrogate */
+    char data[] = "abc\xed\xa0\x80\n";
+    FILE *fp = test_make_file_with_contents(data, sizeof(data) - 1);
+
+    struct Slist *tocodes = slist_parse("us-ascii:utf-8", D_SLIST_SEP_COLON);
+    int tocode = 0;
+    struct Content info = initial_info;
+
+    size_t rc = mutt_convert_file_to(fp, "utf-8", tocodes, &tocode, &info);
+    TEST_CHECK(rc == ICONV_ILLEGAL_SEQ);
+
+    slist_free(&tocodes);
+    fclose(fp);
+  }
+
+  {
+    /* Large file, with characters split across the input blocks */
+    const size_t len = 99999;
+    char *data = MUTT_MEM_MALLOC(len, char);
+    for (size_t i = 0; i < len; i += 3)
+    {
+      data[i] = (i % 60 == 0) ? '\n' : '\xe2';
+      data[i + 1] = (i % 60 == 0) ? 'a' : '\x82';
+      data[i + 2] = (i % 60 == 0) ? 'b' : '\xac';
+    }
+    FILE *fp = test_make_file_with_contents(data, len);
+
+    struct Slist *tocodes = slist_parse("iso-8859-1:iso-8859-15:utf-8", D_SLIST_SEP_COLON);
+    int tocode = 0;
+    struct Content info = initial_info;
+
+    size_t rc = mutt_convert_file_to(fp, "utf-8", tocodes, &tocode, &info);
+    TEST_CHECK_NUM_EQ(rc, 0);
+    TEST_CHECK_NUM_EQ(tocode, 1);
+
+    slist_free(&tocodes);
+    fclose(fp);
+    FREE(&data);
+  }
 }
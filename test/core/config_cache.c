@@ -59,5 +59,32 @@ void test_config_cache(void)
     config_cache_cleanup();
   }
 
+  {
+    static struct CachedConfig cc_sleep_time = CACHED_CONFIG("sleep_time");
+    static struct CachedConfig cc_simple_search = CACHED_CONFIG("simple_search");
+
+    TEST_CHECK_NUM_EQ(cc_number(&cc_sleep_time), 0);
+    TEST_CHECK_STR_EQ(cc_string(&cc_simple_search), "~f %s | ~s %s");
+    TEST_CHECK(cc_sleep_time.valid);
+
+    int rc = cs_subset_str_string_set(sub, "sleep_time", "5", NULL);
+    TEST_CHECK_NUM_EQ(CSR_RESULT(rc), CSR_SUCCESS);
+    TEST_CHECK(!cc_sleep_time.valid);
+    TEST_CHECK(cc_simple_search.valid);
+    TEST_CHECK_NUM_EQ(cc_number(&cc_sleep_time), 5);
+
+    rc = cs_subset_str_string_set(sub, "simple_search", "~s %s", NULL);
+    TEST_CHECK_NUM_EQ(CSR_RESULT(rc), CSR_SUCCESS);
+    TEST_CHECK_STR_EQ(cc_string(&cc_simple_search), "~s %s");
+
+    cs_subset_str_string_set(sub, "sleep_time", "0", NULL);
+    cs_subset_str_string_set(sub, "simple_search", "~f %s | ~s %s", NULL);
+    TEST_CHECK_NUM_EQ(cc_number(&cc_sleep_time), 0);
+
+    config_cache_cleanup();
+    TEST_CHECK(!cc_sleep_time.valid);
+    TEST_CHECK(!cc_simple_search.valid);
+  }
+
   log_line(__func__);
 }
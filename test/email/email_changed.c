@@ -0,0 +1,103 @@
+/**
+ * @file
+ * Test code for email_changed()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stddef.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "test_common.h"
+
+static struct ConfigDef Vars[] = {
+  // clang-format off
+  { "hidden_tags", DT_SLIST|D_SLIST_SEP_COMMA, IP "unread,draft,flagged,passed,replied,attachment,signed,encrypted", 0, NULL, },
+  { NULL },
+  // clang-format on
+};
+
+void test_email_changed(void)
+{
+  // void email_changed(struct Email *e);
+  // void email_changed_all(void);
+  // unsigned int email_generation(void);
+  // bool email_tags_replace(struct Email *e, const char *tags);
+
+  TEST_CHECK(cs_register_variables(NeoMutt->sub->cs, Vars));
+
+  {
+    email_changed(NULL);
+    TEST_CHECK_(1, "email_changed(NULL)");
+  }
+
+  {
+    struct Email *e = email_new();
+    const unsigned int gen = e->gen;
+    email_changed(e);
+    TEST_CHECK(e->gen != gen);
+    email_free(&e);
+  }
+
+  {
+    const unsigned int gen = email_generation();
+    email_changed_all();
+    TEST_CHECK(email_generation() != gen);
+  }
+
+  {
+    TEST_CHECK(!email_tags_replace(NULL, "inbox"));
+  }
+
+  {
+    // A tag change invalidates the cached line of the Index
+    struct Email *e = email_new();
+    e->line = MUTT_MEM_CALLOC(1, struct EmailLine);
+    e->line->gen = e->gen;
+    e->line->gen_all = email_generation();
+
+    TEST_CHECK(email_tags_replace(e, "inbox work"));
+    TEST_CHECK(e->line->gen != e->gen);
+
+    struct Buffer *buf = buf_pool_get();
+    driver_tags_get(&e->tags, buf);
+    TEST_CHECK_STR_EQ(buf_string(buf), "inbox work");
+    buf_pool_release(&buf);
+
+    // and so does removing them all
+    e->line->gen = e->gen;
+    TEST_CHECK(email_tags_replace(e, NULL));
+    TEST_CHECK(e->line->gen != e->gen);
+    TEST_CHECK(STAILQ_EMPTY(&e->tags));
+    email_free(&e);
+  }
+
+  {
+    // A cached line is freed with the Email
+    struct Email *e = email_new();
+    e->line = MUTT_MEM_CALLOC(1, struct EmailLine);
+    e->line->text = mutt_str_dup("line");
+    email_free(&e);
+    TEST_CHECK(e == NULL);
+  }
+}
@@ -0,0 +1,236 @@
+/**
+ * @file
+ * Test code for mutt_sort_headers()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "mutt/lib.h"
+#include "address/lib.h"
+#include "config/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "mview.h"
+#include "test_common.h"
+
+#define NUM_EMAILS 60
+
+static const struct Mapping SortTestMethods[] = {
+  // clang-format off
+  { "date",          EMAIL_SORT_DATE },
+  { "date-received", EMAIL_SORT_DATE_RECEIVED },
+  { "from",          EMAIL_SORT_FROM },
+  { "label",         EMAIL_SORT_LABEL },
+  { "score",         EMAIL_SORT_SCORE },
+  { "size",          EMAIL_SORT_SIZE },
+  { "subject",       EMAIL_SORT_SUBJECT },
+  { "to",            EMAIL_SORT_TO },
+  { "unsorted",      EMAIL_SORT_UNSORTED },
+  { NULL, 0 },
+  // clang-format on
+};
+
+static struct ConfigDef Vars[] = {
+  // clang-format off
+  { "reverse_alias", DT_BOOL,                           false,           0,                  NULL, },
+  { "score",         DT_BOOL,                           true,            0,                  NULL, },
+  { "sort",          DT_SORT|D_SORT_REVERSE|D_SORT_LAST, EMAIL_SORT_DATE, IP SortTestMethods, NULL, },
+  { "sort_aux",      DT_SORT|D_SORT_REVERSE|D_SORT_LAST, EMAIL_SORT_DATE, IP SortTestMethods, NULL, },
+  { NULL },
+  // clang-format on
+};
+
+/**
+ * long_name - Create a name longer than 128 characters
+ * @param buf    Buffer for the name
+ * @param suffix Text that makes the name unique
+ * @retval ptr Name
+ */
+static const char *long_name(struct Buffer *buf, const char *suffix)
+{
+  buf_reset(buf);
+  for (int i = 0; i < 14; i++)
+    buf_addstr(buf, "Long Name ");
+  buf_addstr(buf, suffix);
+  return buf_string(buf);
+}
+
+/**
+ * make_emails - Create a Mailbox of Emails with many ties
+ * @retval ptr Mailbox
+ */
+static struct Mailbox *make_emails(void)
+{
+  static const char *names[] = { "alice", "Alice", "bob", "", "carol", NULL };
+  static const char *subjects[] = { "apple", "Apple", NULL, "banana", "cherry" };
+
+  struct Mailbox *m = mailbox_new();
+  m->email_max = NUM_EMAILS;
+  m->msg_count = NUM_EMAILS;
+  m->emails = MUTT_MEM_CALLOC(NUM_EMAILS, struct Email *);
+  m->v2r = MUTT_MEM_CALLOC(NUM_EMAILS, int);
+
+  struct Buffer *buf = buf_pool_get();
+  for (int i = 0; i < NUM_EMAILS; i++)
+  {
+    struct Email *e = email_new();
+    e->index = i;
+    e->env = mutt_env_new();
+    e->body = mutt_body_new();
+
+    // Names that differ only after the 127th character, or only in case
+    const char *name = names[i % countof(names)];
+    if (!name)
+      name = long_name(buf, (i % 3) ? "Zed" : "Abe");
+    mutt_addrlist_append(&e->env->from, mutt_addr_create(name, "from@example.com"));
+    name = names[(i / 2) % countof(names)];
+    if (!name)
+      name = long_name(buf, (i % 4) ? "abe" : "ABE");
+    mutt_addrlist_append(&e->env->to, mutt_addr_create(name, "to@example.com"));
+
+    *(char **) &e->env->subject = mutt_str_dup(subjects[i % countof(subjects)]);
+    *(char **) &e->env->real_subj = e->env->subject;
+    e->date_sent = 1000000 + ((i * 7) % 5) * 3600;
+    e->received = 2000000 - ((i * 3) % 4) * 60;
+    e->score = ((i * 11) % 3) - 1;
+    e->body->length = (i % 4) * 100;
+    e->env->x_label = (i % 3) ? mutt_str_dup((i % 2) ? "work" : "home") : NULL;
+
+    m->emails[i] = e;
+  }
+  buf_pool_release(&buf);
+
+  return m;
+}
+
+/**
+ * shuffle_emails - Put the Emails in a different order
+ * @param m    Mailbox
+ * @param seed Pseudo-random seed
+ */
+static void shuffle_emails(struct Mailbox *m, unsigned int seed)
+{
+  for (int i = m->msg_count - 1; i > 0; i--)
+  {
+    seed = (seed * 1103515245) + 12345;
+    int j = (seed >> 16) % (i + 1);
+    struct Email *tmp = m->emails[i];
+    m->emails[i] = m->emails[j];
+    m->emails[j] = tmp;
+  }
+}
+
+/**
+ * email_compare_shim - Compare two Emails with mutt_compare_emails() - Implements ::sort_t - @ingroup sort_api
+ */
+static int email_compare_shim(const void *a, const void *b, void *sdata)
+{
+  const struct Email *ea = *(struct Email const *const *) a;
+  const struct Email *eb = *(struct Email const *const *) b;
+  const short *sorts = sdata;
+  return mutt_compare_emails(ea, eb, MUTT_MAILDIR, sorts[0], sorts[1]);
+}
+
+void test_mutt_sort_headers(void)
+{
+  // void mutt_sort_headers(struct MailboxView *mv, bool init);
+
+  TEST_CHECK(cs_register_variables(NeoMutt->sub->cs, Vars));
+
+  {
+    mutt_sort_headers(NULL, false);
+  }
+
+  static const short methods[] = {
+    EMAIL_SORT_DATE,  EMAIL_SORT_DATE_RECEIVED, EMAIL_SORT_FROM,
+    EMAIL_SORT_LABEL, EMAIL_SORT_SCORE,         EMAIL_SORT_SIZE,
+    EMAIL_SORT_SUBJECT, EMAIL_SORT_TO,          EMAIL_SORT_UNSORTED,
+  };
+
+  struct Mailbox *m = make_emails();
+  struct MailboxView mv = { 0 };
+  mv.mailbox = m;
+  struct Email *expected[NUM_EMAILS] = { 0 };
+  unsigned int seed = 1;
+
+  // The precomputed keys, and the radix sort, must match the comparator
+  for (int i = 0; i < countof(methods); i++)
+  {
+    for (int j = 0; j < countof(methods); j++)
+    {
+      for (int r = 0; r < 4; r++)
+      {
+        short sorts[2] = { methods[i], methods[j] };
+        if (r & 1)
+          sorts[0] |= SORT_REVERSE;
+        if (r & 2)
+          sorts[1] |= SORT_REVERSE;
+
+        cs_str_native_set(NeoMutt->sub->cs, "sort", sorts[0], NULL);
+        cs_str_native_set(NeoMutt->sub->cs, "sort_aux", sorts[1], NULL);
+
+        shuffle_emails(m, seed++);
+        memcpy(expected, m->emails, sizeof(expected));
+        mutt_qsort_r(expected, NUM_EMAILS, sizeof(struct Email *), email_compare_shim, sorts);
+
+        mutt_sort_headers(&mv, false);
+
+        for (int n = 0; n < NUM_EMAILS; n++)
+        {
+          if (!TEST_CHECK(m->emails[n] == expected[n]))
+          {
+            TEST_MSG("sort %d, sort_aux %d, position %d: index %d, expected %d",
+                     sorts[0], sorts[1], n, m->emails[n]->index, expected[n]->index);
+            break;
+          }
+          TEST_CHECK(m->emails[n]->msgno == n);
+        }
+      }
+    }
+  }
+
+  // Names longer than 127 characters are compared in full
+  {
+    cs_str_native_set(NeoMutt->sub->cs, "sort", EMAIL_SORT_FROM, NULL);
+    cs_str_native_set(NeoMutt->sub->cs, "sort_aux", EMAIL_SORT_UNSORTED, NULL);
+    shuffle_emails(m, seed++);
+    mutt_sort_headers(&mv, false);
+
+    struct Buffer *prev = buf_pool_get();
+    for (int n = 0; n < NUM_EMAILS; n++)
+    {
+      const char *name = mutt_get_name(TAILQ_FIRST(&m->emails[n]->env->from));
+      if ((n > 0) && !TEST_CHECK(mutt_istr_cmp(buf_string(prev), name) <= 0))
+        TEST_MSG("'%s' sorted before '%s'", buf_string(prev), name);
+      buf_strcpy(prev, name);
+    }
+    buf_pool_release(&prev);
+  }
+
+  FREE(&m->v2r);
+  mailbox_free(&m);
+
+  cs_str_reset(NeoMutt->sub->cs, "sort", NULL);
+  cs_str_reset(NeoMutt->sub->cs, "sort_aux", NULL);
+}
@@ -0,0 +1,575 @@
+/**
+ * @file
+ * Benchmark for rendering Expandos
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Render some typical `$index_format` and `$sidebar_format` strings over
+ * synthetic mailboxes, using both the tree of Nodes and the compiled Program.
+ *
+ * By default, this only checks that the two renderers agree.
+ * To measure them, set the environment variable `NEOMUTT_BENCHMARK`
+ * to the number of passes, e.g.
+ *
+ *   NEOMUTT_BENCHMARK=200 test/neomutt-test test_expando_benchmark
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "mutt/lib.h"
+#include "color/lib.h"
+#include "expando/lib.h"
+#include "common.h" // IWYU pragma: keep
+#include "mutt_thread.h"
+#include "test_common.h"
+
+/**
+ * enum BenchDomain - Expando Domains for the benchmark
+ */
+enum BenchDomain
+{
+  BD_EMAIL = 100,    ///< Synthetic Email
+  BD_MAILBOX,        ///< Synthetic Mailbox
+};
+
+/**
+ * enum BenchEmailUid - Expando UIDs for a synthetic Email, cf. IndexFormatDef
+ */
+enum BenchEmailUid
+{
+  BE_DATE = 1,       ///< %{...}, %[...]
+  BE_FROM,           ///< %L, %n
+  BE_FLAGS,          ///< %Z
+  BE_HIDDEN,         ///< %M
+  BE_LINES,          ///< %l
+  BE_NUMBER,         ///< %C
+  BE_SIZE,           ///< %c
+  BE_SUBJECT,        ///< %s
+  BE_TAGS,           ///< %g
+  BE_TREE,           ///< Thread tree, part of %s
+};
+
+/**
+ * enum BenchMailboxUid - Expando UIDs for a synthetic Mailbox, cf. SidebarFormatDef
+ */
+enum BenchMailboxUid
+{
+  BM_DESCRIPTION = 1, ///< %D
+  BM_FLAGGED,         ///< %F
+  BM_NAME,            ///< %B
+  BM_NEW_MAIL,        ///< %n
+  BM_TOTAL,           ///< %S
+  BM_UNREAD,          ///< %N
+};
+
+/**
+ * struct BenchEmail - A synthetic Email
+ */
+struct BenchEmail
+{
+  int number;            ///< Message number
+  const char *from;      ///< Author
+  const char *subject;   ///< Subject
+  const char *tags;      ///< Tags
+  char tree[16];         ///< Thread tree
+  char flags[4];         ///< Combined flags
+  time_t date;           ///< Date sent
+  long size;             ///< Size in bytes
+  int lines;             ///< Number of lines
+  int hidden;            ///< Hidden messages in the thread
+};
+
+/**
+ * struct BenchMailbox - A synthetic Mailbox
+ */
+struct BenchMailbox
+{
+  const char *name;      ///< Path
+  const char *desc;      ///< Description
+  int flagged;           ///< Number of flagged messages
+  int total;             ///< Number of messages
+  int unread;            ///< Number of unread messages
+  bool new_mail;         ///< Has new mail
+};
+
+static const char *Authors[] = {
+  "Alice Archer", "Bob", "Carol Chávez", "Dmitri Петров", "Eve", "李小龍",
+  "Frank Fitzgerald-Featherstonehaugh", "notifications@example.com",
+};
+
+static const char *Subjects[] = {
+  "Re: [PATCH 3/7] expando: flatten the tree",
+  "Meeting notes",
+  "Fwd: Quarterly report — final version",
+  "Re: Re: Re: lunch?",
+  "[neomutt/neomutt] Build failed on main (a1b2c3d)",
+  "日本語の件名",
+  "",
+};
+
+static const char *Tags[] = { "", "inbox", "inbox unread", "work todo" };
+
+static const char *Mailboxes[] = {
+  "INBOX", "lists/neomutt-devel", "lists/linux-kernel", "work/projects/2026",
+  "Archive", "Sent", "Drafts", "Trash",
+};
+
+/**
+ * parse_bench_date - Parse a Date Expando - Implements ExpandoDefinition::parse() - @ingroup expando_parse_api
+ */
+static struct ExpandoNode *parse_bench_date(const char *str, struct ExpandoFormat *fmt,
+                                            int did, int uid, ExpandoParserFlags flags,
+                                            const char **parsed_until,
+                                            struct ExpandoParseError *err)
+{
+  if (flags & EP_CONDITIONAL)
+    return node_conddate_parse(str, did, uid, parsed_until, err);
+
+  return node_expando_parse_enclosure(str, did, uid, (str[0] == '{') ? '}' : ']',
+                                      fmt, parsed_until, err);
+}
+
+/**
+ * parse_bench_subject - Parse a Subject Expando - Implements ExpandoDefinition::parse() - @ingroup expando_parse_api
+ *
+ * Like the Index, split the Subject into a tree and the text.
+ */
+static struct ExpandoNode *parse_bench_subject(const char *str, struct ExpandoFormat *fmt,
+                                               int did, int uid, ExpandoParserFlags flags,
+                                               const char **parsed_until,
+                                               struct ExpandoParseError *err)
+{
+  struct ExpandoNode *node_tree = node_expando_new(NULL, BD_EMAIL, BE_TREE);
+  struct ExpandoNode *node_subj = node_expando_new(NULL, did, uid);
+  struct ExpandoNode *node_cont = node_container_new();
+
+  node_expando_set_has_tree(node_tree, true);
+  node_cont->format = fmt;
+  node_add_child(node_cont, node_tree);
+  node_add_child(node_cont, node_subj);
+
+  *parsed_until = str + 1;
+  return node_cont;
+}
+
+static const struct ExpandoDefinition BenchIndexDef[] = {
+  // clang-format off
+  { "*", NULL, ED_GLOBAL, ED_GLO_PADDING_SOFT, node_padding_parse  },
+  { ">", NULL, ED_GLOBAL, ED_GLO_PADDING_HARD, node_padding_parse  },
+  { "|", NULL, ED_GLOBAL, ED_GLO_PADDING_EOL,  node_padding_parse  },
+  { "c", NULL, BD_EMAIL,  BE_SIZE,             NULL                },
+  { "C", NULL, BD_EMAIL,  BE_NUMBER,           NULL                },
+  { "g", NULL, BD_EMAIL,  BE_TAGS,             NULL                },
+  { "l", NULL, BD_EMAIL,  BE_LINES,            NULL                },
+  { "L", NULL, BD_EMAIL,  BE_FROM,             NULL                },
+  { "M", NULL, BD_EMAIL,  BE_HIDDEN,           NULL                },
+  { "n", NULL, BD_EMAIL,  BE_FROM,             NULL                },
+  { "s", NULL, BD_EMAIL,  BE_SUBJECT,          parse_bench_subject },
+  { "Z", NULL, BD_EMAIL,  BE_FLAGS,            NULL                },
+  { "[", NULL, BD_EMAIL,  BE_DATE,             parse_bench_date    },
+  { "{", NULL, BD_EMAIL,  BE_DATE,             parse_bench_date    },
+  { NULL, NULL, 0, -1, NULL }
+  // clang-format on
+};
+
+static const struct ExpandoDefinition BenchSidebarDef[] = {
+  // clang-format off
+  { "*", NULL, ED_GLOBAL,  ED_GLO_PADDING_SOFT, node_padding_parse },
+  { ">", NULL, ED_GLOBAL,  ED_GLO_PADDING_HARD, node_padding_parse },
+  { "|", NULL, ED_GLOBAL,  ED_GLO_PADDING_EOL,  node_padding_parse },
+  { "B", NULL, BD_MAILBOX, BM_NAME,             NULL               },
+  { "D", NULL, BD_MAILBOX, BM_DESCRIPTION,      NULL               },
+  { "F", NULL, BD_MAILBOX, BM_FLAGGED,          NULL               },
+  { "n", NULL, BD_MAILBOX, BM_NEW_MAIL,         NULL               },
+  { "N", NULL, BD_MAILBOX, BM_UNREAD,           NULL               },
+  { "S", NULL, BD_MAILBOX, BM_TOTAL,            NULL               },
+  { NULL, NULL, 0, -1, NULL }
+  // clang-format on
+};
+
+static void email_date(const struct ExpandoNode *node, void *data,
+                       MuttFormatFlags flags, struct Buffer *buf)
+{
+  const struct BenchEmail *be = data;
+  char tmp[128] = { 0 };
+  struct tm tm = mutt_date_localtime(be->date);
+  strftime(tmp, sizeof(tmp), node->text ? node->text : "%y-%m-%d", &tm);
+  buf_strcpy(buf, tmp);
+}
+
+static long email_date_num(const struct ExpandoNode *node, void *data, MuttFormatFlags flags)
+{
+  const struct BenchEmail *be = data;
+  return be->date;
+}
+
+static void email_from(const struct ExpandoNode *node, void *data,
+                       MuttFormatFlags flags, struct Buffer *buf)
+{
+  const struct BenchEmail *be = data;
+  buf_strcpy(buf, be->from);
+}
+
+static void email_flags(const struct ExpandoNode *node, void *data,
+                        MuttFormatFlags flags, struct Buffer *buf)
+{
+  const struct BenchEmail *be = data;
+  buf_strcpy(buf, be->flags);
+}
+
+static long email_hidden_num(const struct ExpandoNode *node, void *data, MuttFormatFlags flags)
+{
+  const struct BenchEmail *be = data;
+  return be->hidden;
+}
+
+static long email_lines_num(const struct ExpandoNode *node, void *data, MuttFormatFlags flags)
+{
+  const struct BenchEmail *be = data;
+  return be->lines;
+}
+
+static long email_number_num(const struct ExpandoNode *node, void *data, MuttFormatFlags flags)
+{
+  const struct BenchEmail *be = data;
+  return be->number;
+}
+
+static void email_size(const struct ExpandoNode *node, void *data,
+                       MuttFormatFlags flags, struct Buffer *buf)
+{
+  const struct BenchEmail *be = data;
+  if (be->size < 1024)
+    buf_printf(buf, "%ld", be->size);
+  else
+    buf_printf(buf, "%.1fK", be->size / 1024.0);
+}
+
+static long email_size_num(const struct ExpandoNode *node, void *data, MuttFormatFlags flags)
+{
+  const struct BenchEmail *be = data;
+  return be->size;
+}
+
+static void email_subject(const struct ExpandoNode *node, void *data,
+                          MuttFormatFlags flags, struct Buffer *buf)
+{
+  const struct BenchEmail *be = data;
+  buf_strcpy(buf, be->subject);
+}
+
+static void email_tags(const struct ExpandoNode *node, void *data,
+                       MuttFormatFlags flags, struct Buffer *buf)
+{
+  const struct BenchEmail *be = data;
+  buf_strcpy(buf, be->tags);
+}
+
+static void email_tree(const struct ExpandoNode *node, void *data,
+                       MuttFormatFlags flags, struct Buffer *buf)
+{
+  const struct BenchEmail *be = data;
+  if (!(flags & MUTT_FORMAT_TREE))
+    return;
+
+  node_expando_set_color(node, MT_COLOR_TREE);
+  buf_strcpy(buf, be->tree);
+}
+
+static const struct ExpandoRenderCallback BenchIndexCallbacks[] = {
+  // clang-format off
+  { BD_EMAIL, BE_DATE,    email_date,    email_date_num   },
+  { BD_EMAIL, BE_FLAGS,   email_flags,   NULL             },
+  { BD_EMAIL, BE_FROM,    email_from,    NULL             },
+  { BD_EMAIL, BE_HIDDEN,  NULL,          email_hidden_num },
+  { BD_EMAIL, BE_LINES,   NULL,          email_lines_num  },
+  { BD_EMAIL, BE_NUMBER,  NULL,          email_number_num },
+  { BD_EMAIL, BE_SIZE,    email_size,    email_size_num   },
+  { BD_EMAIL, BE_SUBJECT, email_subject, NULL             },
+  { BD_EMAIL, BE_TAGS,    email_tags,    NULL             },
+  { BD_EMAIL, BE_TREE,    email_tree,    NULL             },
+  { -1, -1, NULL, NULL },
+  // clang-format on
+};
+
+static void mailbox_description(const struct ExpandoNode *node, void *data,
+                                MuttFormatFlags flags, struct Buffer *buf)
+{
+  const struct BenchMailbox *bm = data;
+  buf_strcpy(buf, bm->desc ? bm->desc : bm->name);
+}
+
+static long mailbox_flagged_num(const struct ExpandoNode *node, void *data, MuttFormatFlags flags)
+{
+  const struct BenchMailbox *bm = data;
+  return bm->flagged;
+}
+
+static void mailbox_name(const struct ExpandoNode *node, void *data,
+                         MuttFormatFlags flags, struct Buffer *buf)
+{
+  const struct BenchMailbox *bm = data;
+  buf_strcpy(buf, bm->name);
+}
+
+static void mailbox_new_mail(const struct ExpandoNode *node, void *data,
+                             MuttFormatFlags flags, struct Buffer *buf)
+{
+  const struct BenchMailbox *bm = data;
+  buf_strcpy(buf, bm->new_mail ? "N" : " ");
+}
+
+static long mailbox_new_mail_num(const struct ExpandoNode *node, void *data, MuttFormatFlags flags)
+{
+  const struct BenchMailbox *bm = data;
+  return bm->new_mail;
+}
+
+static long mailbox_total_num(const struct ExpandoNode *node, void *data, MuttFormatFlags flags)
+{
+  const struct BenchMailbox *bm = data;
+  return bm->total;
+}
+
+static long mailbox_unread_num(const struct ExpandoNode *node, void *data, MuttFormatFlags flags)
+{
+  const struct BenchMailbox *bm = data;
+  return bm->unread;
+}
+
+static const struct ExpandoRenderCallback BenchSidebarCallbacks[] = {
+  // clang-format off
+  { BD_MAILBOX, BM_DESCRIPTION, mailbox_description, NULL                 },
+  { BD_MAILBOX, BM_FLAGGED,     NULL,                mailbox_flagged_num  },
+  { BD_MAILBOX, BM_NAME,        mailbox_name,        NULL                 },
+  { BD_MAILBOX, BM_NEW_MAIL,    mailbox_new_mail,    mailbox_new_mail_num },
+  { BD_MAILBOX, BM_TOTAL,       NULL,                mailbox_total_num    },
+  { BD_MAILBOX, BM_UNREAD,      NULL,                mailbox_unread_num   },
+  { -1, -1, NULL, NULL },
+  // clang-format on
+};
+
+/**
+ * struct BenchFormat - A format string to benchmark
+ */
+struct BenchFormat
+{
+  const char *name;                           ///< Short description
+  const char *format;                         ///< Format string
+  const struct ExpandoDefinition *defs;       ///< Expando definitions
+  const struct ExpandoRenderCallback *erc;    ///< Render callbacks
+  int cols;                                   ///< Screen width
+};
+
+static const struct BenchFormat Formats[] = {
+  // clang-format off
+  { "index",   "%4C %Z %{%b %d} %-15.15L (%<l?%4l&%4c>) %s",
+    BenchIndexDef, BenchIndexCallbacks, 120 },
+  { "index",   "%4C %Z %<[1y?%<[1d?%[    %H:%M]&%[%a %d %b]>&%[%d/%m/%Y]> %-20.20n %?M?(#%03M)&(%4c)? %s%*  %g",
+    BenchIndexDef, BenchIndexCallbacks, 200 },
+  { "index",   "%-4C %Z %-30.30s %> %-20.20L %{%Y-%m-%d} %5c",
+    BenchIndexDef, BenchIndexCallbacks, 80 },
+  { "sidebar", "%D%*  %n",
+    BenchSidebarDef, BenchSidebarCallbacks, 30 },
+  { "sidebar", "%B%<F? [%F]>%* %<N?%N/>%S",
+    BenchSidebarDef, BenchSidebarCallbacks, 40 },
+  { "sidebar", "%-20B%?n?%4N/&    ?%4S%|.",
+    BenchSidebarDef, BenchSidebarCallbacks, 30 },
+  { NULL, NULL, NULL, NULL, 0 },
+  // clang-format on
+};
+
+/**
+ * bench_emails - Create a synthetic Mailbox of Emails
+ * @param num Number of Emails
+ * @retval ptr Array of Emails
+ */
+static struct BenchEmail *bench_emails(int num)
+{
+  static const char tree_chars[] = { MUTT_TREE_LTEE, MUTT_TREE_HLINE,
+                                     MUTT_TREE_VLINE, MUTT_TREE_SPACE };
+  const time_t now = mutt_date_now();
+
+  struct BenchEmail *emails = MUTT_MEM_CALLOC(num, struct BenchEmail);
+  for (int i = 0; i < num; i++)
+  {
+    struct BenchEmail *be = &emails[i];
+    be->number = i + 1;
+    be->from = Authors[i % countof(Authors)];
+    be->subject = Subjects[(i * 7) % countof(Subjects)];
+    be->tags = Tags[(i * 3) % countof(Tags)];
+    be->date = now - (i * 7919L) % (3 * 365 * 24 * 3600L);
+    be->size = (i * 7877L) % 500000;
+    be->lines = (i * 31) % 4000;
+    be->hidden = (i % 11 == 0) ? (i % 5) : 0;
+
+    snprintf(be->flags, sizeof(be->flags), "%c%c", "  NO!r"[i % 6], " +T"[i % 3]);
+
+    // Every other Email is a reply, nested up to four deep
+    const int depth = (i % 2) ? (i % 4) + 1 : 0;
+    int t = 0;
+    for (int d = 1; d < depth; d++)
+      be->tree[t++] = tree_chars[(i + d) % countof(tree_chars)];
+    if (depth > 0)
+    {
+      be->tree[t++] = MUTT_TREE_LLCORNER;
+      be->tree[t++] = MUTT_TREE_RARROW;
+    }
+  }
+
+  return emails;
+}
+
+/**
+ * bench_mailboxes - Create a synthetic list of Mailboxes
+ * @param num Number of Mailboxes
+ * @retval ptr Array of Mailboxes
+ */
+static struct BenchMailbox *bench_mailboxes(int num)
+{
+  struct BenchMailbox *mailboxes = MUTT_MEM_CALLOC(num, struct BenchMailbox);
+  for (int i = 0; i < num; i++)
+  {
+    struct BenchMailbox *bm = &mailboxes[i];
+    bm->name = Mailboxes[i % countof(Mailboxes)];
+    bm->desc = (i % 3) ? NULL : "Description";
+    bm->total = (i * 977) % 20000;
+    bm->unread = (i % 4) ? bm->total / (i + 2) : 0;
+    bm->flagged = (i % 5) ? 0 : i;
+    bm->new_mail = (bm->unread > 0);
+  }
+
+  return mailboxes;
+}
+
+/**
+ * now_ns - Get a monotonic time in nanoseconds
+ * @retval num Time
+ */
+static uint64_t now_ns(void)
+{
+  struct timespec ts = { 0 };
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/**
+ * bench_format - Render a format string over some data
+ * @param bf     Format to test
+ * @param rows   Array of data
+ * @param size   Size of each item of data
+ * @param num    Number of items of data
+ * @param passes Number of times to render the data (0 to just compare)
+ */
+static void bench_format(const struct BenchFormat *bf, void *rows, size_t size,
+                         int num, int passes)
+{
+  struct Buffer *err = buf_pool_get();
+  struct Expando *exp = expando_parse(bf->format, bf->defs, err);
+  TEST_CHECK(exp != NULL);
+  TEST_CHECK(buf_is_empty(err));
+  buf_pool_release(&err);
+  if (!exp)
+    return;
+
+  const MuttFormatFlags flags = MUTT_FORMAT_INDEX | MUTT_FORMAT_TREE;
+  struct Buffer *buf_tree = buf_pool_get();
+  struct Buffer *buf_prog = buf_pool_get();
+
+  // The compiled Program must match the tree exactly
+  for (int i = 0; i < num; i++)
+  {
+    void *data = (char *) rows + (i * size);
+    for (int cols = 0; cols <= bf->cols; cols += (cols < 10) ? 1 : 10)
+    {
+      buf_reset(buf_tree);
+      buf_reset(buf_prog);
+      int rc_tree = node_render(exp->node, bf->erc, buf_tree, cols, data, flags);
+      int rc_prog = expando_render(exp, bf->erc, data, flags, cols, buf_prog);
+      if (!TEST_CHECK_NUM_EQ(rc_prog, rc_tree) ||
+          !TEST_CHECK_STR_EQ(buf_string(buf_prog), buf_string(buf_tree)))
+      {
+        TEST_MSG("Format: %s, row %d, cols %d", bf->format, i, cols);
+        goto done;
+      }
+    }
+  }
+
+  if (passes > 0)
+  {
+    uint64_t start = now_ns();
+    for (int p = 0; p < passes; p++)
+    {
+      for (int i = 0; i < num; i++)
+      {
+        buf_reset(buf_tree);
+        node_render(exp->node, bf->erc, buf_tree, bf->cols, (char *) rows + (i * size), flags);
+      }
+    }
+    const double ns_tree = (double) (now_ns() - start) / ((double) passes * num);
+
+    start = now_ns();
+    for (int p = 0; p < passes; p++)
+    {
+      for (int i = 0; i < num; i++)
+      {
+        buf_reset(buf_prog);
+        expando_render(exp, bf->erc, (char *) rows + (i * size), flags, bf->cols, buf_prog);
+      }
+    }
+    const double ns_prog = (double) (now_ns() - start) / ((double) passes * num);
+
+    printf("\n  %-7s %3d cols  tree %7.0f ns  compiled %7.0f ns  %5.2fx  %s",
+           bf->name, bf->cols, ns_tree, ns_prog, ns_tree / ns_prog, bf->format);
+  }
+
+done:
+  buf_pool_release(&buf_tree);
+  buf_pool_release(&buf_prog);
+  expando_free(&exp);
+}
+
+void test_expando_benchmark(void)
+{
+  const int passes = atoi(NONULL(mutt_str_getenv("NEOMUTT_BENCHMARK")));
+  const int num_emails = (passes > 0) ? 1000 : 50;
+  const int num_mailboxes = (passes > 0) ? 100 : 20;
+
+  struct BenchEmail *emails = bench_emails(num_emails);
+  struct BenchMailbox *mailboxes = bench_mailboxes(num_mailboxes);
+
+  for (const struct BenchFormat *bf = Formats; bf->name; bf++)
+  {
+    if (bf->erc == BenchIndexCallbacks)
+      bench_format(bf, emails, sizeof(*emails), num_emails, passes);
+    else
+      bench_format(bf, mailboxes, sizeof(*mailboxes), num_mailboxes, passes);
+  }
+
+  if (passes > 0)
+    printf("\n");
+
+  FREE(&emails);
+  FREE(&mailboxes);
+}
@@ -0,0 +1,172 @@
+/**
+ * @file
+ * Test code for Compiled Expandos
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stddef.h>
+#include "mutt/lib.h"
+#include "expando/lib.h"
+#include "common.h" // IWYU pragma: keep
+#include "test_common.h"
+
+static void get_apple(const struct ExpandoNode *node, void *data,
+                      MuttFormatFlags flags, struct Buffer *buf)
+{
+  buf_strcpy(buf, "apple");
+}
+
+static void get_banana(const struct ExpandoNode *node, void *data,
+                       MuttFormatFlags flags, struct Buffer *buf)
+{
+  buf_strcpy(buf, "banana");
+}
+
+static long get_zero(const struct ExpandoNode *node, void *data, MuttFormatFlags flags)
+{
+  return 0;
+}
+
+void test_expando_program(void)
+{
+  // struct ExpandoProgram *program_compile(const struct ExpandoNode *node);
+  // void program_free(struct ExpandoProgram **ptr);
+  // int program_render(struct ExpandoProgram *prog, const struct ExpandoRenderCallback *erc, struct Buffer *buf, int max_cols, void *data, MuttFormatFlags flags);
+
+  static const struct ExpandoDefinition FormatDef[] = {
+    // clang-format off
+    { "*", "padding-soft", ED_GLOBAL, ED_GLO_PADDING_SOFT, node_padding_parse },
+    { ">", "padding-hard", ED_GLOBAL, ED_GLO_PADDING_HARD, node_padding_parse },
+    { "|", "padding-eol",  ED_GLOBAL, ED_GLO_PADDING_EOL,  node_padding_parse },
+    { "a", "apple",        1,         2,                   NULL },
+    { "z", "zero",         1,         3,                   NULL },
+    { NULL, NULL, 0, -1, NULL }
+    // clang-format on
+  };
+
+  static const struct ExpandoRenderCallback AppleRender[] = {
+    // clang-format off
+    { 1, 2, get_apple, NULL     },
+    { 1, 3, NULL,      get_zero },
+    { -1, -1, NULL, NULL },
+    // clang-format on
+  };
+
+  static const struct ExpandoRenderCallback BananaRender[] = {
+    // clang-format off
+    { 1, 2, get_banana, NULL     },
+    { 1, 3, NULL,       get_zero },
+    { -1, -1, NULL, NULL },
+    // clang-format on
+  };
+
+  {
+    program_free(NULL);
+
+    struct ExpandoProgram *prog = NULL;
+    program_free(&prog);
+
+    struct Buffer *buf = buf_pool_get();
+    TEST_CHECK(program_render(NULL, AppleRender, buf, 80, NULL, MUTT_FORMAT_NO_FLAGS) == 0);
+
+    prog = program_compile(NULL);
+    TEST_CHECK(prog != NULL);
+    TEST_CHECK(ARRAY_SIZE(&prog->ops) == 1);
+    TEST_CHECK(ARRAY_GET(&prog->ops, 0)->code == EOP_EMPTY);
+    TEST_CHECK(program_render(prog, AppleRender, buf, 80, NULL, MUTT_FORMAT_NO_FLAGS) == 0);
+    TEST_CHECK(buf_is_empty(buf));
+    program_free(&prog);
+    TEST_CHECK(prog == NULL);
+
+    buf_pool_release(&buf);
+  }
+
+  {
+    struct Buffer *err = buf_pool_get();
+    struct Expando *exp = expando_parse("x%ay%<z?t&f>%>-", FormatDef, err);
+    TEST_CHECK(exp != NULL);
+    TEST_CHECK(exp->program != NULL);
+
+    // Padding(Container(Text, Expando, Text, Condition(CondBool, Text, Text)), Empty)
+    static const enum ExpandoOpCode codes[] = {
+      EOP_PAD_HARD, EOP_CONTAINER, EOP_TEXT,     EOP_EXPANDO, EOP_TEXT,
+      EOP_CONDITION, EOP_CONDBOOL, EOP_TEXT,     EOP_TEXT,    EOP_EMPTY,
+    };
+
+    struct ExpandoProgram *prog = exp->program;
+    TEST_CHECK(ARRAY_SIZE(&prog->ops) == countof(codes));
+    for (int i = 0; i < countof(codes); i++)
+    {
+      struct ExpandoOp *op = ARRAY_GET(&prog->ops, i);
+      if (!TEST_CHECK(op && (op->code == codes[i])))
+        TEST_MSG("Op %d", i);
+    }
+
+    struct ExpandoOp *op = ARRAY_GET(&prog->ops, 0);
+    TEST_CHECK(op->next == 10);
+    TEST_CHECK(op->cols == 1);
+    op = ARRAY_GET(&prog->ops, 1);
+    TEST_CHECK(op->next == 9);
+    TEST_CHECK(op->exact_kids);
+    op = ARRAY_GET(&prog->ops, 2);
+    TEST_CHECK((op->len == 1) && (op->cols == 1));
+
+    struct Buffer *buf = buf_pool_get();
+    TEST_CHECK(expando_render(exp, AppleRender, NULL, MUTT_FORMAT_NO_FLAGS, 12, buf) == 12);
+    TEST_CHECK_STR_EQ(buf_string(buf), "xappleyf----");
+
+    // Rebind to different callbacks
+    buf_reset(buf);
+    TEST_CHECK(expando_render(exp, BananaRender, NULL, MUTT_FORMAT_NO_FLAGS, 12, buf) == 12);
+    TEST_CHECK_STR_EQ(buf_string(buf), "xbananayf---");
+
+    // Too narrow, the Container must be truncated
+    buf_reset(buf);
+    TEST_CHECK(expando_render(exp, AppleRender, NULL, MUTT_FORMAT_NO_FLAGS, 4, buf) == 4);
+    TEST_CHECK_STR_EQ(buf_string(buf), "xapp");
+
+    buf_pool_release(&buf);
+    buf_pool_release(&err);
+    expando_free(&exp);
+  }
+
+  {
+    // Non-ASCII text and padding are measured when rendering
+    struct Buffer *err = buf_pool_get();
+    struct Expando *exp = expando_parse("é%a%|─", FormatDef, err);
+    TEST_CHECK(exp != NULL);
+
+    struct ExpandoProgram *prog = exp->program;
+    struct ExpandoOp *op = ARRAY_GET(&prog->ops, 0);
+    TEST_CHECK((op->code == EOP_PAD_EOL) && (op->cols == -1) && !op->exact);
+    op = ARRAY_GET(&prog->ops, 2);
+    TEST_CHECK((op->code == EOP_TEXT) && (op->cols == -1));
+
+    struct Buffer *buf = buf_pool_get();
+    TEST_CHECK(expando_render(exp, AppleRender, NULL, MUTT_FORMAT_NO_FLAGS, 8, buf) == 8);
+    TEST_CHECK_STR_EQ(buf_string(buf), "éapple──");
+
+    buf_pool_release(&buf);
+    buf_pool_release(&err);
+    expando_free(&exp);
+  }
+}
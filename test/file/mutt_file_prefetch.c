@@ -0,0 +1,72 @@
+/**
+ * @file
+ * Test code for mutt_file_prefetch()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "mutt/lib.h"
+#include "test_common.h"
+
+void test_mutt_file_prefetch(void)
+{
+  // void mutt_file_prefetch(const char *path);
+
+  {
+    mutt_file_prefetch(NULL);
+    TEST_CHECK_(1, "mutt_file_prefetch(NULL)");
+  }
+
+  {
+    mutt_file_prefetch("/does/not/exist");
+    TEST_CHECK_(1, "mutt_file_prefetch(\"/does/not/exist\")");
+  }
+
+  {
+    // The file isn't changed, and an open descriptor doesn't move
+    static const char text[] = "apple banana cherry\n";
+    struct Buffer *path = buf_pool_get();
+    test_gen_path(path, "%s/tmp/prefetchXXXXXX");
+
+    int fd = mkstemp(path->data);
+    if (TEST_CHECK(fd >= 0))
+    {
+      TEST_CHECK(write(fd, text, sizeof(text) - 1) == (sizeof(text) - 1));
+      TEST_CHECK(lseek(fd, 6, SEEK_SET) == 6);
+
+      mutt_file_prefetch(buf_string(path));
+
+      TEST_CHECK(lseek(fd, 0, SEEK_CUR) == 6);
+      char buf[64] = { 0 };
+      TEST_CHECK(read(fd, buf, sizeof(buf)) == (sizeof(text) - 7));
+      TEST_CHECK_STR_EQ(buf, text + 6);
+      TEST_CHECK(mutt_file_get_size(buf_string(path)) == (sizeof(text) - 1));
+
+      close(fd);
+      unlink(buf_string(path));
+    }
+    buf_pool_release(&path);
+  }
+}
@@ -0,0 +1,399 @@
+/**
+ * @file
+ * Benchmark for the Hash Table
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Fill Hash Tables with synthetic Message-IDs and config-style names, using
+ * both the Hash Table and a reference copy of the original chained table,
+ * which had a fixed number of buckets.
+ *
+ * By default, this only checks that the two agree.
+ * To measure them, set the environment variable `NEOMUTT_BENCHMARK`
+ * to the number of passes, e.g.
+ *
+ *   NEOMUTT_BENCHMARK=5 test/neomutt-test test_hash_benchmark
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "mutt/lib.h"
+#include "test_common.h"
+
+#define SOME_PRIME 149711
+
+/**
+ * struct RefHashTable - The original Hash Table
+ *
+ * The number of buckets never changes.
+ * Extra elements are chained together.
+ */
+struct RefHashTable
+{
+  size_t num_elems;        ///< Number of buckets in the Hash Table
+  struct HashElem **table; ///< Array of Hash keys
+};
+
+/**
+ * ref_gen_hash_string - Generate a hash from a string, as it was
+ * @param key       Key to hash
+ * @param num_elems Number of buckets
+ * @retval num Bucket number
+ */
+static size_t ref_gen_hash_string(const char *key, size_t num_elems)
+{
+  size_t hash = 0;
+  const unsigned char *s = (const unsigned char *) key;
+
+  while (*s != '\0')
+    hash += ((hash << 7) + *s++);
+  hash = (hash * SOME_PRIME) % num_elems;
+
+  return hash;
+}
+
+/**
+ * ref_hash_new - Create a reference Hash Table
+ * @param num_elems Number of buckets
+ * @retval ptr New Hash Table
+ */
+static struct RefHashTable *ref_hash_new(size_t num_elems)
+{
+  struct RefHashTable *table = MUTT_MEM_CALLOC(1, struct RefHashTable);
+  if (num_elems == 0)
+    num_elems = 2;
+  table->num_elems = num_elems;
+  table->table = MUTT_MEM_CALLOC(num_elems, struct HashElem *);
+  return table;
+}
+
+/**
+ * ref_hash_insert - Add a string to a reference Hash Table
+ * @param table Hash Table
+ * @param key   Key
+ * @param data  Data to associate with the key
+ * @retval ptr  Newly inserted HashElem
+ * @retval NULL The key is already present
+ *
+ * Each chain is kept sorted, like mutt_hash_insert().
+ */
+static struct HashElem *ref_hash_insert(struct RefHashTable *table,
+                                        const char *key, void *data)
+{
+  struct HashElem *he = MUTT_MEM_CALLOC(1, struct HashElem);
+  size_t hash = ref_gen_hash_string(key, table->num_elems);
+  he->key.strkey = key;
+  he->data = data;
+
+  struct HashElem *tmp = NULL, *last = NULL;
+  for (tmp = table->table[hash], last = NULL; tmp; last = tmp, tmp = tmp->next)
+  {
+    const int rc = mutt_str_cmp(tmp->key.strkey, key);
+    if (rc == 0)
+    {
+      FREE(&he);
+      return NULL;
+    }
+    if (rc > 0)
+      break;
+  }
+  if (last)
+    last->next = he;
+  else
+    table->table[hash] = he;
+  he->next = tmp;
+  return he;
+}
+
+/**
+ * ref_hash_find - Find a string in a reference Hash Table
+ * @param table Hash Table
+ * @param key   Key
+ * @retval ptr Data associated with the key
+ */
+static void *ref_hash_find(const struct RefHashTable *table, const char *key)
+{
+  size_t hash = ref_gen_hash_string(key, table->num_elems);
+  for (struct HashElem *he = table->table[hash]; he; he = he->next)
+  {
+    if (mutt_str_equal(key, he->key.strkey))
+      return he->data;
+  }
+  return NULL;
+}
+
+/**
+ * ref_hash_free - Free a reference Hash Table
+ * @param ptr Hash Table to free
+ */
+static void ref_hash_free(struct RefHashTable **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct RefHashTable *table = *ptr;
+  for (size_t i = 0; i < table->num_elems; i++)
+  {
+    struct HashElem *he = table->table[i];
+    while (he)
+    {
+      struct HashElem *next = he->next;
+      FREE(&he);
+      he = next;
+    }
+  }
+  FREE(&table->table);
+  FREE(ptr);
+}
+
+/**
+ * bench_random - Get a pseudo-random number
+ * @param seed Random state
+ * @retval num Random number
+ *
+ * The same seed always generates the same keys.
+ */
+static uint32_t bench_random(uint32_t *seed)
+{
+  *seed = (*seed * 1103515245) + 12345;
+  return (*seed >> 16) & 0x7fff;
+}
+
+/**
+ * now_ns - Get a monotonic time in nanoseconds
+ * @retval num Time
+ */
+static uint64_t now_ns(void)
+{
+  struct timespec ts = { 0 };
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/**
+ * make_msgids - Create some synthetic Message-IDs
+ * @param num  Number of keys
+ * @param seed Random state
+ * @retval ptr Array of keys, which must be freed
+ *
+ * Some of the Message-IDs are repeated, like the References of a thread.
+ */
+static char **make_msgids(size_t num, uint32_t *seed)
+{
+  static const char *Hosts[] = {
+    "mail.example.com", "neomutt.org", "localhost.localdomain", "mx1.example.net",
+  };
+
+  char **keys = MUTT_MEM_CALLOC(num, char *);
+  char buf[128] = { 0 };
+  for (size_t i = 0; i < num; i++)
+  {
+    if ((i > 0) && ((bench_random(seed) % 16) == 0))
+    {
+      keys[i] = mutt_str_dup(keys[bench_random(seed) % i]);
+      continue;
+    }
+
+    snprintf(buf, sizeof(buf), "<%04x%04x.%zu.%u@%s>", bench_random(seed),
+             bench_random(seed), i, bench_random(seed) % 1000,
+             Hosts[bench_random(seed) % countof(Hosts)]);
+    keys[i] = mutt_str_dup(buf);
+  }
+  return keys;
+}
+
+/**
+ * make_config_names - Create some config-style names
+ * @param num  Number of keys
+ * @param seed Random state
+ * @retval ptr Array of keys, which must be freed
+ */
+static char **make_config_names(size_t num, uint32_t *seed)
+{
+  static const char *Words[] = {
+    "index", "pager", "sidebar", "format", "color", "sort", "mail", "check",
+    "header", "cache", "imap", "smtp", "crypt", "use", "show", "auto",
+  };
+
+  char **keys = MUTT_MEM_CALLOC(num, char *);
+  char buf[128] = { 0 };
+  for (size_t i = 0; i < num; i++)
+  {
+    snprintf(buf, sizeof(buf), "%s_%s_%zu", Words[bench_random(seed) % countof(Words)],
+             Words[bench_random(seed) % countof(Words)], i);
+    keys[i] = mutt_str_dup(buf);
+  }
+  return keys;
+}
+
+/**
+ * free_keys - Free an array of keys
+ * @param keys Array of keys
+ * @param num  Number of keys
+ */
+static void free_keys(char ***keys, size_t num)
+{
+  for (size_t i = 0; i < num; i++)
+    FREE(&(*keys)[i]);
+  FREE(keys);
+}
+
+/**
+ * bench_compare - Check that both Hash Tables agree
+ * @param keys    Keys to insert
+ * @param num     Number of keys
+ * @param buckets Number of buckets to create
+ * @retval true They agree
+ */
+static bool bench_compare(char **keys, size_t num, size_t buckets)
+{
+  struct RefHashTable *ref = ref_hash_new(buckets);
+  struct HashTable *table = mutt_hash_new(buckets, MUTT_HASH_NO_FLAGS);
+  bool ok = true;
+
+  for (size_t i = 0; ok && (i < num); i++)
+  {
+    const bool added_ref = ref_hash_insert(ref, keys[i], keys[i]);
+    const bool added_new = mutt_hash_insert(table, keys[i], keys[i]);
+    ok = TEST_CHECK(added_new == added_ref);
+  }
+
+  for (size_t i = 0; ok && (i < num); i++)
+  {
+    ok = TEST_CHECK(mutt_hash_find(table, keys[i]) == ref_hash_find(ref, keys[i]));
+  }
+
+  // Keys that are absent, but share a prefix with the present ones
+  char buf[128] = { 0 };
+  for (size_t i = 0; ok && (i < num); i += 7)
+  {
+    snprintf(buf, sizeof(buf), "%sx", keys[i]);
+    ok = TEST_CHECK(!mutt_hash_find(table, buf) && !ref_hash_find(ref, buf));
+  }
+
+  mutt_hash_free(&table);
+  ref_hash_free(&ref);
+  return ok;
+}
+
+/**
+ * bench_time - Time both Hash Tables
+ * @param name    Description of the test
+ * @param keys    Keys to insert
+ * @param num     Number of keys
+ * @param buckets Number of buckets to create
+ * @param finds   Number of lookups per pass
+ * @param passes  Number of times to run the test
+ */
+static void bench_time(const char *name, char **keys, size_t num,
+                       size_t buckets, size_t finds, int passes)
+{
+  double ins_ref = 0, ins_new = 0, find_ref = 0, find_new = 0;
+  size_t found = 0;
+
+  for (int p = 0; p < passes; p++)
+  {
+    uint64_t start = now_ns();
+    struct RefHashTable *ref = ref_hash_new(buckets);
+    for (size_t i = 0; i < num; i++)
+      ref_hash_insert(ref, keys[i], keys[i]);
+    ins_ref += now_ns() - start;
+
+    start = now_ns();
+    for (size_t i = 0; i < finds; i++)
+      found += (ref_hash_find(ref, keys[i % num]) != NULL);
+    find_ref += now_ns() - start;
+    ref_hash_free(&ref);
+
+    start = now_ns();
+    struct HashTable *table = mutt_hash_new(buckets, MUTT_HASH_NO_FLAGS);
+    for (size_t i = 0; i < num; i++)
+      mutt_hash_insert(table, keys[i], keys[i]);
+    ins_new += now_ns() - start;
+
+    start = now_ns();
+    for (size_t i = 0; i < finds; i++)
+      found += (mutt_hash_find(table, keys[i % num]) != NULL);
+    find_new += now_ns() - start;
+    mutt_hash_free(&table);
+  }
+
+  TEST_CHECK(found == (2 * finds * passes));
+
+  const double scale = 1000000.0 * passes;
+  printf("\n  %-8s %7zu buckets  insert: chained %8.1f ms  new %8.1f ms  %6.2fx",
+         name, buckets, ins_ref / scale, ins_new / scale, ins_ref / ins_new);
+  printf("\n  %-8s %7zu finds    find:   chained %8.1f ms  new %8.1f ms  %6.2fx",
+         "", finds, find_ref / scale, find_new / scale, find_ref / find_new);
+}
+
+void test_hash_benchmark(void)
+{
+  const int passes = atoi(NONULL(mutt_str_getenv("NEOMUTT_BENCHMARK")));
+  uint32_t seed = 1;
+
+  // Tables that are empty, small, exactly full and overfull
+  static const size_t buckets[] = { 0, 1, 2, 31, 500, 1031, 4096 };
+  static const size_t counts[] = { 0, 1, 3, 500, 1031, 2500 };
+
+  for (int c = 0; c < countof(counts); c++)
+  {
+    char **msgids = make_msgids(counts[c], &seed);
+    char **names = make_config_names(counts[c], &seed);
+
+    for (int b = 0; b < countof(buckets); b++)
+    {
+      if (!bench_compare(msgids, counts[c], buckets[b]) ||
+          !bench_compare(names, counts[c], buckets[b]))
+      {
+        TEST_MSG("%zu keys, %zu buckets", counts[c], buckets[b]);
+        break;
+      }
+    }
+
+    free_keys(&msgids, counts[c]);
+    free_keys(&names, counts[c]);
+  }
+
+  if (passes <= 0)
+    return;
+
+  // A mailbox's Message-IDs, in a table sized for them and one sized too small
+  const size_t num_msgids = 500000;
+  char **msgids = make_msgids(num_msgids, &seed);
+  printf("\n  %zu Message-IDs", num_msgids);
+  bench_time("msgid", msgids, num_msgids, num_msgids * 2, num_msgids * 4, passes);
+  bench_time("msgid", msgids, num_msgids, 1031, num_msgids * 4, passes);
+  free_keys(&msgids, num_msgids);
+
+  // The config set: about 1,200 variables in 500 buckets, looked up often
+  const size_t num_names = 1200;
+  char **names = make_config_names(num_names, &seed);
+  printf("\n  %zu config names", num_names);
+  bench_time("config", names, num_names, 500, 6000000, passes);
+  free_keys(&names, num_names);
+
+  printf("\n");
+}
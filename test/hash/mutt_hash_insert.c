@@ -24,7 +24,9 @@
 #include "config.h"
 #include "acutest.h"
 #include <stddef.h>
+#include <stdio.h>
 #include "mutt/lib.h"
+#include "test_common.h"
 
 void test_mutt_hash_insert(void)
 {
@@ -51,4 +53,41 @@ void test_mutt_hash_insert(void)
     TEST_CHECK(mutt_hash_insert(table, "", NULL) != NULL);
     mutt_hash_free(&table);
   }
+
+  {
+    // The table grows, but the HashElems don't move
+    struct HashTable *table = mutt_hash_new(4, MUTT_HASH_STRDUP_KEYS);
+    struct HashElem *first = mutt_hash_insert(table, "key0", "data0");
+    char key[32] = { 0 };
+    for (int i = 1; i < 1000; i++)
+    {
+      snprintf(key, sizeof(key), "key%d", i);
+      TEST_CHECK(mutt_hash_insert(table, key, NULL) != NULL);
+    }
+    TEST_CHECK_NUM_EQ(table->count, 1000);
+    TEST_CHECK(table->num_elems >= 1000);
+    TEST_CHECK(mutt_hash_find_elem(table, "key0") == first);
+    TEST_CHECK(!mutt_hash_insert(table, "key500", NULL));
+
+    int found = 0;
+    for (int i = 0; i < 1000; i++)
+    {
+      snprintf(key, sizeof(key), "key%d", i);
+      if (mutt_hash_find_elem(table, key))
+        found++;
+    }
+    TEST_CHECK_NUM_EQ(found, 1000);
+
+    int walked = 0;
+    struct HashWalkState state = { 0 };
+    while (mutt_hash_walk(table, &state))
+      walked++;
+    TEST_CHECK_NUM_EQ(walked, 1000);
+
+    mutt_hash_delete(table, "key500", NULL);
+    TEST_CHECK_NUM_EQ(table->count, 999);
+    TEST_CHECK(!mutt_hash_find(table, "key500"));
+    TEST_CHECK(mutt_hash_insert(table, "key500", NULL) != NULL);
+    mutt_hash_free(&table);
+  }
 }
@@ -0,0 +1,173 @@
+/**
+ * @file
+ * Test code for maildir_parse_ahead()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "core/lib.h"
+#include "email/lib.h"
+#include "maildir/mailbox.h"
+#include "maildir/mdemail.h"
+#include "maildir/shared.h"
+#include "test_common.h"
+
+#define NUM_MESSAGES 40
+
+static struct ConfigDef Vars[] = {
+  // clang-format off
+  { "auto_subscribe", DT_BOOL, false, 0, NULL, },
+  { "reply_regex", DT_REGEX, IP "^((re)(\\[[0-9]+\\])*:[ \t]*)*", 0, NULL, },
+  { NULL },
+  // clang-format on
+};
+
+/**
+ * make_maildir - Create a directory of messages
+ * @param dir Buffer for the directory name
+ * @param mda Array for the Maildir entries
+ */
+static void make_maildir(struct Buffer *dir, struct MdEmailArray *mda)
+{
+  test_gen_path(dir, "%s/tmp/XXXXXX");
+  TEST_CHECK(mkdtemp(dir->data) != NULL);
+
+  struct Buffer *fn = buf_pool_get();
+  for (int i = 0; i < NUM_MESSAGES; i++)
+  {
+    buf_printf(fn, "%s/%d.test:2,S", buf_string(dir), i);
+    FILE *fp = fopen(buf_string(fn), "w");
+    TEST_CHECK(fp != NULL);
+    fprintf(fp, "From: test@example.com\nSubject: message %d\n\nbody %d\n", i, i);
+    fclose(fp);
+
+    struct MdEmail *md = maildir_entry_new();
+    md->email = maildir_email_new();
+    buf_printf(fn, "%d.test:2,S", i);
+    md->email->path = buf_strdup(fn);
+    ARRAY_ADD(mda, md);
+  }
+  buf_pool_release(&fn);
+}
+
+/**
+ * check_maildir - Check that every message was parsed, then delete them
+ * @param dir Directory of messages
+ * @param mda Maildir entries
+ */
+static void check_maildir(struct Buffer *dir, struct MdEmailArray *mda)
+{
+  char subject[64] = { 0 };
+  struct Buffer *fn = buf_pool_get();
+
+  TEST_CHECK_NUM_EQ(ARRAY_SIZE(mda), NUM_MESSAGES);
+  for (int i = 0; i < NUM_MESSAGES; i++)
+  {
+    struct MdEmail *md = *ARRAY_GET(mda, i);
+    if (!TEST_CHECK(md->email != NULL))
+    {
+      TEST_MSG("Message %d was dropped", i);
+      continue;
+    }
+
+    TEST_CHECK(md->header_parsed);
+    TEST_CHECK(md->email->read);
+    snprintf(subject, sizeof(subject), "message %d", i);
+    TEST_CHECK_STR_EQ(md->email->env->subject, subject);
+
+    buf_printf(fn, "%s/%s", buf_string(dir), md->email->path);
+    unlink(buf_string(fn));
+  }
+
+  rmdir(buf_string(dir));
+  maildirarray_clear(mda);
+  buf_pool_release(&fn);
+}
+
+void test_maildir_parse_ahead(void)
+{
+  // void maildir_parse_ahead(const char *dir, struct MdEmailArray *mda, int read_ahead, struct HeaderCache *hc, struct Progress *progress, size_t num_done);
+
+  TEST_CHECK(cs_register_variables(NeoMutt->sub->cs, Vars));
+
+  {
+    maildir_parse_ahead(NULL, NULL, 16, NULL, NULL, 0);
+  }
+
+  // Without, and with, the read-ahead
+  static const int read_aheads[] = { 0, 1, 16, 64 };
+  for (int i = 0; i < countof(read_aheads); i++)
+  {
+    TEST_CASE_("read_ahead = %d", read_aheads[i]);
+    struct Buffer *dir = buf_pool_get();
+    struct MdEmailArray mda = ARRAY_HEAD_INITIALIZER;
+
+    make_maildir(dir, &mda);
+    maildir_parse_ahead(buf_string(dir), &mda, read_aheads[i], NULL, NULL, 0);
+    check_maildir(dir, &mda);
+
+    buf_pool_release(&dir);
+  }
+
+  // Running out of file descriptors mustn't lose any messages
+  {
+    TEST_CASE("Out of file descriptors");
+    struct Buffer *dir = buf_pool_get();
+    struct MdEmailArray mda = ARRAY_HEAD_INITIALIZER;
+
+    make_maildir(dir, &mda);
+
+    struct rlimit rl_old = { 0 };
+    TEST_CHECK(getrlimit(RLIMIT_NOFILE, &rl_old) == 0);
+    struct rlimit rl_new = rl_old;
+    rl_new.rlim_cur = 64;
+    TEST_CHECK(setrlimit(RLIMIT_NOFILE, &rl_new) == 0);
+
+    // Use up all but a couple of the file descriptors
+    int fds[64] = { 0 };
+    int num_fds = 0;
+    while (num_fds < countof(fds))
+    {
+      int fd = dup(STDERR_FILENO);
+      if (fd < 0)
+        break;
+      fds[num_fds++] = fd;
+    }
+    TEST_CHECK(num_fds > 2);
+    close(fds[--num_fds]);
+    close(fds[--num_fds]);
+
+    maildir_parse_ahead(buf_string(dir), &mda, 16, NULL, NULL, 0);
+
+    while (num_fds > 0)
+      close(fds[--num_fds]);
+    setrlimit(RLIMIT_NOFILE, &rl_old);
+
+    check_maildir(dir, &mda);
+    buf_pool_release(&dir);
+  }
+}
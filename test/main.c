@@ -78,6 +78,9 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_mutt_addrlist_write_list)                             \
   NEOMUTT_TEST_ITEM(test_mutt_addrlist_write_wrap)                             \
                                                                                \
+  /* alias */                                                                  \
+  NEOMUTT_TEST_ITEM(test_alias_index)                                          \
+                                                                               \
   /* array */                                                                  \
   NEOMUTT_TEST_ITEM(test_mutt_array_api)                                       \
                                                                                \
@@ -93,6 +96,7 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_mutt_b64_buffer_decode)                               \
   NEOMUTT_TEST_ITEM(test_mutt_b64_buffer_encode)                               \
   NEOMUTT_TEST_ITEM(test_mutt_b64_decode)                                      \
+  NEOMUTT_TEST_ITEM(test_mutt_b64_decode_quads)                                \
   NEOMUTT_TEST_ITEM(test_mutt_b64_encode)                                      \
   NEOMUTT_TEST_ITEM(test_mutt_b64_encode_urlsafe)                              \
                                                                                \
@@ -270,6 +274,7 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_config_variable)                                      \
                                                                                \
   /* convert */                                                                \
+  NEOMUTT_TEST_ITEM(test_convert_benchmark)                                    \
   NEOMUTT_TEST_ITEM(test_mutt_convert_file_to)                                 \
   NEOMUTT_TEST_ITEM(test_mutt_convert_file_from_to)                            \
   NEOMUTT_TEST_ITEM(test_mutt_update_content_info)                             \
@@ -320,6 +325,7 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_editor_transpose_chars)                               \
                                                                                \
   /* email */                                                                  \
+  NEOMUTT_TEST_ITEM(test_email_changed)                                         \
   NEOMUTT_TEST_ITEM(test_email_cmp_strict)                                     \
   NEOMUTT_TEST_ITEM(test_email_free)                                           \
   NEOMUTT_TEST_ITEM(test_email_get_size)                                       \
@@ -346,6 +352,7 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_mutt_rfc822_parse_message)                            \
   NEOMUTT_TEST_ITEM(test_mutt_rfc822_read_header)                              \
   NEOMUTT_TEST_ITEM(test_mutt_rfc822_read_line)                                \
+  NEOMUTT_TEST_ITEM(test_mutt_sort_headers)                                    \
                                                                                \
   /* envelope */                                                               \
   NEOMUTT_TEST_ITEM(test_mutt_env_cmp_strict)                                  \
@@ -365,6 +372,7 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_eqi)                                                  \
                                                                                \
   /* expando */                                                                \
+  NEOMUTT_TEST_ITEM(test_expando_benchmark)                                    \
   NEOMUTT_TEST_ITEM(test_expando_colors_render)                                \
   NEOMUTT_TEST_ITEM(test_expando_complex_if_else)                              \
   NEOMUTT_TEST_ITEM(test_expando_conditional_date)                             \
@@ -401,6 +409,7 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_expando_parser)                                       \
   NEOMUTT_TEST_ITEM(test_expando_parse_short_name)                             \
   NEOMUTT_TEST_ITEM(test_expando_percent_sign_text)                            \
+  NEOMUTT_TEST_ITEM(test_expando_program)                                      \
   NEOMUTT_TEST_ITEM(test_expando_simple_expando)                               \
   NEOMUTT_TEST_ITEM(test_expando_simple_expando_render)                        \
   NEOMUTT_TEST_ITEM(test_expando_simple_text)                                  \
@@ -430,6 +439,7 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_mutt_file_map_lines)                                  \
   NEOMUTT_TEST_ITEM(test_mutt_file_mkdir)                                      \
   NEOMUTT_TEST_ITEM(test_mutt_file_open)                                       \
+  NEOMUTT_TEST_ITEM(test_mutt_file_prefetch)                                   \
   NEOMUTT_TEST_ITEM(test_mutt_file_read_keyword)                               \
   NEOMUTT_TEST_ITEM(test_mutt_file_read_line)                                  \
   NEOMUTT_TEST_ITEM(test_mutt_file_rename)                                     \
@@ -476,6 +486,7 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_window_visible)                                       \
                                                                                \
   /* hash */                                                                   \
+  NEOMUTT_TEST_ITEM(test_hash_benchmark)                                       \
   NEOMUTT_TEST_ITEM(test_mutt_hash_delete)                                     \
   NEOMUTT_TEST_ITEM(test_mutt_hash_find)                                       \
   NEOMUTT_TEST_ITEM(test_mutt_hash_find_bucket)                                \
@@ -553,6 +564,9 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_mailbox_size_sub)                                     \
   NEOMUTT_TEST_ITEM(test_mailbox_update)                                       \
                                                                                \
+  /* maildir */                                                                \
+  NEOMUTT_TEST_ITEM(test_maildir_parse_ahead)                                  \
+                                                                               \
   /* mapping */                                                                \
   NEOMUTT_TEST_ITEM(test_mutt_map_get_name)                                    \
   NEOMUTT_TEST_ITEM(test_mutt_map_get_value)                                   \
@@ -633,7 +647,9 @@ void test_fini(void);
                                                                                \
   /* pattern */                                                                \
   NEOMUTT_TEST_ITEM(test_mutt_pattern_comp)                                    \
+  NEOMUTT_TEST_ITEM(test_mutt_pattern_headers)                                 \
   NEOMUTT_TEST_ITEM(test_mutt_pattern_leak)                                    \
+  NEOMUTT_TEST_ITEM(test_mutt_pattern_rules)                                   \
                                                                                \
   /* prex */                                                                   \
   NEOMUTT_TEST_ITEM(test_mutt_prex_capture)                                    \
@@ -673,6 +689,9 @@ void test_fini(void);
   NEOMUTT_TEST_ITEM(test_rfc2231_decode_parameters)                            \
   NEOMUTT_TEST_ITEM(test_rfc2231_encode_string)                                \
                                                                                \
+  /* send */                                                                   \
+  NEOMUTT_TEST_ITEM(test_mutt_write_status)                                    \
+                                                                               \
   /* signal */                                                                 \
   NEOMUTT_TEST_ITEM(test_mutt_sig_allow_interrupt)                             \
   NEOMUTT_TEST_ITEM(test_mutt_sig_block)                                       \
@@ -789,6 +808,8 @@ NEOMUTT_TEST_LIST
   NEOMUTT_TEST_ITEM(test_compress_zstd)
 #endif
 #if defined(HAVE_BDB) || defined(HAVE_GDBM) || defined(HAVE_KC) || defined(HAVE_LMDB) || defined(HAVE_QDBM) || defined(HAVE_ROCKSDB) || defined(HAVE_TC) || defined(HAVE_TDB)
+  NEOMUTT_TEST_ITEM(test_mbox_hcache_read)
+  NEOMUTT_TEST_ITEM(test_search_index)
   NEOMUTT_TEST_ITEM(test_store_store)
 #endif
 #ifdef HAVE_BDB
@@ -841,6 +862,8 @@ NEOMUTT_TEST_ITEM(test_compress_common)
   NEOMUTT_TEST_ITEM(test_compress_zstd)
 #endif
 #if defined(HAVE_BDB) || defined(HAVE_GDBM) || defined(HAVE_KC) || defined(HAVE_LMDB) || defined(HAVE_QDBM) || defined(HAVE_ROCKSDB) || defined(HAVE_TC) || defined(HAVE_TDB)
+  NEOMUTT_TEST_ITEM(test_mbox_hcache_read)
+  NEOMUTT_TEST_ITEM(test_search_index)
   NEOMUTT_TEST_ITEM(test_store_store)
 #endif
 #ifdef HAVE_BDB
@@ -0,0 +1,235 @@
+/**
+ * @file
+ * Test code for mbox_hcache_read()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "mbox/lib.h"
+#include "test_common.h"
+
+static struct ConfigDef Vars[] = {
+  // clang-format off
+  { "auto_subscribe",                   DT_BOOL,   false, 0, NULL, },
+  { "check_mbox_size",                  DT_BOOL,   false, 0, NULL, },
+  { "header_cache",                     DT_PATH,   0,     0, NULL, },
+  { "header_cache_backend",             DT_STRING, 0,     0, NULL, },
+  { "header_cache_compress_dictionary", DT_BOOL,   false, 0, NULL, },
+  { "header_cache_compress_level",      DT_NUMBER, 1,     0, NULL, },
+  { "header_cache_compress_method",     DT_STRING, 0,     0, NULL, },
+  { "mail_check_recent",                DT_BOOL,   true,  0, NULL, },
+  { "mbox_header_cache",                DT_BOOL,   true,  0, NULL, },
+  { "reply_regex",                      DT_REGEX,  IP "^((re)(\\[[0-9]+\\])*:[ \t]*)*", 0, NULL, },
+  { NULL },
+  // clang-format on
+};
+
+/**
+ * write_message - Append a message to an mbox file
+ * @param path    Path to the mbox
+ * @param subject Subject of the message
+ * @param padding Number of lines of padding in the body
+ */
+static void write_message(const char *path, const char *subject, int padding)
+{
+  FILE *fp = fopen(path, "a");
+  TEST_CHECK(fp != NULL);
+  fprintf(fp, "From test@example.com Mon Jan  5 12:00:00 2026\n"
+              "From: test@example.com\n"
+              "Subject: %s\n"
+              "\n",
+          subject);
+  for (int i = 0; i < padding; i++)
+    fprintf(fp, "padding line %04d .............................................\n", i);
+  fprintf(fp, "\n");
+  fclose(fp);
+}
+
+/**
+ * rewrite_subject - Edit a Subject in place
+ * @param path  Path to the mbox
+ * @param from  Subject to replace
+ * @param to    New Subject, the same length
+ * @param mtime New modification time
+ */
+static void rewrite_subject(const char *path, const char *from, const char *to, time_t mtime)
+{
+  FILE *fp = fopen(path, "r+");
+  TEST_CHECK(fp != NULL);
+
+  char buf[1024] = { 0 };
+  long pos = 0;
+  while (fgets(buf, sizeof(buf), fp))
+  {
+    if (mutt_str_startswith(buf, "Subject: ") && mutt_str_equal(buf + 9, from))
+    {
+      fseek(fp, pos + 9, SEEK_SET);
+      fputs(to, fp);
+      break;
+    }
+    pos = ftell(fp);
+  }
+  fclose(fp);
+
+  struct timespec times[2] = { { mtime, 0 }, { mtime, 0 } };
+  TEST_CHECK(utimensat(AT_FDCWD, path, times, 0) == 0);
+}
+
+/**
+ * open_mbox - Open an mbox file and read its Emails
+ * @param path Path to the mbox
+ * @retval ptr Mailbox
+ */
+static struct Mailbox *open_mbox(const char *path)
+{
+  struct Account *a = account_new(NULL, NeoMutt->sub);
+  struct Mailbox *m = mailbox_new();
+  buf_strcpy(&m->pathbuf, path);
+  m->type = MUTT_MBOX;
+  m->readonly = true;
+  account_mailbox_add(a, m);
+  neomutt_account_add(NeoMutt, a);
+
+  TEST_CHECK(MxMboxOps.mbox_open(m) == MX_OPEN_OK);
+  return m;
+}
+
+/**
+ * close_mbox - Close an mbox file
+ * @param ptr Mailbox
+ */
+static void close_mbox(struct Mailbox **ptr)
+{
+  struct Mailbox *m = *ptr;
+  MxMboxOps.mbox_close(m);
+  neomutt_account_remove(NeoMutt, m->account);
+  *ptr = NULL;
+}
+
+/**
+ * check_subjects - Check the Subjects of the Emails
+ * @param m        Mailbox
+ * @param subjects Expected Subjects
+ * @param num      Number of Subjects
+ */
+static void check_subjects(struct Mailbox *m, const char **subjects, int num)
+{
+  if (!TEST_CHECK_NUM_EQ(m->msg_count, num))
+    return;
+
+  for (int i = 0; i < num; i++)
+  {
+    struct Email *e = m->emails[i];
+    TEST_CHECK(e->index == i);
+    TEST_CHECK_STR_EQ(e->env->subject, subjects[i]);
+  }
+}
+
+void test_mbox_hcache_read(void)
+{
+  // bool mbox_hcache_read(struct HeaderCache *hc, struct Mailbox *m, FILE *fp, struct stat *st, struct Progress *progress);
+
+  TEST_CHECK(cs_register_variables(NeoMutt->sub->cs, Vars));
+
+  struct Buffer *dir = buf_pool_get();
+  struct Buffer *path = buf_pool_get();
+  struct Buffer *cache = buf_pool_get();
+
+  test_gen_path(dir, "%s/tmp/XXXXXX");
+  TEST_CHECK(mkdtemp(dir->data) != NULL);
+  buf_printf(path, "%s/mbox", buf_string(dir));
+  buf_printf(cache, "%s/hcache/", buf_string(dir));
+  TEST_CHECK(mkdir(buf_string(cache), 0700) == 0);
+  cs_str_string_set(NeoMutt->sub->cs, "header_cache", buf_string(cache), NULL);
+
+  // Pad the first message, so it's outside the checksummed tail of the file
+  write_message(buf_string(path), "apple", 100);
+  write_message(buf_string(path), "banana", 0);
+
+  struct stat st = { 0 };
+  TEST_CHECK(stat(buf_string(path), &st) == 0);
+  time_t mtime = st.st_mtime - 1000;
+
+  {
+    TEST_CASE("Parse, and fill the cache");
+    rewrite_subject(buf_string(path), "apple\n", "apple", mtime);
+    struct Mailbox *m = open_mbox(buf_string(path));
+    const char *subjects[] = { "apple", "banana" };
+    check_subjects(m, subjects, countof(subjects));
+    close_mbox(&m);
+  }
+
+  {
+    TEST_CASE("Unchanged file, restored from the cache");
+    // Secretly edit the file, keeping its size and mtime
+    rewrite_subject(buf_string(path), "apple\n", "APPLE", mtime);
+    struct Mailbox *m = open_mbox(buf_string(path));
+    const char *subjects[] = { "apple", "banana" };
+    check_subjects(m, subjects, countof(subjects));
+    close_mbox(&m);
+  }
+
+  {
+    TEST_CASE("Same size, new mtime, parsed again");
+    // Touch the file, outside the checksummed tail
+    rewrite_subject(buf_string(path), "APPLE\n", "APPLE", mtime + 10);
+    struct Mailbox *m = open_mbox(buf_string(path));
+    const char *subjects[] = { "APPLE", "banana" };
+    check_subjects(m, subjects, countof(subjects));
+    close_mbox(&m);
+  }
+
+  {
+    TEST_CASE("Appended message, only the new one is parsed");
+    // Secretly edit the first message, keeping its size and mtime
+    rewrite_subject(buf_string(path), "APPLE\n", "apple", mtime + 10);
+    write_message(buf_string(path), "cherry", 0);
+    struct Mailbox *m = open_mbox(buf_string(path));
+    const char *subjects[] = { "APPLE", "banana", "cherry" };
+    check_subjects(m, subjects, countof(subjects));
+    close_mbox(&m);
+  }
+
+  {
+    TEST_CASE("Tail of the cached part changed, parsed again");
+    rewrite_subject(buf_string(path), "banana\n", "BANANA", mtime + 20);
+    write_message(buf_string(path), "damson", 0);
+    struct Mailbox *m = open_mbox(buf_string(path));
+    const char *subjects[] = { "apple", "BANANA", "cherry", "damson" };
+    check_subjects(m, subjects, countof(subjects));
+    close_mbox(&m);
+  }
+
+  cs_str_reset(NeoMutt->sub->cs, "header_cache", NULL);
+
+  buf_pool_release(&dir);
+  buf_pool_release(&path);
+  buf_pool_release(&cache);
+}
@@ -146,6 +146,10 @@ int mx_msg_padding_size(struct Mailbox *m)
   return 0;
 }
 
+void mx_msg_prefetch(struct Mailbox *m, struct Email *e)
+{
+}
+
 const char *myvar_get(const char *var)
 {
   return NULL;
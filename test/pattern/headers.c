@@ -0,0 +1,113 @@
+/**
+ * @file
+ * Test code for matching Patterns without reading the message
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include "mutt/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "pattern/lib.h"
+#include "pattern/private.h"
+#include "test_common.h"
+
+static struct PatternList *full_comp(const char *str)
+{
+  struct Buffer *err = buf_pool_get();
+  struct PatternList *pl = mutt_pattern_comp(NULL, str, MUTT_PC_FULL_MSG, err);
+  TEST_CHECK(pl != NULL);
+  TEST_MSG("%s: %s", str, buf_string(err));
+  buf_pool_release(&err);
+  return pl;
+}
+
+static int exec_headers(const char *str, struct Mailbox *m, struct Email *e)
+{
+  struct PatternList *pl = full_comp(str);
+  if (!pl)
+    return -2;
+  int rc = pattern_exec_headers(SLIST_FIRST(pl), 0, m, e);
+  mutt_pattern_free(&pl);
+  return rc;
+}
+
+void test_mutt_pattern_headers(void)
+{
+  // int pattern_exec_headers(struct Pattern *pat, PatternExecFlags flags, struct Mailbox *m, struct Email *e);
+
+  MuttLogger = log_disp_null;
+
+  struct Mailbox *m = mailbox_new();
+  m->type = MUTT_MAILDIR;
+
+  struct Email *e = email_new();
+  e->env = mutt_env_new();
+  e->body = mutt_body_new();
+  e->flagged = true;
+
+  {
+    TEST_CASE("Header predicates decide");
+    TEST_CHECK_NUM_EQ(exec_headers("~F", m, e), 1);
+    TEST_CHECK_NUM_EQ(exec_headers("~D", m, e), 0);
+    TEST_CHECK_NUM_EQ(exec_headers("~D ~b hello", m, e), 0);
+    TEST_CHECK_NUM_EQ(exec_headers("~b hello ~D", m, e), 0);
+    TEST_CHECK_NUM_EQ(exec_headers("~F | ~b hello", m, e), 1);
+    TEST_CHECK_NUM_EQ(exec_headers("~b hello | ~F", m, e), 1);
+    TEST_CHECK_NUM_EQ(exec_headers("!(~D ~B hello)", m, e), 1);
+    TEST_CHECK_NUM_EQ(exec_headers("!(~F | ~B hello)", m, e), 0);
+  }
+
+  {
+    TEST_CASE("The message must be read");
+    TEST_CHECK_NUM_EQ(exec_headers("~b hello", m, e), -1);
+    TEST_CHECK_NUM_EQ(exec_headers("!~b hello", m, e), -1);
+    TEST_CHECK_NUM_EQ(exec_headers("~F ~b hello", m, e), -1);
+    TEST_CHECK_NUM_EQ(exec_headers("~D | ~h hello", m, e), -1);
+    TEST_CHECK_NUM_EQ(exec_headers("~(~b hello)", m, e), -1);
+  }
+
+  {
+    TEST_CASE("No Mailbox, nothing to read");
+    TEST_CHECK_NUM_EQ(exec_headers("~F ~b hello", NULL, e), 0);
+  }
+
+  {
+    TEST_CASE("Matching doesn't open messages the headers decide");
+    // The test mx_msg_open() always fails, so a match can't have read it
+    struct PatternList *pl = full_comp("~F | ~b hello");
+    TEST_CHECK(mutt_pattern_exec(SLIST_FIRST(pl), 0, m, e, NULL));
+    mutt_pattern_free(&pl);
+
+    pl = full_comp("!(~D ~b hello)");
+    TEST_CHECK(mutt_pattern_exec(SLIST_FIRST(pl), 0, m, e, NULL));
+    mutt_pattern_free(&pl);
+
+    pl = full_comp("~F ~b hello");
+    TEST_CHECK(!mutt_pattern_exec(SLIST_FIRST(pl), 0, m, e, NULL));
+    mutt_pattern_free(&pl);
+  }
+
+  email_free(&e);
+  mailbox_free(&m);
+}
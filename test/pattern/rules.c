@@ -0,0 +1,103 @@
+/**
+ * @file
+ * Test code for rule Patterns
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include "mutt/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "pattern/lib.h"
+#include "test_common.h"
+
+static struct PatternList *rule_comp(const char *str)
+{
+  struct Buffer *err = buf_pool_get();
+  struct PatternList *pl = mutt_pattern_comp(NULL, str, MUTT_PC_RULE, err);
+  TEST_CHECK(pl != NULL);
+  TEST_MSG("%s: %s", str, buf_string(err));
+  buf_pool_release(&err);
+  return pl;
+}
+
+void test_mutt_pattern_rules(void)
+{
+  MuttLogger = log_disp_null;
+
+  // Cheap tests are moved to the front
+  {
+    struct PatternList *pl = rule_comp("~y apple ~F ~N");
+    struct Pattern *root = SLIST_FIRST(pl);
+    TEST_CHECK(root->op == MUTT_PAT_AND);
+    struct Pattern *first = SLIST_FIRST(root->child);
+    struct Pattern *second = SLIST_NEXT(first, entries);
+    struct Pattern *third = SLIST_NEXT(second, entries);
+    TEST_CHECK(first->op == MUTT_FLAG);
+    TEST_CHECK(second->op == MUTT_NEW);
+    TEST_CHECK(third->op == MUTT_PAT_XLABEL);
+    TEST_CHECK(!first->pred);
+    TEST_CHECK(third->pred != NULL);
+    mutt_pattern_free(&pl);
+  }
+
+  // Identical tests share a result
+  {
+    struct PatternList *pl1 = rule_comp("~y apple");
+    struct PatternList *pl2 = rule_comp("~F | ~y apple");
+    struct PatternList *pl3 = rule_comp("!~y apple");
+    struct PatternList *pl4 = rule_comp("!(~y apple)");
+
+    struct Pattern *p1 = SLIST_FIRST(pl1);
+    struct Pattern *p2 = SLIST_NEXT(SLIST_FIRST(SLIST_FIRST(pl2)->child), entries);
+    struct Pattern *p3 = SLIST_FIRST(pl3);
+    struct Pattern *p4 = SLIST_FIRST(pl4);
+    TEST_CHECK(p1->pred != NULL);
+    TEST_CHECK(p1->pred == p2->pred);
+    TEST_CHECK(p3->pred != NULL);
+    TEST_CHECK(p1->pred != p3->pred);
+    TEST_CHECK(p3->pred == p4->pred);
+
+    struct Email *e = email_new();
+    e->env = mutt_env_new();
+    e->env->x_label = mutt_str_dup("apple pie");
+
+    struct PatternCache cache = { 0 };
+    TEST_CHECK(mutt_pattern_exec(p1, 0, NULL, e, &cache));
+    TEST_CHECK(!mutt_pattern_exec(p3, 0, NULL, e, &cache));
+    TEST_CHECK(mutt_pattern_exec(SLIST_FIRST(pl2), 0, NULL, e, &cache));
+
+    // The results are kept until the cache is reset
+    mutt_str_replace(&e->env->x_label, "banana split");
+    TEST_CHECK(mutt_pattern_exec(p2, 0, NULL, e, &cache));
+    struct PatternCache cache2 = { 0 };
+    TEST_CHECK(!mutt_pattern_exec(p2, 0, NULL, e, &cache2));
+    TEST_CHECK(mutt_pattern_exec(p4, 0, NULL, e, &cache2));
+
+    email_free(&e);
+    mutt_pattern_free(&pl1);
+    mutt_pattern_free(&pl2);
+    mutt_pattern_free(&pl3);
+    mutt_pattern_free(&pl4);
+  }
+}
@@ -0,0 +1,327 @@
+/**
+ * @file
+ * Test code for the index of the text in each message
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "hcache/lib.h"
+#include "ncrypt/lib.h"
+#include "pattern/lib.h"
+#include "pattern/search_index.h"
+#include "test_common.h"
+
+static struct ConfigDef Vars[] = {
+  // clang-format off
+  { "header_cache",                     DT_PATH,   0,     0, NULL, },
+  { "header_cache_backend",             DT_STRING, 0,     0, NULL, },
+  { "header_cache_compress_dictionary", DT_BOOL,   false, 0, NULL, },
+  { "header_cache_compress_level",      DT_NUMBER, 1,     0, NULL, },
+  { "header_cache_compress_method",     DT_STRING, 0,     0, NULL, },
+  { "mailcap_path",                     DT_SLIST|D_SLIST_SEP_COLON, 0, 0, NULL, },
+  { "search_index",                     DT_BOOL,   true,  0, NULL, },
+  { "show_multipart_alternative",       DT_STRING, 0,     0, NULL, },
+  { "thorough_search",                  DT_BOOL,   false, 0, NULL, },
+  { NULL },
+  // clang-format on
+};
+
+/**
+ * make_email - Create an Email in an mbox
+ * @param offset Offset of the message in the mbox
+ * @param msgid  Message-Id
+ * @retval ptr New Email
+ */
+static struct Email *make_email(LOFF_T offset, const char *msgid)
+{
+  struct Email *e = email_new();
+  e->offset = offset;
+  e->date_sent = 1000000;
+  e->env = mutt_env_new();
+  e->env->message_id = mutt_str_dup(msgid);
+  e->body = mutt_body_new();
+  e->body->offset = offset + 100;
+  e->body->length = 500;
+  return e;
+}
+
+/**
+ * index_email - Index some text as if a search had read it
+ * @param m     Mailbox
+ * @param e     Email
+ * @param str   Pattern that's being searched for
+ * @param lines Text of the message, NULL-terminated
+ * @retval true The Email was indexed
+ */
+static bool index_email(struct Mailbox *m, struct Email *e, const char *str,
+                        const char **lines)
+{
+  struct Buffer *err = buf_pool_get();
+  struct PatternList *pl = mutt_pattern_comp(NULL, str, MUTT_PC_FULL_MSG, err);
+  TEST_CHECK(pl != NULL);
+  buf_pool_release(&err);
+
+  struct SearchSig *sig = search_sig_new(m, e, SLIST_FIRST(pl));
+  const bool rc = (sig != NULL);
+  for (; lines && *lines; lines++)
+    search_sig_add_line(sig, *lines);
+  search_sig_store(&sig);
+
+  mutt_pattern_free(&pl);
+  return rc;
+}
+
+/**
+ * rejects - Can the index rule out a Pattern?
+ * @param m   Mailbox
+ * @param e   Email
+ * @param str Pattern
+ * @retval true The Pattern can't match the Email
+ */
+static bool rejects(struct Mailbox *m, struct Email *e, const char *str)
+{
+  struct Buffer *err = buf_pool_get();
+  struct PatternList *pl = mutt_pattern_comp(NULL, str, MUTT_PC_FULL_MSG, err);
+  TEST_CHECK(pl != NULL);
+  TEST_MSG("%s: %s", str, buf_string(err));
+  buf_pool_release(&err);
+
+  const bool rc = search_index_rejects(m, e, SLIST_FIRST(pl));
+  mutt_pattern_free(&pl);
+  return rc;
+}
+
+void test_search_index(void)
+{
+  // void search_index_open   (struct Mailbox *m);
+  // bool search_index_rejects(struct Mailbox *m, struct Email *e, const struct Pattern *pat);
+  // struct SearchSig *search_sig_new(struct Mailbox *m, struct Email *e, const struct Pattern *pat);
+  // void search_sig_add_line (struct SearchSig *sig, const char *line);
+  // void search_sig_store    (struct SearchSig **ptr);
+  // void search_index_close  (void);
+
+  MuttLogger = log_disp_null;
+  TEST_CHECK(cs_register_variables(NeoMutt->sub->cs, Vars));
+  const bool old_utf8 = CharsetIsUtf8;
+  CharsetIsUtf8 = true;
+
+  struct Buffer *dir = buf_pool_get();
+  struct Buffer *cache = buf_pool_get();
+  struct Buffer *mailcap = buf_pool_get();
+  test_gen_path(dir, "%s/tmp/XXXXXX");
+  TEST_CHECK(mkdtemp(dir->data) != NULL);
+  buf_printf(cache, "%s/hcache/", buf_string(dir));
+  TEST_CHECK(mkdir(buf_string(cache), 0700) == 0);
+  cs_str_string_set(NeoMutt->sub->cs, "header_cache", buf_string(cache), NULL);
+  buf_printf(mailcap, "%s/mailcap", buf_string(dir));
+  cs_str_string_set(NeoMutt->sub->cs, "mailcap_path", buf_string(mailcap), NULL);
+
+  struct Mailbox *m = mailbox_new();
+  buf_printf(&m->pathbuf, "%s/mbox", buf_string(dir));
+  m->type = MUTT_MBOX;
+
+  struct Email *e = make_email(0, "<apple@example.com>");
+  struct Email *e2 = make_email(1000, "<banana@example.com>");
+
+  static const char *text[] = {
+    "Hello World\n",
+    "Der Kelvin: \xe2\x84\xaa\n",  // KELVIN SIGN
+    "\xd0\xa2\xd0\x95\xd0\x9a\xd0\xa1\xd0\xa2 \xcf\x83\xce\xbf\xcf\x86\xcf\x8c\xcf\x82\n", // "ТЕКСТ σοφός"
+    NULL,
+  };
+
+  {
+    TEST_CASE("Closed index");
+    TEST_CHECK(!index_email(m, e, "~b hello", text));
+    TEST_CHECK(!rejects(m, e, "=b xyzzy"));
+  }
+
+  search_index_open(m);
+
+  {
+    TEST_CASE("Nothing indexed");
+    TEST_CHECK(!rejects(m, e, "=b xyzzy"));
+    TEST_CHECK(!rejects(m, e, "~b xyzzy"));
+  }
+
+  {
+    TEST_CASE("Build a signature");
+    TEST_CHECK(index_email(m, e, "~b hello", text));
+    // Only unindexed messages are indexed
+    TEST_CHECK(!index_email(m, e, "~b hello", text));
+    // Header searches aren't indexed
+    TEST_CHECK(!index_email(m, e2, "~h hello", text));
+  }
+
+  {
+    TEST_CASE("Matching text");
+    TEST_CHECK(!rejects(m, e, "=b hello"));
+    TEST_CHECK(!rejects(m, e, "=b HELLO"));
+    TEST_CHECK(!rejects(m, e, "~b 'o wor'"));
+    TEST_CHECK(!rejects(m, e, "~b He"));
+    TEST_CHECK(!rejects(m, e, "~b hello.*xyzzy"));
+    TEST_CHECK(!rejects(m, e, "!~b xyzzy"));
+    TEST_CHECK(!rejects(m, e, "~b xyzzy | ~b world"));
+  }
+
+  {
+    TEST_CASE("Missing text");
+    TEST_CHECK(rejects(m, e, "=b xyzzy"));
+    TEST_CHECK(rejects(m, e, "~b xyzzy"));
+    TEST_CHECK(rejects(m, e, "~b hello ~b xyzzy"));
+    TEST_CHECK(rejects(m, e, "~b xyzzy | ~b plugh"));
+    // No signature for whole messages, or for a different message
+    TEST_CHECK(!rejects(m, e, "~B xyzzy"));
+    TEST_CHECK(!rejects(m, e2, "~b xyzzy"));
+  }
+
+  {
+    TEST_CASE("Multibyte text");
+    // "текст", lower-cased
+    TEST_CHECK(!rejects(m, e, "~b \xd1\x82\xd0\xb5\xd0\xba\xd1\x81\xd1\x82"));
+    // "ΣΟΦΟΣ", matches the final sigma
+    TEST_CHECK(!rejects(m, e, "=b \xce\xa3\xce\x9f\xce\xa6\xce\x8c\xce\xa3"));
+    // The KELVIN SIGN folds to 'k'
+    TEST_CHECK(!rejects(m, e, "~b ': k'"));
+    // "щука"
+    TEST_CHECK(rejects(m, e, "~b \xd1\x89\xd1\x83\xd0\xba\xd0\xb0"));
+  }
+
+  {
+    TEST_CASE("Stale signature");
+    e->body->length++;
+    TEST_CHECK(!rejects(m, e, "=b xyzzy"));
+    e->body->length--;
+    TEST_CHECK(rejects(m, e, "=b xyzzy"));
+
+    mutt_str_replace(&e->env->message_id, "<cherry@example.com>");
+    TEST_CHECK(!rejects(m, e, "=b xyzzy"));
+    mutt_str_replace(&e->env->message_id, "<apple@example.com>");
+    TEST_CHECK(rejects(m, e, "=b xyzzy"));
+  }
+
+  {
+    TEST_CASE("Reopened index");
+    search_index_close();
+    TEST_CHECK(!rejects(m, e, "=b xyzzy"));
+    search_index_open(m);
+    TEST_CHECK(rejects(m, e, "=b xyzzy"));
+  }
+
+  {
+    TEST_CASE("Decoded text depends on the settings");
+    // Raw and decoded text are kept apart
+    cs_str_native_set(NeoMutt->sub->cs, "thorough_search", true, NULL);
+    search_index_open(m);
+    TEST_CHECK(!rejects(m, e, "=b xyzzy"));
+    TEST_CHECK(index_email(m, e, "~b hello", text));
+    TEST_CHECK(rejects(m, e, "=b xyzzy"));
+
+    cs_str_string_set(NeoMutt->sub->cs, "show_multipart_alternative", "inline", NULL);
+    search_index_open(m);
+    TEST_CHECK(!rejects(m, e, "=b xyzzy"));
+
+    cs_str_reset(NeoMutt->sub->cs, "show_multipart_alternative", NULL);
+    search_index_open(m);
+    TEST_CHECK(rejects(m, e, "=b xyzzy"));
+
+    // A new mailcap file may convert the parts differently
+    FILE *fp = fopen(buf_string(mailcap), "w");
+    TEST_CHECK(fp != NULL);
+    fputs("text/html; lynx -dump %s; copiousoutput\n", fp);
+    fclose(fp);
+    search_index_open(m);
+    TEST_CHECK(!rejects(m, e, "=b xyzzy"));
+    TEST_CHECK(unlink(buf_string(mailcap)) == 0);
+    search_index_open(m);
+    TEST_CHECK(rejects(m, e, "=b xyzzy"));
+
+    // The raw signature is still valid
+    cs_str_native_set(NeoMutt->sub->cs, "thorough_search", false, NULL);
+    search_index_open(m);
+    TEST_CHECK(rejects(m, e, "=b xyzzy"));
+  }
+
+  {
+    TEST_CASE("Shared header cache");
+    struct Email *e3 = make_email(2000, "<damson@example.com>");
+
+    // The backend opens the cache while the index has it open
+    search_index_open(m);
+    struct HeaderCache *hc = hcache_open(buf_string(cache), mailbox_path(m), NULL, true);
+    TEST_CHECK(hc != NULL);
+    struct HeaderCache *hc2 = hcache_open(buf_string(cache), mailbox_path(m), NULL, true);
+    TEST_CHECK(hc2 == hc);
+    hcache_close(&hc2);
+    TEST_CHECK(hc2 == NULL);
+    TEST_CHECK(rejects(m, e, "=b xyzzy"));
+    TEST_CHECK(index_email(m, e3, "~b hello", text));
+    hcache_close(&hc);
+    TEST_CHECK(rejects(m, e3, "=b xyzzy"));
+
+    // The index opens the cache while the backend has it open
+    search_index_close();
+    hc = hcache_open(buf_string(cache), mailbox_path(m), NULL, true);
+    hcache_begin_batch(hc);
+    search_index_open(m);
+    TEST_CHECK(rejects(m, e, "=b xyzzy"));
+    TEST_CHECK(rejects(m, e3, "=b xyzzy"));
+    search_index_close();
+    hcache_close(&hc);
+
+    // Nothing was lost
+    search_index_open(m);
+    TEST_CHECK(rejects(m, e, "=b xyzzy"));
+    TEST_CHECK(rejects(m, e3, "=b xyzzy"));
+    email_free(&e3);
+  }
+
+  if (WithCrypto != 0)
+  {
+    TEST_CASE("Encrypted and signed messages");
+    e2->security = SEC_ENCRYPT;
+    TEST_CHECK(!index_email(m, e2, "~b hello", text));
+    e2->security = SEC_SIGN;
+    TEST_CHECK(!index_email(m, e2, "~b hello", text));
+    TEST_CHECK(!rejects(m, e2, "=b xyzzy"));
+  }
+
+  search_index_close();
+  TEST_CHECK(!rejects(m, e, "=b xyzzy"));
+
+  email_free(&e);
+  email_free(&e2);
+  mailbox_free(&m);
+  CharsetIsUtf8 = old_utf8;
+
+  buf_pool_release(&dir);
+  buf_pool_release(&cache);
+  buf_pool_release(&mailcap);
+}
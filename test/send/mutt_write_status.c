@@ -0,0 +1,110 @@
+/**
+ * @file
+ * Test code for mutt_write_status()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include "mutt/lib.h"
+#include "email/lib.h"
+#include "send/lib.h"
+#include "test_common.h"
+
+/**
+ * write_status - Write the status fields to a string
+ * @param e   Email
+ * @param pad Pad the fields
+ * @param buf Buffer for the result
+ */
+static void write_status(const struct Email *e, bool pad, struct Buffer *buf)
+{
+  buf_reset(buf);
+
+  FILE *fp = tmpfile();
+  TEST_CHECK(fp != NULL);
+  mutt_write_status(fp, e, pad);
+
+  char line[64] = { 0 };
+  rewind(fp);
+  while (fgets(line, sizeof(line), fp))
+    buf_addstr(buf, line);
+  fclose(fp);
+}
+
+void test_mutt_write_status(void)
+{
+  // void mutt_write_status(FILE *fp, const struct Email *e, bool pad);
+
+  {
+    struct Email e = { 0 };
+    mutt_write_status(NULL, &e, true);
+
+    FILE *fp = tmpfile();
+    mutt_write_status(fp, NULL, true);
+    TEST_CHECK(ftell(fp) == 0);
+    fclose(fp);
+  }
+
+  static const struct
+  {
+    bool old, read, replied, flagged;
+    const char *plain;
+    const char *padded;
+  } tests[] = {
+    // clang-format off
+    { false, false, false, false, "",                             "Status:   \nX-Status:   \n" },
+    { true,  false, false, false, "Status: O\n",                  "Status: O \nX-Status:   \n" },
+    { false, true,  false, false, "Status: RO\n",                 "Status: RO\nX-Status:   \n" },
+    { true,  true,  false, false, "Status: RO\n",                 "Status: RO\nX-Status:   \n" },
+    { false, false, true,  false, "X-Status: A\n",                "Status:   \nX-Status: A \n" },
+    { false, false, false, true,  "X-Status: F\n",                "Status:   \nX-Status: F \n" },
+    { false, false, true,  true,  "X-Status: AF\n",               "Status:   \nX-Status: AF\n" },
+    { true,  false, false, true,  "Status: O\nX-Status: F\n",     "Status: O \nX-Status: F \n" },
+    { false, true,  true,  true,  "Status: RO\nX-Status: AF\n",   "Status: RO\nX-Status: AF\n" },
+    // clang-format on
+  };
+
+  struct Buffer *buf = buf_pool_get();
+  const size_t padded_len = mutt_str_len(tests[0].padded);
+
+  for (int i = 0; i < countof(tests); i++)
+  {
+    TEST_CASE_("%d", i);
+    struct Email e = { 0 };
+    e.old = tests[i].old;
+    e.read = tests[i].read;
+    e.replied = tests[i].replied;
+    e.flagged = tests[i].flagged;
+
+    write_status(&e, false, buf);
+    TEST_CHECK_STR_EQ(buf_string(buf), tests[i].plain);
+
+    write_status(&e, true, buf);
+    TEST_CHECK_STR_EQ(buf_string(buf), tests[i].padded);
+
+    // Changing the flags mustn't change the length of the message
+    TEST_CHECK_NUM_EQ(buf_len(buf), padded_len);
+  }
+
+  buf_pool_release(&buf);
+}